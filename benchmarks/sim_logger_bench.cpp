@@ -0,0 +1,374 @@
+// Latency and throughput benchmarks for the logging pipeline.
+//
+// Usage: sim_logger_bench [--scenarios a,b,...] [--threads 1,4,16,64]
+//                         [--iterations N] [--format csv|json] [--output FILE]
+//                         [--dir DIR] [--label TEXT]
+//
+// Scenarios:
+//   disabled           LOG_DEBUGF on an INFO logger (filtered at the call site)
+//   format             PatternFormatter::format_to into a reused buffer
+//   file_sync          LOG_INFOF to a FileSink
+//   async_block        LOG_INFOF to AsyncSink(FileSink), OverflowPolicy::Block
+//   async_drop_newest  ... OverflowPolicy::DropNewest
+//   async_drop_oldest  ... OverflowPolicy::DropOldest
+//
+// Each scenario runs once per thread count. Every producer times each call with
+// steady_clock; latencies are merged across producers for p50/p99/p99.9/max.
+// Throughput is total calls divided by the wall time of the producer phase
+// (async queues are drained afterwards and not counted). Results go to stdout
+// or --output as CSV or JSON, so runs can be diffed across commits.
+
+#include "logger/async_sink.hpp"
+#include "logger/file_sink.hpp"
+#include "logger/log_macros.hpp"
+#include "logger/logger.hpp"
+#include "logger/logger_registry.hpp"
+#include "logger/pattern_formatter.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using sim_logger::Level;
+
+constexpr const char* kPattern = "{met} {level} {logger}: {msg}";
+
+const std::vector<std::string> kAllScenarios = {
+    "disabled", "format", "file_sync", "async_block", "async_drop_newest", "async_drop_oldest"};
+
+struct Options {
+  std::vector<std::string> scenarios = kAllScenarios;
+  std::vector<std::size_t> threads = {1, 4, 16, 64};
+  std::size_t iterations = 50000;  // per producer thread
+  std::string format = "csv";
+  std::string output;
+  std::filesystem::path dir = std::filesystem::temp_directory_path();
+  std::string label;
+};
+
+struct Result {
+  std::string scenario;
+  std::size_t threads = 0;
+  std::size_t calls = 0;
+  double seconds = 0.0;
+  std::uint64_t p50 = 0;
+  std::uint64_t p99 = 0;
+  std::uint64_t p999 = 0;
+  std::uint64_t max = 0;
+  std::uint64_t dropped = 0;
+};
+
+std::vector<std::string> split_list(const std::string& s) {
+  std::vector<std::string> out;
+  std::stringstream in(s);
+  std::string item;
+  while (std::getline(in, item, ',')) {
+    if (!item.empty()) {
+      out.push_back(item);
+    }
+  }
+  return out;
+}
+
+[[noreturn]] void usage(const char* argv0, const std::string& error) {
+  if (!error.empty()) {
+    std::cerr << "error: " << error << "\n";
+  }
+  std::cerr << "usage: " << argv0
+            << " [--scenarios a,b,...] [--threads 1,4,16,64] [--iterations N]"
+               " [--format csv|json] [--output FILE] [--dir DIR] [--label TEXT]\n";
+  std::exit(2);
+}
+
+Options parse_args(int argc, char** argv) {
+  Options o;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (i + 1 >= argc) {
+      usage(argv[0], "missing value for " + arg);
+    }
+    const std::string value = argv[++i];
+    if (arg == "--scenarios") {
+      o.scenarios = split_list(value);
+      for (const auto& s : o.scenarios) {
+        if (std::find(kAllScenarios.begin(), kAllScenarios.end(), s) == kAllScenarios.end()) {
+          usage(argv[0], "unknown scenario '" + s + "'");
+        }
+      }
+    } else if (arg == "--threads") {
+      o.threads.clear();
+      for (const auto& t : split_list(value)) {
+        const unsigned long n = std::strtoul(t.c_str(), nullptr, 10);
+        if (n == 0 || n > 1024) {
+          usage(argv[0], "invalid thread count '" + t + "'");
+        }
+        o.threads.push_back(n);
+      }
+    } else if (arg == "--iterations") {
+      o.iterations = std::strtoul(value.c_str(), nullptr, 10);
+      if (o.iterations == 0) {
+        usage(argv[0], "iterations must be > 0");
+      }
+    } else if (arg == "--format") {
+      if (value != "csv" && value != "json") {
+        usage(argv[0], "format must be csv or json");
+      }
+      o.format = value;
+    } else if (arg == "--output") {
+      o.output = value;
+    } else if (arg == "--dir") {
+      o.dir = value;
+    } else if (arg == "--label") {
+      o.label = value;
+    } else {
+      usage(argv[0], "unknown option '" + arg + "'");
+    }
+  }
+  return o;
+}
+
+sim_logger::LogRecord make_record(std::size_t i) {
+  return sim_logger::LogRecord(Level::Info, 1.0, 2.0, 3, std::this_thread::get_id(), __FILE__, 1U,
+                               "bench", "bench", {}, "step=" + std::to_string(i));
+}
+
+/// Run @p body(thread_index, i) iterations times on each of @p threads producers.
+template <typename Body>
+Result run_producers(const std::string& scenario, std::size_t threads, std::size_t iterations,
+                     Body&& body) {
+  std::vector<std::vector<std::uint64_t>> samples(threads);
+  std::atomic<std::size_t> ready{0};
+  std::atomic<bool> go{false};
+
+  std::vector<std::thread> workers;
+  workers.reserve(threads);
+  for (std::size_t t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      auto& mine = samples[t];
+      mine.reserve(iterations);
+      ready.fetch_add(1);
+      while (!go.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+      }
+      for (std::size_t i = 0; i < iterations; ++i) {
+        const auto start = Clock::now();
+        body(t, i);
+        const auto end = Clock::now();
+        mine.push_back(static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+      }
+    });
+  }
+
+  while (ready.load() < threads) {
+    std::this_thread::yield();
+  }
+  const auto wall_start = Clock::now();
+  go.store(true, std::memory_order_release);
+  for (auto& w : workers) {
+    w.join();
+  }
+  const auto wall_end = Clock::now();
+
+  std::vector<std::uint64_t> all;
+  all.reserve(threads * iterations);
+  for (auto& s : samples) {
+    all.insert(all.end(), s.begin(), s.end());
+  }
+  std::sort(all.begin(), all.end());
+  const auto pct = [&](double p) {
+    const auto idx = static_cast<std::size_t>(p * static_cast<double>(all.size() - 1));
+    return all[idx];
+  };
+
+  Result r;
+  r.scenario = scenario;
+  r.threads = threads;
+  r.calls = all.size();
+  r.seconds = std::chrono::duration<double>(wall_end - wall_start).count();
+  r.p50 = pct(0.50);
+  r.p99 = pct(0.99);
+  r.p999 = pct(0.999);
+  r.max = all.back();
+  return r;
+}
+
+Result run_scenario(const Options& o, const std::string& scenario, std::size_t threads) {
+  auto& reg = sim_logger::LoggerRegistry::instance();
+  reg.clear();
+  auto logger = reg.get_logger("bench");
+  logger->set_level(Level::Info);
+
+  if (scenario == "disabled") {
+    return run_producers(scenario, threads, o.iterations, [&](std::size_t, std::size_t i) {
+      LOG_DEBUGF(logger, "step=%zu dt=%.3f", i, 0.01);
+    });
+  }
+
+  if (scenario == "format") {
+    const sim_logger::PatternFormatter formatter(kPattern);
+    std::vector<sim_logger::LogRecord> records;
+    std::vector<std::string> buffers(threads);
+    for (std::size_t t = 0; t < threads; ++t) {
+      records.push_back(make_record(t));
+      buffers[t].reserve(256);
+    }
+    return run_producers(scenario, threads, o.iterations, [&](std::size_t t, std::size_t) {
+      buffers[t].clear();
+      formatter.format_to(records[t], buffers[t]);
+    });
+  }
+
+  const auto path = o.dir / ("sim_logger_bench_" + scenario + ".log");
+  std::filesystem::remove(path);
+  auto file = std::make_shared<sim_logger::FileSink>(path.string(), sim_logger::PatternFormatter(kPattern));
+
+  std::shared_ptr<sim_logger::AsyncSink> async;
+  if (scenario == "file_sync") {
+    logger->set_sinks({file});
+  } else {
+    sim_logger::AsyncOptions opts;
+    opts.capacity = 8192;
+    if (scenario == "async_drop_newest") {
+      opts.overflow_policy = sim_logger::OverflowPolicy::DropNewest;
+    } else if (scenario == "async_drop_oldest") {
+      opts.overflow_policy = sim_logger::OverflowPolicy::DropOldest;
+    } else {
+      opts.overflow_policy = sim_logger::OverflowPolicy::Block;
+    }
+    async = std::make_shared<sim_logger::AsyncSink>(file, opts);
+    logger->set_sinks({async});
+  }
+
+  Result r = run_producers(scenario, threads, o.iterations, [&](std::size_t, std::size_t i) {
+    LOG_INFOF(logger, "step=%zu dt=%.3f", i, 0.01);
+  });
+
+  if (async) {
+    async->flush();
+    r.dropped = async->dropped_records_count();
+  }
+  logger->set_sinks({});
+  async.reset();
+  file.reset();
+  std::filesystem::remove(path);
+  return r;
+}
+
+// Writes s as a JSON string literal: quotes, backslashes and control characters
+// are escaped so an arbitrary --label still yields valid JSON.
+void write_json_string(std::ostream& out, const std::string& s) {
+  out << '"';
+  for (const char c : s) {
+    switch (c) {
+      case '"': out << "\\\""; break;
+      case '\\': out << "\\\\"; break;
+      case '\n': out << "\\n"; break;
+      case '\r': out << "\\r"; break;
+      case '\t': out << "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char buf[8];
+          std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+          out << buf;
+        } else {
+          out << c;
+        }
+    }
+  }
+  out << '"';
+}
+
+// Writes s as an RFC 4180 CSV field, quoting it (and doubling embedded quotes)
+// when it contains a comma, quote or line break.
+void write_csv_field(std::ostream& out, const std::string& s) {
+  if (s.find_first_of(",\"\r\n") == std::string::npos) {
+    out << s;
+    return;
+  }
+  out << '"';
+  for (const char c : s) {
+    if (c == '"') out << '"';
+    out << c;
+  }
+  out << '"';
+}
+
+void write_csv(std::ostream& out, const Options& o, const std::vector<Result>& results) {
+  out << "label,scenario,threads,calls,seconds,calls_per_sec,p50_ns,p99_ns,p999_ns,max_ns,dropped\n";
+  for (const auto& r : results) {
+    write_csv_field(out, o.label);
+    out << "," << r.scenario << "," << r.threads << "," << r.calls << "," << r.seconds
+        << "," << static_cast<std::uint64_t>(static_cast<double>(r.calls) / r.seconds) << ","
+        << r.p50 << "," << r.p99 << "," << r.p999 << "," << r.max << "," << r.dropped << "\n";
+  }
+}
+
+void write_json(std::ostream& out, const Options& o, const std::vector<Result>& results) {
+  out << "{\n  \"label\": ";
+  write_json_string(out, o.label);
+  out << ",\n  \"iterations_per_thread\": " << o.iterations
+      << ",\n  \"results\": [\n";
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    const auto& r = results[i];
+    out << "    {\"scenario\": \"" << r.scenario << "\", \"threads\": " << r.threads
+        << ", \"calls\": " << r.calls << ", \"seconds\": " << r.seconds << ", \"calls_per_sec\": "
+        << static_cast<std::uint64_t>(static_cast<double>(r.calls) / r.seconds)
+        << ", \"p50_ns\": " << r.p50 << ", \"p99_ns\": " << r.p99 << ", \"p999_ns\": " << r.p999
+        << ", \"max_ns\": " << r.max << ", \"dropped\": " << r.dropped << "}"
+        << (i + 1 < results.size() ? "," : "") << "\n";
+  }
+  out << "  ]\n}\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const Options o = parse_args(argc, argv);
+
+  try {
+    std::vector<Result> results;
+    for (const auto& scenario : o.scenarios) {
+      for (const std::size_t threads : o.threads) {
+        results.push_back(run_scenario(o, scenario, threads));
+        std::cerr << scenario << " x" << threads << ": p50=" << results.back().p50
+                  << "ns p99=" << results.back().p99 << "ns\n";
+      }
+    }
+    sim_logger::LoggerRegistry::instance().clear();
+
+    std::ofstream file;
+    if (!o.output.empty()) {
+      file.open(o.output);
+      if (!file) {
+        std::cerr << "error: cannot open " << o.output << "\n";
+        return 1;
+      }
+    }
+    std::ostream& out = o.output.empty() ? std::cout : file;
+    if (o.format == "json") {
+      write_json(out, o, results);
+    } else {
+      write_csv(out, o, results);
+    }
+    return 0;
+  } catch (const std::exception& e) {
+    std::cerr << "error: " << e.what() << "\n";
+    return 1;
+  }
+}
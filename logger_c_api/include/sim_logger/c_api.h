@@ -5,6 +5,7 @@ extern "C" {
 #endif
 
 #include <stdarg.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #if defined(_WIN32) && defined(SIM_LOGGER_C_API_BUILD)
@@ -27,6 +28,27 @@ typedef enum sim_logger_level {
   SIM_LOGGER_LEVEL_FATAL = 4
 } sim_logger_level_t;
 
+// Typed key/value field for sim_logger_log_kv(); becomes a record Tag.
+typedef enum sim_logger_kv_type {
+  SIM_LOGGER_KV_STRING = 0,
+  SIM_LOGGER_KV_INT    = 1,
+  SIM_LOGGER_KV_UINT   = 2,
+  SIM_LOGGER_KV_DOUBLE = 3,
+  SIM_LOGGER_KV_BOOL   = 4
+} sim_logger_kv_type_t;
+
+typedef struct sim_logger_kv {
+  const char* key;
+  sim_logger_kv_type_t type;
+  union {
+    const char* s;  // SIM_LOGGER_KV_STRING (NUL-terminated; NULL -> "")
+    int64_t i;      // SIM_LOGGER_KV_INT
+    uint64_t u;     // SIM_LOGGER_KV_UINT
+    double d;       // SIM_LOGGER_KV_DOUBLE (round-trip text, shortest where supported)
+    int b;          // SIM_LOGGER_KV_BOOL ("true"/"false")
+  } value;
+} sim_logger_kv_t;
+
 /**
  * @brief Acquire a logger by name (hierarchical dotted names supported).
  *
@@ -41,6 +63,38 @@ SIM_LOGGER_C_API sim_logger_logger_t* sim_logger_get(const char* name);
  */
 SIM_LOGGER_C_API void sim_logger_release(sim_logger_logger_t* logger);
 
+/**
+ * @brief Return the process-lifetime handle cached in *slot, creating it on first use.
+ *
+ * Slow path of the SIM_LOG_* macros. The handle is never released and follows
+ * registry resets (it re-resolves its name after LoggerRegistry::clear()).
+ * Racing first calls agree on a single handle.
+ *
+ * @param slot Storage for the handle, zero-initialized (typically a function-local static).
+ * @param name Logger name; must stay valid for the life of the process (a string literal).
+ */
+SIM_LOGGER_C_API sim_logger_logger_t* sim_logger_get_cached(sim_logger_logger_t** slot,
+                                                            const char* name);
+
+/**
+ * @brief Return nonzero if a record at @p level would be built for @p logger.
+ *
+ * True when @p level passes the logger's effective level, or when backtrace
+ * capture is enabled (filtered records are then retained). Check this before
+ * formatting; sim_logger_logf() performs the same check before vsnprintf.
+ */
+SIM_LOGGER_C_API int sim_logger_is_enabled(const sim_logger_logger_t* logger,
+                                           sim_logger_level_t level);
+
+/**
+ * @brief Record that a @p level message was skipped after sim_logger_is_enabled() said no.
+ *
+ * Keeps the logger's filtered-record counts complete for callers (such as the
+ * SIM_LOG_* macros) that check the level before calling a log function.
+ */
+SIM_LOGGER_C_API void sim_logger_count_filtered(sim_logger_logger_t* logger,
+                                                sim_logger_level_t level);
+
 /**
  * @brief Log a pre-formatted message.
  *
@@ -58,6 +112,37 @@ SIM_LOGGER_C_API void sim_logger_log(sim_logger_logger_t* logger,
                                      const char* func,
                                      const char* msg);
 
+/**
+ * @brief Log a message given as (pointer, length); it need not be NUL-terminated.
+ *
+ * The bytes are copied once, straight into the record (no strlen).
+ * A NULL msg is treated as "".
+ */
+SIM_LOGGER_C_API void sim_logger_log_n(sim_logger_logger_t* logger,
+                                       sim_logger_level_t level,
+                                       const char* file,
+                                       uint32_t line,
+                                       const char* func,
+                                       const char* msg,
+                                       size_t len);
+
+/**
+ * @brief Log a message with structured fields.
+ *
+ * Each field becomes a record Tag (rendered by the "{tags}" formatter token).
+ * Numbers are converted only if the level check passes.
+ *
+ * @param fields Array of @p count fields (may be NULL when count is 0).
+ */
+SIM_LOGGER_C_API void sim_logger_log_kv(sim_logger_logger_t* logger,
+                                        sim_logger_level_t level,
+                                        const char* file,
+                                        uint32_t line,
+                                        const char* func,
+                                        const char* msg,
+                                        const sim_logger_kv_t* fields,
+                                        size_t count);
+
 /**
  * @brief printf-style formatted logging (C varargs).
  */
@@ -85,6 +170,180 @@ SIM_LOGGER_C_API void sim_logger_vlogf(sim_logger_logger_t* logger,
  */
 SIM_LOGGER_C_API void sim_logger_flush(sim_logger_logger_t* logger);
 
+/**
+ * @brief Set the logger's level override (children without their own level inherit it).
+ */
+SIM_LOGGER_C_API void sim_logger_set_level(sim_logger_logger_t* logger, sim_logger_level_t level);
+
+/**
+ * @brief Remove the logger's level override (inherit again).
+ */
+SIM_LOGGER_C_API void sim_logger_clear_level(sim_logger_logger_t* logger);
+
+// -----------------------------------------------------------------------------
+// Sink construction
+//
+// Sinks are reference-counted opaque handles. Attaching a sink to a logger (or
+// wrapping it in an async sink) takes its own reference, so the creating
+// handle can be released right away. Functions that can fail return NULL or
+// nonzero and leave a message for sim_logger_last_error().
+//
+// Options structs should be filled by the matching *_options_init() function
+// first, so fields added later get their defaults.
+// -----------------------------------------------------------------------------
+
+typedef struct sim_logger_sink sim_logger_sink_t;
+
+typedef enum sim_logger_color_mode {
+  SIM_LOGGER_COLOR_AUTO   = 0,
+  SIM_LOGGER_COLOR_ALWAYS = 1,
+  SIM_LOGGER_COLOR_NEVER  = 2
+} sim_logger_color_mode_t;
+
+typedef enum sim_logger_overflow_policy {
+  SIM_LOGGER_OVERFLOW_BLOCK       = 0,
+  SIM_LOGGER_OVERFLOW_DROP_NEWEST = 1,
+  SIM_LOGGER_OVERFLOW_DROP_OLDEST = 2
+} sim_logger_overflow_policy_t;
+
+typedef struct sim_logger_console_options {
+  const char* pattern;            // NULL -> "{met} {level} {logger}: {msg}"
+  sim_logger_color_mode_t color;  // default AUTO
+  int use_stderr;                 // nonzero -> stderr instead of stdout
+} sim_logger_console_options_t;
+
+typedef struct sim_logger_file_options {
+  const char* path;    // required
+  const char* pattern; // NULL -> default pattern
+  int durable_flush;   // nonzero -> fsync on flush (POSIX)
+} sim_logger_file_options_t;
+
+typedef struct sim_logger_rotating_file_options {
+  const char* path;         // required
+  const char* pattern;      // NULL -> default pattern
+  uint64_t max_bytes;       // required, > 0
+  int durable_flush;
+  size_t max_rotated_files; // 0 = keep all
+} sim_logger_rotating_file_options_t;
+
+typedef struct sim_logger_async_options {
+  size_t capacity;                       // default 1024
+  sim_logger_overflow_policy_t overflow; // default BLOCK
+  size_t max_batch;                      // default 256
+  int has_priority_level;                // nonzero enables priority_level
+  sim_logger_level_t priority_level;     // flush promptly at or above this level
+  uint32_t linger_us;                    // default 0 (no linger)
+  size_t min_batch;                      // default 1 (with linger: a full batch)
+  size_t format_threads;                 // default 0
+} sim_logger_async_options_t;
+
+SIM_LOGGER_C_API void sim_logger_console_options_init(sim_logger_console_options_t* options);
+SIM_LOGGER_C_API void sim_logger_file_options_init(sim_logger_file_options_t* options);
+SIM_LOGGER_C_API void sim_logger_rotating_file_options_init(sim_logger_rotating_file_options_t* options);
+SIM_LOGGER_C_API void sim_logger_async_options_init(sim_logger_async_options_t* options);
+
+/** @brief Create a console sink (NULL options -> defaults). */
+SIM_LOGGER_C_API sim_logger_sink_t* sim_logger_console_sink_create(
+    const sim_logger_console_options_t* options);
+
+/** @brief Create a file sink; NULL on failure (e.g. the file cannot be opened). */
+SIM_LOGGER_C_API sim_logger_sink_t* sim_logger_file_sink_create(
+    const sim_logger_file_options_t* options);
+
+/** @brief Create a size-rotating file sink; NULL on failure. */
+SIM_LOGGER_C_API sim_logger_sink_t* sim_logger_rotating_file_sink_create(
+    const sim_logger_rotating_file_options_t* options);
+
+/**
+ * @brief Wrap @p target in an async sink with its own worker thread (NULL options -> defaults).
+ *
+ * Returns NULL on failure (NULL target, invalid options).
+ */
+SIM_LOGGER_C_API sim_logger_sink_t* sim_logger_async_sink_create(
+    sim_logger_sink_t* target, const sim_logger_async_options_t* options);
+
+/**
+ * @brief Drop this handle's reference. Safe to call with NULL.
+ *
+ * The sink lives on while loggers or async sinks still use it; the last
+ * reference stops async workers (draining their queues).
+ */
+SIM_LOGGER_C_API void sim_logger_sink_release(sim_logger_sink_t* sink);
+
+/** @brief Set the minimum level this sink accepts. */
+SIM_LOGGER_C_API void sim_logger_sink_set_level(sim_logger_sink_t* sink, sim_logger_level_t level);
+
+/** @brief Flush the sink (for async sinks: wait until queued records are written). */
+SIM_LOGGER_C_API void sim_logger_sink_flush(sim_logger_sink_t* sink);
+
+/** @brief Append @p sink to the logger's own sinks. Returns 0 on success. */
+SIM_LOGGER_C_API int sim_logger_add_sink(sim_logger_logger_t* logger, sim_logger_sink_t* sink);
+
+/**
+ * @brief Replace the logger's sinks with @p sinks[0..count). Returns 0 on success.
+ *
+ * count == 0 gives the logger an explicitly empty sink list.
+ */
+SIM_LOGGER_C_API int sim_logger_set_sinks(sim_logger_logger_t* logger,
+                                          sim_logger_sink_t* const* sinks,
+                                          size_t count);
+
+/**
+ * @brief Message describing the last failure on the calling thread ("" if none).
+ */
+SIM_LOGGER_C_API const char* sim_logger_last_error(void);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
+
+/*
+ * Per-call-site logging macros (printf-style, zero varargs allowed):
+ *
+ *   SIM_LOG_INFO("vehicle1.gnc", "step");
+ *   SIM_LOG_DEBUG("vehicle1.gnc", "dt=%.3f", dt);
+ *
+ * Each expansion caches its handle in a function-local static (one acquire
+ * load per call after the first) and checks the level before formatting.
+ * @p name must be a string literal or otherwise outlive the process.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+  #define SIM_LOGGER_LOAD_HANDLE_(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#else
+  /* Aligned pointer loads are atomic; MSVC gives volatile reads acquire semantics. */
+  #define SIM_LOGGER_LOAD_HANDLE_(p) (*(sim_logger_logger_t* volatile*)(p))
+#endif
+
+#define SIM_LOG_AT_(level, name, ...)                                                        \
+  do {                                                                                       \
+    static sim_logger_logger_t* sim_logger_cached_handle_ = 0;                               \
+    sim_logger_logger_t* sim_logger_h_ = SIM_LOGGER_LOAD_HANDLE_(&sim_logger_cached_handle_); \
+    if (sim_logger_h_ == 0) {                                                                \
+      sim_logger_h_ = sim_logger_get_cached(&sim_logger_cached_handle_, (name));             \
+    }                                                                                        \
+    if (sim_logger_is_enabled(sim_logger_h_, (level))) {                                     \
+      sim_logger_logf(sim_logger_h_, (level), __FILE__, (uint32_t)__LINE__, __func__,        \
+                      __VA_ARGS__);                                                          \
+    } else {                                                                                 \
+      sim_logger_count_filtered(sim_logger_h_, (level));                                     \
+    }                                                                                        \
+  } while (0)
+
+/*
+ * Field initializers for sim_logger_log_kv() (C99 compound literals; C only):
+ *
+ *   const sim_logger_kv_t kv[] = {SIM_LOGGER_KV_I("step", step), SIM_LOGGER_KV_D("dt", dt)};
+ */
+#ifndef __cplusplus
+  #define SIM_LOGGER_KV_S(k, v) ((sim_logger_kv_t){(k), SIM_LOGGER_KV_STRING, {.s = (v)}})
+  #define SIM_LOGGER_KV_I(k, v) ((sim_logger_kv_t){(k), SIM_LOGGER_KV_INT, {.i = (int64_t)(v)}})
+  #define SIM_LOGGER_KV_U(k, v) ((sim_logger_kv_t){(k), SIM_LOGGER_KV_UINT, {.u = (uint64_t)(v)}})
+  #define SIM_LOGGER_KV_D(k, v) ((sim_logger_kv_t){(k), SIM_LOGGER_KV_DOUBLE, {.d = (double)(v)}})
+  #define SIM_LOGGER_KV_B(k, v) ((sim_logger_kv_t){(k), SIM_LOGGER_KV_BOOL, {.b = (v) ? 1 : 0}})
+#endif
+
+#define SIM_LOG_DEBUG(name, ...) SIM_LOG_AT_(SIM_LOGGER_LEVEL_DEBUG, name, __VA_ARGS__)
+#define SIM_LOG_INFO(name, ...)  SIM_LOG_AT_(SIM_LOGGER_LEVEL_INFO, name, __VA_ARGS__)
+#define SIM_LOG_WARN(name, ...)  SIM_LOG_AT_(SIM_LOGGER_LEVEL_WARN, name, __VA_ARGS__)
+#define SIM_LOG_ERROR(name, ...) SIM_LOG_AT_(SIM_LOGGER_LEVEL_ERROR, name, __VA_ARGS__)
+#define SIM_LOG_FATAL(name, ...) SIM_LOG_AT_(SIM_LOGGER_LEVEL_FATAL, name, __VA_ARGS__)
@@ -1,14 +1,26 @@
 #include "sim_logger/c_api.h"
 
+#include "logger/async_sink.hpp"
+#include "logger/backtrace.hpp"
+#include "logger/console_sink.hpp"
+#include "logger/file_sink.hpp"
 #include "logger/global_time.hpp"
 #include "logger/level.hpp"
 #include "logger/log_record.hpp"
 #include "logger/logger.hpp"
 #include "logger/logger_registry.hpp"
+#include "logger/pattern_formatter.hpp"
+#include "logger/rotating_file_sink.hpp"
+#include "logger/static_logger.hpp"
 
+#include <charconv>
+#include <chrono>
 #include <cstdarg>
 #include <cstdio>
+#include <cstdlib>
+#include <exception>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <utility>
@@ -22,8 +34,56 @@ using sim_logger::LoggerRegistry;
 
 struct sim_logger_logger {
   std::shared_ptr<Logger> impl;
+  /// Set for handles created by sim_logger_get_cached(); follows registry resets.
+  std::unique_ptr<sim_logger::StaticLogger> cached;
+
+  Logger& logger() const { return cached ? cached->get() : *impl; }
+};
+
+struct sim_logger_sink {
+  std::shared_ptr<sim_logger::ISink> impl;
 };
 
+namespace {
+
+constexpr const char* kDefaultPattern = "{met} {level} {logger}: {msg}";
+
+thread_local std::string last_error;
+
+void set_last_error(const char* what) noexcept {
+  try {
+    last_error = (what != nullptr) ? what : "";
+  } catch (...) {
+    // keep the previous message
+  }
+}
+
+template <typename Fn>
+sim_logger_sink_t* make_sink(Fn&& fn) noexcept {
+  try {
+    auto* h = new sim_logger_sink();
+    try {
+      h->impl = fn();
+    } catch (...) {
+      delete h;
+      throw;
+    }
+    set_last_error("");
+    return h;
+  } catch (const std::exception& e) {
+    set_last_error(e.what());
+  } catch (...) {
+    set_last_error("unknown failure");
+  }
+  return nullptr;
+}
+
+sim_logger::PatternFormatter formatter_for(const char* pattern) {
+  return sim_logger::PatternFormatter((pattern != nullptr) ? pattern : kDefaultPattern);
+}
+
+}  // namespace
+
 static Level to_cpp_level(sim_logger_level_t lvl) noexcept {
   switch (lvl) {
     case SIM_LOGGER_LEVEL_DEBUG: return Level::Debug;
@@ -35,19 +95,33 @@ static Level to_cpp_level(sim_logger_level_t lvl) noexcept {
   }
 }
 
+static bool valid(const sim_logger_logger_t* logger) noexcept {
+  return logger != nullptr && (logger->impl || logger->cached);
+}
+
+static bool wants_record(Logger& logger, Level level) noexcept {
+  return level >= logger.effective_level() || sim_logger::detail::backtrace_active();
+}
+
 static std::string vformat_printf(const char* fmt, va_list ap) {
   if (fmt == nullptr) {
     return {};
   }
 
+  // Most messages fit on the stack: format once, and only size-and-reformat
+  // when they do not.
+  char stack_buf[256];
   va_list ap_copy;
   va_copy(ap_copy, ap);
-  const int needed = std::vsnprintf(nullptr, 0, fmt, ap_copy);
+  const int needed = std::vsnprintf(stack_buf, sizeof(stack_buf), fmt, ap_copy);
   va_end(ap_copy);
 
   if (needed <= 0) {
     return {};
   }
+  if (static_cast<size_t>(needed) < sizeof(stack_buf)) {
+    return std::string(stack_buf, static_cast<size_t>(needed));
+  }
 
   std::string out;
   out.resize(static_cast<size_t>(needed));
@@ -55,6 +129,84 @@ static std::string vformat_printf(const char* fmt, va_list ap) {
   return out;
 }
 
+// Floating-point std::to_chars needs libstdc++ 11+; older toolchains the build
+// still supports get the shortest of %.15g / %.17g that round-trips.
+static std::string format_double(double v) {
+  char buf[32];
+#if defined(__cpp_lib_to_chars)
+  const auto r = std::to_chars(buf, buf + sizeof(buf), v);
+  return (r.ec == std::errc{}) ? std::string(buf, r.ptr) : std::string{};
+#else
+  std::snprintf(buf, sizeof(buf), "%.15g", v);
+  if (std::strtod(buf, nullptr) != v) {
+    std::snprintf(buf, sizeof(buf), "%.17g", v);
+  }
+  return buf;
+#endif
+}
+
+static std::string kv_value(const sim_logger_kv_t& kv) {
+  char buf[32];
+  std::to_chars_result r{buf, std::errc{}};
+  switch (kv.type) {
+    case SIM_LOGGER_KV_STRING:
+      return (kv.value.s != nullptr) ? std::string(kv.value.s) : std::string{};
+    case SIM_LOGGER_KV_INT:
+      r = std::to_chars(buf, buf + sizeof(buf), kv.value.i);
+      break;
+    case SIM_LOGGER_KV_UINT:
+      r = std::to_chars(buf, buf + sizeof(buf), kv.value.u);
+      break;
+    case SIM_LOGGER_KV_DOUBLE:
+      return format_double(kv.value.d);
+    case SIM_LOGGER_KV_BOOL:
+      return kv.value.b != 0 ? "true" : "false";
+    default:
+      return {};
+  }
+  return (r.ec == std::errc{}) ? std::string(buf, r.ptr) : std::string{};
+}
+
+static void log_owned(Logger& logger,
+                      Level level,
+                      const char* file,
+                      uint32_t line,
+                      const char* func,
+                      std::string msg,
+                      std::vector<sim_logger::Tag> tags = {}) {
+  ITimeSource& ts = sim_logger::global_time_source_ref();
+
+  LogRecord record(level,
+                   ts.sim_time(),
+                   ts.mission_elapsed(),
+                   ts.wall_time_ns(),
+                   std::this_thread::get_id(),
+                   (file != nullptr) ? file : "",
+                   line,
+                   (func != nullptr) ? func : "",
+                   logger.name(),
+                   std::move(tags),
+                   std::move(msg));
+
+  logger.log(record);
+}
+
+static sim_logger_logger_t* load_slot(sim_logger_logger_t** slot) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return __atomic_load_n(slot, __ATOMIC_ACQUIRE);
+#else
+  return *static_cast<sim_logger_logger_t* volatile*>(slot);
+#endif
+}
+
+static void store_slot(sim_logger_logger_t** slot, sim_logger_logger_t* handle) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  __atomic_store_n(slot, handle, __ATOMIC_RELEASE);
+#else
+  *static_cast<sim_logger_logger_t* volatile*>(slot) = handle;
+#endif
+}
+
 extern "C" {
 
 sim_logger_logger_t* sim_logger_get(const char* name) {
@@ -67,34 +219,132 @@ sim_logger_logger_t* sim_logger_get(const char* name) {
 }
 
 void sim_logger_release(sim_logger_logger_t* logger) {
+  // Cached handles are shared by a call site for the life of the process.
+  if (logger != nullptr && logger->cached) {
+    return;
+  }
   delete logger;
 }
 
+sim_logger_logger_t* sim_logger_get_cached(sim_logger_logger_t** slot, const char* name) {
+  if (slot == nullptr) {
+    return nullptr;
+  }
+  if (sim_logger_logger_t* existing = load_slot(slot)) {
+    return existing;
+  }
+
+  // Slow path, once per call site: serialize so racing threads agree on one handle.
+  static std::mutex m;
+  std::lock_guard<std::mutex> lk(m);
+  if (sim_logger_logger_t* existing = load_slot(slot)) {
+    return existing;
+  }
+  auto* h = new sim_logger_logger();
+  h->cached = std::make_unique<sim_logger::StaticLogger>((name != nullptr) ? name : "");
+  store_slot(slot, h);
+  return h;
+}
+
+int sim_logger_is_enabled(const sim_logger_logger_t* logger, sim_logger_level_t level) {
+  if (!valid(logger)) {
+    return 0;
+  }
+  try {
+    return wants_record(logger->logger(), to_cpp_level(level)) ? 1 : 0;
+  } catch (...) {
+    return 0;
+  }
+}
+
+void sim_logger_count_filtered(sim_logger_logger_t* logger, sim_logger_level_t level) {
+  if (!valid(logger)) {
+    return;
+  }
+  try {
+    logger->logger().count_filtered(to_cpp_level(level));
+  } catch (...) {
+    // counting is best effort
+  }
+}
+
 void sim_logger_log(sim_logger_logger_t* logger,
                     sim_logger_level_t level,
                     const char* file,
                     uint32_t line,
                     const char* func,
                     const char* msg) {
-  if (logger == nullptr || !logger->impl) {
+  if (!valid(logger)) {
     return;
   }
+  try {
+    Logger& impl = logger->logger();
+    const Level lvl = to_cpp_level(level);
+    if (!wants_record(impl, lvl)) {
+      impl.count_filtered(lvl);
+      return;
+    }
+    log_owned(impl, lvl, file, line, func, (msg != nullptr) ? std::string(msg) : std::string{});
+  } catch (...) {
+    // C callers cannot handle exceptions (allocation failure).
+  }
+}
 
-  ITimeSource& ts = sim_logger::global_time_source_ref();
+void sim_logger_log_n(sim_logger_logger_t* logger,
+                      sim_logger_level_t level,
+                      const char* file,
+                      uint32_t line,
+                      const char* func,
+                      const char* msg,
+                      size_t len) {
+  if (!valid(logger)) {
+    return;
+  }
+  try {
+    Logger& impl = logger->logger();
+    const Level lvl = to_cpp_level(level);
+    if (!wants_record(impl, lvl)) {
+      impl.count_filtered(lvl);
+      return;
+    }
+    log_owned(impl, lvl, file, line, func, (msg != nullptr) ? std::string(msg, len) : std::string{});
+  } catch (...) {
+    // C callers cannot handle exceptions (allocation failure).
+  }
+}
 
-  LogRecord record(to_cpp_level(level),
-                   ts.sim_time(),
-                   ts.mission_elapsed(),
-                   ts.wall_time_ns(),
-                   std::this_thread::get_id(),
-                   (file != nullptr) ? file : "",
-                   line,
-                   (func != nullptr) ? func : "",
-                   logger->impl->name(),
-                   std::vector<sim_logger::Tag>{},
-                   (msg != nullptr) ? std::string(msg) : std::string{});
+void sim_logger_log_kv(sim_logger_logger_t* logger,
+                       sim_logger_level_t level,
+                       const char* file,
+                       uint32_t line,
+                       const char* func,
+                       const char* msg,
+                       const sim_logger_kv_t* fields,
+                       size_t count) {
+  if (!valid(logger)) {
+    return;
+  }
+  try {
+    Logger& impl = logger->logger();
+    const Level lvl = to_cpp_level(level);
+    if (!wants_record(impl, lvl)) {
+      impl.count_filtered(lvl);
+      return;  // filtered: no number conversion
+    }
 
-  logger->impl->log(record);
+    std::vector<sim_logger::Tag> tags;
+    if (fields != nullptr) {
+      tags.reserve(count);
+      for (size_t i = 0; i < count; ++i) {
+        tags.push_back(sim_logger::Tag{(fields[i].key != nullptr) ? fields[i].key : "",
+                                       kv_value(fields[i])});
+      }
+    }
+    log_owned(impl, lvl, file, line, func, (msg != nullptr) ? std::string(msg) : std::string{},
+              std::move(tags));
+  } catch (...) {
+    // C callers cannot handle exceptions (allocation failure).
+  }
 }
 
 void sim_logger_vlogf(sim_logger_logger_t* logger,
@@ -104,8 +354,20 @@ void sim_logger_vlogf(sim_logger_logger_t* logger,
                       const char* func,
                       const char* fmt,
                       va_list ap) {
-  const std::string formatted = vformat_printf(fmt, ap);
-  sim_logger_log(logger, level, file, line, func, formatted.c_str());
+  if (!valid(logger)) {
+    return;
+  }
+  try {
+    Logger& impl = logger->logger();
+    const Level lvl = to_cpp_level(level);
+    if (!wants_record(impl, lvl)) {
+      impl.count_filtered(lvl);
+      return;  // filtered: no vsnprintf
+    }
+    log_owned(impl, lvl, file, line, func, vformat_printf(fmt, ap));
+  } catch (...) {
+    // C callers cannot handle exceptions (allocation failure).
+  }
 }
 
 void sim_logger_logf(sim_logger_logger_t* logger,
@@ -122,7 +384,7 @@ void sim_logger_logf(sim_logger_logger_t* logger,
 }
 
 void sim_logger_flush(sim_logger_logger_t* logger) {
-  if (logger == nullptr || !logger->impl) {
+  if (!valid(logger)) {
     return;
   }
 
@@ -130,7 +392,7 @@ void sim_logger_flush(sim_logger_logger_t* logger) {
   // Any sink exceptions are contained by the logger's policies elsewhere,
   // but flush() here is outside Logger::log, so contain locally.
   try {
-    const auto sinks = logger->impl->effective_sinks();
+    const auto sinks = logger->logger().effective_sinks();
     for (const auto& s : sinks) {
       try {
         s->flush();
@@ -143,4 +405,203 @@ void sim_logger_flush(sim_logger_logger_t* logger) {
   }
 }
 
+void sim_logger_set_level(sim_logger_logger_t* logger, sim_logger_level_t level) {
+  if (valid(logger)) {
+    try {
+      logger->logger().set_level(to_cpp_level(level));
+    } catch (...) {
+      // registry re-resolution failed (allocation); leave the level unchanged
+    }
+  }
+}
+
+void sim_logger_clear_level(sim_logger_logger_t* logger) {
+  if (valid(logger)) {
+    try {
+      logger->logger().clear_level_override();
+    } catch (...) {
+      // see sim_logger_set_level()
+    }
+  }
+}
+
+void sim_logger_console_options_init(sim_logger_console_options_t* options) {
+  if (options != nullptr) {
+    *options = sim_logger_console_options_t{nullptr, SIM_LOGGER_COLOR_AUTO, 0};
+  }
+}
+
+void sim_logger_file_options_init(sim_logger_file_options_t* options) {
+  if (options != nullptr) {
+    *options = sim_logger_file_options_t{nullptr, nullptr, 0};
+  }
+}
+
+void sim_logger_rotating_file_options_init(sim_logger_rotating_file_options_t* options) {
+  if (options != nullptr) {
+    *options = sim_logger_rotating_file_options_t{nullptr, nullptr, 0, 0, 0};
+  }
+}
+
+void sim_logger_async_options_init(sim_logger_async_options_t* options) {
+  if (options == nullptr) {
+    return;
+  }
+  const sim_logger::AsyncOptions defaults;
+  *options = sim_logger_async_options_t{};
+  options->capacity = defaults.capacity;
+  options->overflow = SIM_LOGGER_OVERFLOW_BLOCK;
+  options->max_batch = defaults.max_batch;
+  options->has_priority_level = 0;
+  options->priority_level = SIM_LOGGER_LEVEL_ERROR;
+  options->linger_us = 0;
+  options->min_batch = defaults.min_batch;
+  options->format_threads = defaults.format_threads;
+}
+
+sim_logger_sink_t* sim_logger_console_sink_create(const sim_logger_console_options_t* options) {
+  sim_logger_console_options_t o;
+  sim_logger_console_options_init(&o);
+  if (options != nullptr) {
+    o = *options;
+  }
+  return make_sink([&]() -> std::shared_ptr<sim_logger::ISink> {
+    using sim_logger::ConsoleSink;
+    ConsoleSink::ColorMode color = ConsoleSink::ColorMode::Auto;
+    if (o.color == SIM_LOGGER_COLOR_ALWAYS) {
+      color = ConsoleSink::ColorMode::Always;
+    } else if (o.color == SIM_LOGGER_COLOR_NEVER) {
+      color = ConsoleSink::ColorMode::Never;
+    }
+    return std::make_shared<ConsoleSink>(formatter_for(o.pattern), color,
+                                         o.use_stderr != 0 ? stderr : stdout);
+  });
+}
+
+sim_logger_sink_t* sim_logger_file_sink_create(const sim_logger_file_options_t* options) {
+  if (options == nullptr || options->path == nullptr) {
+    set_last_error("file sink requires a path");
+    return nullptr;
+  }
+  return make_sink([&]() -> std::shared_ptr<sim_logger::ISink> {
+    return std::make_shared<sim_logger::FileSink>(options->path, formatter_for(options->pattern),
+                                                  options->durable_flush != 0);
+  });
+}
+
+sim_logger_sink_t* sim_logger_rotating_file_sink_create(
+    const sim_logger_rotating_file_options_t* options) {
+  if (options == nullptr || options->path == nullptr) {
+    set_last_error("rotating file sink requires a path");
+    return nullptr;
+  }
+  return make_sink([&]() -> std::shared_ptr<sim_logger::ISink> {
+    return std::make_shared<sim_logger::RotatingFileSink>(
+        options->path, formatter_for(options->pattern), options->max_bytes,
+        options->durable_flush != 0, options->max_rotated_files);
+  });
+}
+
+sim_logger_sink_t* sim_logger_async_sink_create(sim_logger_sink_t* target,
+                                                const sim_logger_async_options_t* options) {
+  if (target == nullptr || !target->impl) {
+    set_last_error("async sink requires a target sink");
+    return nullptr;
+  }
+  sim_logger_async_options_t o;
+  sim_logger_async_options_init(&o);
+  if (options != nullptr) {
+    o = *options;
+  }
+  return make_sink([&]() -> std::shared_ptr<sim_logger::ISink> {
+    sim_logger::AsyncOptions cpp;
+    cpp.capacity = o.capacity;
+    switch (o.overflow) {
+      case SIM_LOGGER_OVERFLOW_DROP_NEWEST:
+        cpp.overflow_policy = sim_logger::OverflowPolicy::DropNewest;
+        break;
+      case SIM_LOGGER_OVERFLOW_DROP_OLDEST:
+        cpp.overflow_policy = sim_logger::OverflowPolicy::DropOldest;
+        break;
+      default:
+        cpp.overflow_policy = sim_logger::OverflowPolicy::Block;
+        break;
+    }
+    cpp.max_batch = o.max_batch;
+    if (o.has_priority_level != 0) {
+      cpp.priority_level = to_cpp_level(o.priority_level);
+    }
+    cpp.linger = std::chrono::microseconds(o.linger_us);
+    cpp.min_batch = o.min_batch;
+    cpp.format_threads = o.format_threads;
+    return std::make_shared<sim_logger::AsyncSink>(target->impl, cpp);
+  });
+}
+
+void sim_logger_sink_release(sim_logger_sink_t* sink) {
+  delete sink;
+}
+
+void sim_logger_sink_set_level(sim_logger_sink_t* sink, sim_logger_level_t level) {
+  if (sink != nullptr && sink->impl) {
+    sink->impl->set_level(to_cpp_level(level));
+  }
+}
+
+void sim_logger_sink_flush(sim_logger_sink_t* sink) {
+  if (sink == nullptr || !sink->impl) {
+    return;
+  }
+  try {
+    sink->impl->flush();
+  } catch (...) {
+    // swallow (best-effort, as sim_logger_flush)
+  }
+}
+
+int sim_logger_add_sink(sim_logger_logger_t* logger, sim_logger_sink_t* sink) {
+  if (!valid(logger) || sink == nullptr || !sink->impl) {
+    set_last_error("sim_logger_add_sink requires a logger and a sink");
+    return -1;
+  }
+  try {
+    logger->logger().add_sink(sink->impl);
+    return 0;
+  } catch (const std::exception& e) {
+    set_last_error(e.what());
+  } catch (...) {
+    set_last_error("unknown failure");
+  }
+  return -1;
+}
+
+int sim_logger_set_sinks(sim_logger_logger_t* logger, sim_logger_sink_t* const* sinks, size_t count) {
+  if (!valid(logger) || (count > 0 && sinks == nullptr)) {
+    set_last_error("sim_logger_set_sinks requires a logger and a sink array");
+    return -1;
+  }
+  try {
+    std::vector<std::shared_ptr<sim_logger::ISink>> list;
+    list.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      if (sinks[i] == nullptr || !sinks[i]->impl) {
+        set_last_error("sim_logger_set_sinks: NULL sink in array");
+        return -1;
+      }
+      list.push_back(sinks[i]->impl);
+    }
+    logger->logger().set_sinks(std::move(list));
+    return 0;
+  } catch (const std::exception& e) {
+    set_last_error(e.what());
+  } catch (...) {
+    set_last_error("unknown failure");
+  }
+  return -1;
+}
+
+const char* sim_logger_last_error(void) {
+  return last_error.c_str();
+}
+
 }  // extern "C"
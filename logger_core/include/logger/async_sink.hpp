@@ -1,11 +1,16 @@
 #pragma once
 
+#include "logger/level.hpp"
 #include "logger/sink.hpp"
 
 #include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <optional>
+#include <string>
+#include <vector>
 
 namespace sim_logger {
 
@@ -51,6 +56,54 @@ struct AsyncOptions {
    * @brief Maximum number of records to drain per worker iteration.
    */
   std::size_t max_batch = 256;
+
+  /**
+   * @brief Records at or above this level take the priority lane (disabled when unset).
+   *
+   * Priority records share the queue with normal records, so ordering is preserved,
+   * but the wrapped sink is flushed right after a priority record is written
+   * instead of waiting for the rest of the batch or the backlog to drain.
+   *
+   * Under DropNewest/DropOldest, a priority record arriving at a full queue
+   * evicts the oldest queued record instead of being dropped, and normal records
+   * never evict a priority record. Priority records are only lost when a priority
+   * record arrives while another one is the oldest queued record; those drops
+   * are counted in priority_dropped_records_count() as well.
+   */
+  std::optional<Level> priority_level;
+
+  /**
+   * @brief Maximum time the worker waits for a batch to fill after waking (0 disables).
+   *
+   * Flush, stop and priority records cut the wait short.
+   */
+  std::chrono::microseconds linger{0};
+
+  /**
+   * @brief Number of queued records that ends the linger early.
+   *
+   * Clamped to [1, min(capacity, max_batch)]. When linger is set and this is
+   * left at 1 (the default), min(capacity, max_batch) is used, so linger alone
+   * coalesces writes.
+   */
+  std::size_t min_batch = 1;
+
+  /**
+   * @brief Extra threads that render records in parallel before they are written (0 disables).
+   *
+   * Only used when the wrapped sink exposes a formatter() (ConsoleSink, FileSink,
+   * RotatingFileSink). Each batch is split across these threads and the worker;
+   * the worker then hands the lines to write_formatted() in queue order, so
+   * output order is unchanged.
+   */
+  std::size_t format_threads = 0;
+
+  /**
+   * @brief Value of the `sink` label on this sink's metrics (see metrics.hpp).
+   *
+   * Empty picks "async-<n>", numbered in construction order.
+   */
+  std::string metrics_name;
 };
 
 /**
@@ -79,6 +132,14 @@ class AsyncSink final : public ISink {
   void write(const LogRecord& record) override;
   void flush() override;
 
+  /**
+   * @brief Accept only records that both this sink and the wrapped sink accept.
+   *
+   * Consulted by Logger::log before write(), so records the wrapped sink would
+   * drop are never copied into the queue.
+   */
+  bool should_log(const LogRecord& record) const noexcept override;
+
   /**
    * @brief Total number of records dropped due to queue overflow.
    */
@@ -86,6 +147,13 @@ class AsyncSink final : public ISink {
     return dropped_records_count_.load(std::memory_order_relaxed);
   }
 
+  /**
+   * @brief Priority records dropped due to queue overflow (included in dropped_records_count()).
+   */
+  std::uint64_t priority_dropped_records_count() const noexcept {
+    return priority_dropped_records_count_.load(std::memory_order_relaxed);
+  }
+
   /**
    * @brief Total number of times the wrapped sink threw during write/flush.
    */
@@ -93,9 +161,23 @@ class AsyncSink final : public ISink {
     return sink_failures_count_.load(std::memory_order_relaxed);
   }
 
+  /**
+   * @brief Number of wrapped-sink flushes triggered by priority records.
+   */
+  std::uint64_t priority_flushes_count() const noexcept {
+    return priority_flushes_count_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief The `sink` label used for this sink's metrics.
+   */
+  const std::string& metrics_name() const noexcept { return options_.metrics_name; }
+
  private:
   void worker_loop_() noexcept;
   void request_stop_() noexcept;
+  /// Write batch[0..count) to the wrapped sink.
+  void write_batch_(const std::vector<LogRecord>& batch, std::size_t count) noexcept;
 
   std::shared_ptr<ISink> wrapped_;
   AsyncOptions options_;
@@ -109,7 +191,9 @@ class AsyncSink final : public ISink {
   std::atomic<std::uint64_t> flush_done_gen_{0};
 
   std::atomic<std::uint64_t> dropped_records_count_{0};
+  std::atomic<std::uint64_t> priority_dropped_records_count_{0};
   std::atomic<std::uint64_t> sink_failures_count_{0};
+  std::atomic<std::uint64_t> priority_flushes_count_{0};
 
   struct Impl;
   std::unique_ptr<Impl> impl_;
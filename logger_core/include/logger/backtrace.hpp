@@ -0,0 +1,93 @@
+#pragma once
+
+#include "logger/level.hpp"
+#include "logger/log_record.hpp"
+#include "logger/sink.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace sim_logger {
+
+/**
+ * @file backtrace.hpp
+ * @brief Per-thread backtrace buffers for records filtered out by logger level.
+ *
+ * @details
+ * When enabled, every record that Logger::log(...) filters out by level is kept,
+ * unformatted, in a ring owned by the producing thread. Formatting is deferred
+ * until the ring is emitted, so capture costs one LogRecord copy.
+ *
+ * Emission:
+ * - When a thread emits a record at or above trigger_level, that thread's ring is
+ *   written to the backtrace target first, giving the context that led up to it.
+ * - dump_backtrace() merges the rings of all threads by wall_time_ns and writes them
+ *   to the target (a global trigger, e.g. on shutdown after a fault).
+ *
+ * Concurrency:
+ * - Each ring is written only by its owning thread. The per-ring guard is only
+ *   contended while a dump is reading that ring, so producers never contend with
+ *   each other.
+ * - Rings of exited threads are retained until the next dump_backtrace().
+ */
+
+/**
+ * @brief Backtrace configuration.
+ */
+struct BacktraceOptions {
+  /**
+   * @brief Number of filtered records retained per thread.
+   */
+  std::size_t per_thread_capacity = 256;
+
+  /**
+   * @brief Emitted records at or above this level dump the calling thread's ring.
+   */
+  Level trigger_level = Level::Error;
+};
+
+/**
+ * @brief Enable backtrace capture, replacing any previous configuration.
+ *
+ * Existing per-thread rings are discarded.
+ *
+ * @param target Sink that receives emitted backtraces (must be non-null).
+ * @throws std::invalid_argument if target is null.
+ */
+void enable_backtrace(std::shared_ptr<ISink> target, BacktraceOptions options = {});
+
+/**
+ * @brief Disable backtrace capture and discard all retained records.
+ */
+void disable_backtrace() noexcept;
+
+/**
+ * @brief Merge all per-thread rings by timestamp and write them to the target.
+ *
+ * The target is flushed afterwards. Sink exceptions are swallowed.
+ */
+void dump_backtrace() noexcept;
+
+namespace detail {
+
+/// Hot-path switch read by Logger::log(...) before touching any backtrace state.
+inline std::atomic<bool> backtrace_active_flag{false};
+
+inline bool backtrace_active() noexcept {
+  return backtrace_active_flag.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Store a filtered record in the calling thread's ring.
+ */
+void backtrace_capture(const LogRecord& record) noexcept;
+
+/**
+ * @brief Called for emitted records; dumps the calling thread's ring on trigger level.
+ */
+void backtrace_on_emit(const LogRecord& record) noexcept;
+
+}  // namespace detail
+
+}  // namespace sim_logger
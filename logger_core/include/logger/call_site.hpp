@@ -0,0 +1,218 @@
+#pragma once
+
+#include "logger/level.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sim_logger {
+
+/**
+ * @file call_site.hpp
+ * @brief Per-call-site enable/disable registry for the LOG_* macros.
+ *
+ * @details
+ * Every LOG_* macro expansion owns a constant-initialized CallSite (file, line,
+ * level, state, hit counter). A site registers itself in a global list the
+ * first time it runs, before its arguments are evaluated, and picks up any
+ * matching call-site rules at that point, so rules set before a site first runs
+ * still apply to it.
+ *
+ * States:
+ * - Default:  the logger's effective level decides (normal behaviour).
+ * - Enabled:  the record is emitted regardless of the logger's level; sink
+ *             levels and filters still apply.
+ * - Disabled: the macro skips everything after one load, including evaluating
+ *             the logger and message arguments.
+ *
+ * Rules are written "file[:line[-line]]", where file is a glob (see
+ * detail/name_glob.hpp) matched against the full __FILE__ path or its last
+ * component, e.g. "guidance.cpp:120-300", "gnc_*.cpp", "main.cpp:42".
+ * The last matching rule wins; Default rules therefore act as resets.
+ *
+ * Profiling (off by default): with set_call_site_profiling(true), each site
+ * also accumulates the records it built, their message bytes and the frontend
+ * time spent in the macro (formatting, record construction and handing the
+ * record to the logger's sinks). The counters are plain members of the static
+ * CallSite, so no lookup happens on the hot path; when profiling is off the
+ * cost is one relaxed load per built record. top_call_sites() and
+ * call_site_report() rank sites by any of the three. Hits (every pass through
+ * the site, filtered or not) are also only counted while profiling, so the
+ * shared per-site counter stays off the hot path otherwise.
+ *
+ * Thread-safety:
+ * - All functions are safe to call concurrently with logging.
+ */
+
+namespace detail {
+struct CallSiteRegistry;
+}  // namespace detail
+
+enum class CallSiteState : std::uint8_t { Default = 0, Enabled = 1, Disabled = 2 };
+
+std::string_view to_string(CallSiteState state) noexcept;
+
+namespace detail {
+extern std::atomic<bool> g_call_site_profiling;
+}  // namespace detail
+
+/**
+ * @brief Whether LOG_* call sites are accumulating profile counters.
+ */
+inline bool call_site_profiling() noexcept {
+  return detail::g_call_site_profiling.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Turn call-site profiling on or off (counters are kept; see reset_call_site_profiles()).
+ */
+void set_call_site_profiling(bool enabled) noexcept;
+
+class CallSite final {
+ public:
+  constexpr CallSite(const char* file, unsigned line, Level level) noexcept
+      : file_(file), line_(line), level_(level) {}
+
+  CallSite(const CallSite&) = delete;
+  CallSite& operator=(const CallSite&) = delete;
+
+  /**
+   * @brief Hot-path check used by the macros (one relaxed load).
+   */
+  bool disabled() const noexcept {
+    return state_.load(std::memory_order_relaxed) == kDisabled;
+  }
+
+  /**
+   * @brief Register on first use and return the current state; counts the hit
+   * while call_site_profiling() is on.
+   *
+   * @param function Enclosing function name (__func__), recorded at registration.
+   */
+  CallSiteState enter(const char* function) noexcept {
+    std::uint8_t s = state_.load(std::memory_order_acquire);
+    if (s == kUnregistered) {
+      s = register_(function);
+    }
+    if (call_site_profiling()) {
+      hits_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return static_cast<CallSiteState>(s);
+  }
+
+  /**
+   * @brief Add one built record of @p bytes that took @p frontend_ns (profiling mode).
+   */
+  void add_profile(std::uint64_t bytes, std::uint64_t frontend_ns) noexcept {
+    records_.fetch_add(1, std::memory_order_relaxed);
+    bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    frontend_ns_.fetch_add(frontend_ns, std::memory_order_relaxed);
+  }
+
+  const char* file() const noexcept { return file_; }
+  unsigned line() const noexcept { return line_; }
+  Level level() const noexcept { return level_; }
+
+ private:
+  friend struct detail::CallSiteRegistry;
+
+  static constexpr std::uint8_t kUnregistered = 0xFF;
+  static constexpr std::uint8_t kDisabled = static_cast<std::uint8_t>(CallSiteState::Disabled);
+
+  std::uint8_t register_(const char* function) noexcept;
+
+  const char* file_;
+  unsigned line_;
+  Level level_;
+  const char* function_ = nullptr;
+  std::atomic<std::uint8_t> state_{kUnregistered};
+  // Profiling counters (only updated while call_site_profiling() is on).
+  std::atomic<std::uint64_t> hits_{0};
+  std::atomic<std::uint64_t> records_{0};
+  std::atomic<std::uint64_t> bytes_{0};
+  std::atomic<std::uint64_t> frontend_ns_{0};
+  /// Next registered site (written once under the registry lock).
+  CallSite* next_ = nullptr;
+};
+
+/**
+ * @brief Snapshot of one registered call site.
+ */
+struct CallSiteInfo {
+  std::string file;
+  unsigned line = 0;
+  std::string function;
+  Level level = Level::Info;
+  CallSiteState state = CallSiteState::Default;
+  /// Passes through this site (filtered or not) while profiling.
+  std::uint64_t hits = 0;
+  /// Records built at this site while profiling.
+  std::uint64_t records = 0;
+  /// Message bytes of those records.
+  std::uint64_t bytes = 0;
+  /// Cumulative frontend time of those records.
+  std::uint64_t frontend_ns = 0;
+};
+
+/**
+ * @brief Ranking used by top_call_sites() and call_site_report().
+ */
+enum class CallSiteOrder : std::uint8_t { Records, Bytes, Time };
+
+std::string_view to_string(CallSiteOrder order) noexcept;
+
+/**
+ * @brief Parse "records", "bytes" or "time".
+ */
+std::optional<CallSiteOrder> call_site_order_from_string(std::string_view s) noexcept;
+
+/**
+ * @brief Set @p state for every site matching @p spec, now and when registered later.
+ *
+ * @return Number of currently registered sites that matched.
+ * @throws std::invalid_argument if spec is malformed (empty file, bad line range).
+ */
+std::size_t set_call_sites(std::string_view spec, CallSiteState state);
+
+/**
+ * @brief Drop all call-site rules and return every site to Default.
+ */
+void clear_call_site_rules() noexcept;
+
+/**
+ * @brief Registered sites, in registration order.
+ */
+std::vector<CallSiteInfo> call_sites();
+
+/**
+ * @brief The @p n sites with the most records, bytes or frontend time (sites with no
+ * profiled records are skipped), highest first.
+ */
+std::vector<CallSiteInfo> top_call_sites(std::size_t n, CallSiteOrder order = CallSiteOrder::Records);
+
+/**
+ * @brief Zero every site's profiling counters (hits, records, bytes and time).
+ */
+void reset_call_site_profiles() noexcept;
+
+/**
+ * @brief Human-readable table of top_call_sites(@p n, @p order).
+ *
+ * Each row shows records, bytes, total and mean frontend time, the site's share
+ * of the ranked quantity and the running (cumulative) share, so the few sites
+ * that make up most of the volume stand out.
+ */
+std::string call_site_report(std::size_t n, CallSiteOrder order = CallSiteOrder::Records);
+
+/**
+ * @brief At process exit, write call_site_report() by records and by time to @p path
+ * (stderr when empty). The last call's arguments win.
+ */
+void report_call_sites_at_exit(std::size_t n, std::string path = {});
+
+}  // namespace sim_logger
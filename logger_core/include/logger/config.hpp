@@ -0,0 +1,155 @@
+#pragma once
+
+#include "logger/level.hpp"
+#include "logger/sink.hpp"
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sim_logger {
+
+class LoggerRegistry;
+
+/**
+ * @file config.hpp
+ * @brief Declarative INI-style configuration of sinks, async stages and loggers.
+ *
+ * @details
+ * Example:
+ * @code
+ *   # '#' and ';' start comments
+ *   [registry]
+ *   level_rules = vehicle*.gnc=debug,*.sensors=warn
+ *
+ *   [sink.console]
+ *   type    = console          ; console | file | rotating | async
+ *   pattern = {met} {level} {logger}: {msg}
+ *   color   = auto             ; auto | always | never
+ *
+ *   [sink.file]
+ *   type      = rotating
+ *   path      = sim.log
+ *   max_bytes = 10485760
+ *   max_files = 5
+ *
+ *   [sink.file_async]
+ *   type           = async
+ *   target         = file
+ *   capacity       = 8192
+ *   overflow       = block     ; block | drop_newest | drop_oldest
+ *   max_batch      = 256
+ *   priority_level = warn
+ *   linger_us      = 2000
+ *   min_batch      = 64
+ *   format_threads = 2
+ *
+ *   [logger.root]
+ *   level = info
+ *   sinks = console, file_async
+ * @endcode
+ *
+ * Keys shared by every sink: type (required), level (sink minimum level).
+ * Text sinks (console/file/rotating) also take pattern; file sinks take path and
+ * durable_flush; rotating sinks take max_bytes and max_files. Logger sections
+ * take level, sinks (comma-separated sink names) and immediate_flush.
+ *
+ * Loading is two-phase: parse_config() reads and validates the text into a
+ * ConfigSpec without side effects (no files are opened), and apply_config()
+ * builds the sinks and configures loggers in a registry. describe_config()
+ * renders the resolved logger tree for a validation/dry-run mode.
+ */
+
+/**
+ * @brief Raised for malformed or inconsistent configuration.
+ *
+ * The message is prefixed with "<line>: " when the problem maps to a line.
+ */
+class ConfigError : public std::runtime_error {
+ public:
+  using std::runtime_error::runtime_error;
+};
+
+/**
+ * @brief One [sink.NAME] section.
+ */
+struct SinkSpec {
+  std::string name;
+  std::string type;
+  /// Remaining keys, validated for the sink type.
+  std::map<std::string, std::string> options;
+  /// Line of the section header (for diagnostics).
+  int line = 0;
+};
+
+/**
+ * @brief One [logger.NAME] section.
+ */
+struct LoggerSpec {
+  std::string name;
+  std::optional<Level> level;
+  std::optional<std::vector<std::string>> sinks;
+  std::optional<bool> immediate_flush;
+  int line = 0;
+};
+
+/**
+ * @brief Parsed and validated configuration.
+ */
+struct ConfigSpec {
+  std::vector<SinkSpec> sinks;
+  std::vector<LoggerSpec> loggers;
+  /// Value of [registry] level_rules, if present.
+  std::optional<std::string> level_rules;
+};
+
+/**
+ * @brief Sinks built by apply_config(), keyed by section name.
+ */
+struct AppliedConfig {
+  std::map<std::string, std::shared_ptr<ISink>> sinks;
+};
+
+/**
+ * @brief Parse and validate configuration text.
+ *
+ * Checks section/key names, value syntax, sink references and async target
+ * cycles.
+ *
+ * @throws ConfigError on any problem.
+ */
+ConfigSpec parse_config(std::string_view text);
+
+/**
+ * @brief Read and parse a configuration file.
+ *
+ * @throws ConfigError if the file cannot be read or is invalid.
+ */
+ConfigSpec parse_config_file(const std::string& path);
+
+/**
+ * @brief Build the sinks and apply logger settings to @p registry.
+ *
+ * Level rules (if any) replace the registry's current rules.
+ *
+ * @throws ConfigError or the sink constructors' exceptions (e.g. a file sink
+ *         that cannot open its path). Loggers are only modified once every sink
+ *         has been built.
+ */
+AppliedConfig apply_config(const ConfigSpec& spec, LoggerRegistry& registry);
+
+/**
+ * @brief Render the resolved configuration: sinks with their effective options,
+ * then the logger tree with effective levels and sinks (and where each comes from).
+ *
+ * Resolution mirrors Logger: explicit level, then matching level rule, then the
+ * nearest configured ancestor, then Info; sinks come from the nearest ancestor
+ * (or self) that configures them.
+ */
+std::string describe_config(const ConfigSpec& spec);
+
+}  // namespace sim_logger
@@ -47,6 +47,9 @@ class ConsoleSink final : public ISink {
   void write(const LogRecord& record) override;
   void flush() override;
 
+  const PatternFormatter* formatter() const noexcept override { return &formatter_; }
+  void write_formatted(const LogRecord& record, std::string_view line) override;
+
  private:
   PatternFormatter formatter_;
   ColorMode color_mode_;
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "logger/level.hpp"
+#include "logger/sink.hpp"
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace sim_logger {
+
+class Logger;
+class LoggerRegistry;
+
+/**
+ * @file control_server.hpp
+ * @brief Opt-in local control socket for live reconfiguration.
+ *
+ * @details
+ * ControlServer runs one thread that listens on a Unix domain socket (created
+ * with mode 0600) and serves a line-based text protocol: a client sends one
+ * command line, receives the reply, and the connection is closed.
+ *
+ * Commands:
+ * - `level <glob> <level>`  add/replace the registry level rule for <glob>; explicit
+ *                           set_level() levels (code or config) on matching loggers are
+ *                           suspended so the rule takes effect
+ * - `level <glob> reset`    remove the rule for <glob> and restore the levels it suspended
+ *   Both reply "ok changed <n> loggers", counting loggers whose effective level changed.
+ * - `levels`                list the current level rules
+ * - `site <spec> <on|off|default>` force LOG_* call sites on/off (see call_site.hpp)
+ * - `sites`                 list registered call sites with state and hit counts (hits while profiling)
+ * - `profile <on|off|reset>` toggle call-site profiling or zero its counters
+ * - `hot [n] [records|bytes|time]` top-n call sites by profiled records, bytes or frontend time
+ * - `flush`                 flush every sink reachable from the registry plus registered sinks
+ * - `metrics`               per-logger and per-registered-sink counters
+ * - `metrics prometheus`    MetricsRegistry::instance() snapshot in Prometheus text format
+ * - `stats [glob]`          per-logger emitted/filtered records per level and bytes, plus a total
+ * - `dump [name|backtrace]` dump registered flight recorders (all or one) and/or the backtrace
+ * - `help`
+ *
+ * Replies start with "ok" or "error:".
+ *
+ * Level changes go through LoggerRegistry::set_level_rules(), which re-resolves
+ * each logger's cached effective level; Logger::log(...) observes them with a
+ * single atomic load and never waits on the control thread. A rule ranks below
+ * an explicit Logger::set_level() on the same logger (see logger_registry.hpp),
+ * so `level` remembers each explicit level it clears, per glob, and `reset`
+ * puts it back unless the logger has been given a new explicit level since.
+ *
+ * Platform: POSIX only. On other platforms start() throws.
+ */
+class ControlServer final {
+ public:
+  /**
+   * @param socket_path Filesystem path of the socket. A stale socket at this path
+   *        is replaced; any other file there makes start() fail.
+   * @param registry Registry to control.
+   */
+  explicit ControlServer(std::string socket_path);
+  ControlServer(std::string socket_path, LoggerRegistry& registry);
+
+  /**
+   * @brief Stops the server and removes the socket file.
+   */
+  ~ControlServer();
+
+  ControlServer(const ControlServer&) = delete;
+  ControlServer& operator=(const ControlServer&) = delete;
+
+  /**
+   * @brief Bind the socket and start the control thread.
+   *
+   * The socket is bound inside a private (0700) directory created next to
+   * socket_path, restricted to 0600, then renamed into place, so it is never
+   * reachable with looser permissions and the process umask is left alone.
+   *
+   * @throws std::runtime_error if already running, if something other than a
+   *         socket exists at socket_path, or if the socket cannot be created.
+   */
+  void start();
+
+  /**
+   * @brief Stop the control thread (idempotent).
+   */
+  void stop() noexcept;
+
+  bool running() const noexcept { return running_.load(std::memory_order_acquire); }
+
+  const std::string& socket_path() const noexcept { return socket_path_; }
+
+  /**
+   * @brief Make a sink addressable by name for flush/metrics/dump.
+   *
+   * FlightRecorderSink instances are dumped by `dump`; AsyncSink and
+   * FlightRecorderSink counters are reported by `metrics`.
+   */
+  void register_sink(std::string name, std::shared_ptr<ISink> sink);
+
+  /**
+   * @brief Execute one command line and return the reply (without trailing newline).
+   *
+   * This is what the socket thread calls; it is public so embedders can expose
+   * the same commands through other channels. Never throws.
+   */
+  std::string execute(std::string_view command) noexcept;
+
+ private:
+  void serve_() noexcept;
+  void handle_client_(int fd) noexcept;
+
+  std::string socket_path_;
+  LoggerRegistry& registry_;
+
+  std::mutex sinks_mutex_;
+  std::map<std::string, std::shared_ptr<ISink>> sinks_;
+
+  /// Explicit levels cleared by `level <glob> <level>`, restored by `level <glob> reset`.
+  std::mutex levels_mutex_;
+  std::map<std::string, std::vector<std::pair<std::weak_ptr<Logger>, Level>>> suspended_levels_;
+
+  int listen_fd_ = -1;
+  int wake_pipe_[2] = {-1, -1};
+  std::thread thread_;
+  std::atomic<bool> running_{false};
+};
+
+}  // namespace sim_logger
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "logger/sink.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sim_logger {
+
+/**
+ * @brief Options for DedupSink.
+ */
+struct DedupOptions {
+  /**
+   * @brief Duplicates are suppressed for this long after the first occurrence
+   *        (measured on LogRecord::wall_time_ns()).
+   */
+  std::chrono::nanoseconds window = std::chrono::seconds(1);
+
+  /**
+   * @brief Value of the `sink` label on this sink's metrics.
+   *
+   * Empty picks "dedup-<n>", numbered in construction order.
+   */
+  std::string metrics_name;
+};
+
+/**
+ * @file dedup_sink.hpp
+ * @brief Decorator sink that coalesces consecutive duplicate records.
+ *
+ * @details
+ * Records are grouped by call site (logger name, file, line). Within a group, a
+ * record whose level and message hash equal the previous forwarded record, and
+ * which arrives within the window, is suppressed and counted. When the run ends
+ * (a different message arrives at that call site), the window expires, or flush()
+ * is called, a single summary record is forwarded:
+ *
+ *   "last message repeated N times"
+ *
+ * carrying the metadata (time, location, tags) of the last suppressed record.
+ *
+ * Message comparison uses a 64-bit FNV-1a hash; the message text is not stored.
+ * Pending summaries are also forwarded when the sink is destroyed.
+ *
+ * Suppressed records and the number of tracked call sites are published in
+ * MetricsRegistry::instance().
+ *
+ * Thread-safety:
+ * - Call-site state is guarded by an internal mutex; the wrapped sink is called
+ *   outside that mutex.
+ */
+class DedupSink final : public ISink {
+ public:
+  /**
+   * @param wrapped Sink that receives forwarded records (must be non-null).
+   * @throws std::invalid_argument if wrapped is null.
+   */
+  explicit DedupSink(std::shared_ptr<ISink> wrapped, DedupOptions options = {});
+  ~DedupSink() override;
+
+  DedupSink(const DedupSink&) = delete;
+  DedupSink& operator=(const DedupSink&) = delete;
+
+  void write(const LogRecord& record) override;
+
+  /**
+   * @brief Forward pending repeat summaries, then flush the wrapped sink.
+   */
+  void flush() override;
+
+  /**
+   * @brief Accept only records that both this sink and the wrapped sink accept.
+   */
+  bool should_log(const LogRecord& record) const noexcept override;
+
+  /**
+   * @brief Total number of records suppressed as duplicates.
+   */
+  std::uint64_t suppressed_records_count() const noexcept {
+    return suppressed_records_count_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Number of call sites currently tracked.
+   */
+  std::size_t tracked_sites_count() const;
+
+  /**
+   * @brief The `sink` label used for this sink's metrics.
+   */
+  const std::string& metrics_name() const noexcept { return options_.metrics_name; }
+
+ private:
+  struct SiteState {
+    std::uint64_t message_hash = 0;
+    std::int64_t first_wall_time_ns = 0;
+    std::uint64_t repeats = 0;
+    /// Last suppressed record (metadata for the summary).
+    std::optional<LogRecord> last;
+  };
+
+  static LogRecord make_summary_(const LogRecord& last, std::uint64_t repeats);
+  /// Summaries for every site with pending repeats; resets their counts.
+  std::vector<LogRecord> take_summaries_();
+
+  std::shared_ptr<ISink> wrapped_;
+  DedupOptions options_;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::uint64_t, SiteState> sites_;
+
+  std::atomic<std::uint64_t> suppressed_records_count_{0};
+  std::uint64_t metrics_collector_id_ = 0;
+};
+
+}  // namespace sim_logger
@@ -15,6 +15,7 @@ namespace sim_logger::detail {
 struct EnqueueResult {
   bool enqueued = false;
   std::uint32_t dropped = 0;  // number of records dropped to satisfy the enqueue
+  std::uint32_t priority_dropped = 0;  // how many of those were priority records
 };
 
 /**
@@ -37,17 +38,41 @@ class IQueue {
    */
   virtual EnqueueResult enqueue(LogRecord&& r) = 0;
 
+  /**
+   * @brief Enqueue a copy of @p r, copying into storage the queue already owns.
+   *
+   * Same results as enqueue(). Lets producers hand over a borrowed record without
+   * materializing a temporary copy first.
+   */
+  virtual EnqueueResult enqueue_copy(const LogRecord& r) = 0;
+
   /**
    * @brief Dequeue up to max records, appending them to out.
    * @return number of records appended.
    */
   virtual std::size_t dequeue_batch(std::vector<LogRecord>& out, std::size_t max) = 0;
 
+  /**
+   * @brief Dequeue up to batch.size() records by swapping them into batch[0..n).
+   *
+   * The records previously held in those positions go back to the queue as
+   * storage, so a consumer that keeps reusing the same batch recycles string
+   * buffers instead of freeing and reallocating them.
+   *
+   * @return n, the number of positions filled.
+   */
+  virtual std::size_t exchange_batch(std::vector<LogRecord>& batch) = 0;
+
   /**
    * @brief Whether the queue is empty.
    */
   virtual bool empty() const = 0;
 
+  /**
+   * @brief Number of queued records.
+   */
+  virtual std::size_t size() const = 0;
+
   /**
    * @brief Request stop and wake any blocked threads.
    */
@@ -2,32 +2,65 @@
 
 #include "logger/detail/async_queue.hpp"
 
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <optional>
+#include <utility>
 #include <vector>
 
 namespace sim_logger::detail {
 
 /**
  * @brief Mutex + condition_variable bounded ring-buffer queue.
+ *
+ * @details
+ * Slots always hold a LogRecord. Dequeued/evicted slots keep their string
+ * buffers, so enqueue_copy() and exchange_batch() reach a steady state with no
+ * heap traffic; retained memory is bounded by capacity (plus one staging record
+ * per producer thread) times the largest records seen. When the lock is
+ * contended, enqueue_copy() copies outside it and only swaps under it.
+ *
+ * Priority records (level >= priority_level) are exempt from the drop policies
+ * where possible: under DropNewest an incoming priority record evicts the oldest
+ * queued record instead of being dropped, and under DropOldest a normal incoming
+ * record is dropped rather than evicting a priority record at the head. A
+ * priority record is only lost when one arrives while another sits at the head;
+ * such drops are reported in EnqueueResult::priority_dropped.
  */
 class MutexRingBufferQueue final : public IQueue {
  public:
-  MutexRingBufferQueue(std::size_t capacity, OverflowPolicy policy);
+  MutexRingBufferQueue(std::size_t capacity,
+                       OverflowPolicy policy,
+                       std::optional<Level> priority_level = std::nullopt);
 
   EnqueueResult enqueue(LogRecord&& r) override;
+  EnqueueResult enqueue_copy(const LogRecord& r) override;
   std::size_t dequeue_batch(std::vector<LogRecord>& out, std::size_t max) override;
+  std::size_t exchange_batch(std::vector<LogRecord>& batch) override;
   bool empty() const override;
+  std::size_t size() const override;
   void request_stop() override;
   void notify_consumer() override;
 
   /**
    * @brief Wait until work is available, a flush kick is requested, or stop is requested.
    *
+   * @return true if a flush kick was pending (and has been consumed).
+   *
    * @note Exposed for AsyncSink's worker loop.
    */
-  void wait_for_work(std::unique_lock<std::mutex>& lk);
+  bool wait_for_work(std::unique_lock<std::mutex>& lk);
+
+  /**
+   * @brief Wait until at least @p min_count items are queued, a flush kick or stop
+   * is requested, or @p deadline passes.
+   *
+   * @note Exposed for AsyncSink's batch linger.
+   */
+  void wait_for_batch(std::unique_lock<std::mutex>& lk,
+                      std::size_t min_count,
+                      std::chrono::steady_clock::time_point deadline);
 
   /**
    * @brief Mark that a flush kick is requested and wake the consumer.
@@ -40,7 +73,14 @@ class MutexRingBufferQueue final : public IQueue {
   bool has_items_unlocked() const { return count_ > 0; }
 
  private:
-  void push_unlocked_(LogRecord&& r);
+  /**
+   * @brief Apply stop/overflow policy; on success the slot at tail_ may be written.
+   */
+  EnqueueResult admit_unlocked_(std::unique_lock<std::mutex>& lk, Level level);
+  bool is_priority_(Level level) const noexcept {
+    return priority_level_ && level >= *priority_level_;
+  }
+  void commit_push_unlocked_();
   void pop_oldest_unlocked_();
 
   mutable std::mutex m_;
@@ -49,8 +89,9 @@ class MutexRingBufferQueue final : public IQueue {
 
   std::size_t capacity_;
   OverflowPolicy policy_;
+  std::optional<Level> priority_level_;
 
-  std::vector<std::optional<LogRecord>> buffer_;
+  std::vector<LogRecord> buffer_;
   std::size_t head_ = 0;
   std::size_t tail_ = 0;
   std::size_t count_ = 0;
@@ -58,49 +99,108 @@ class MutexRingBufferQueue final : public IQueue {
   bool flush_kick_ = false;
 };
 
-inline MutexRingBufferQueue::MutexRingBufferQueue(std::size_t capacity, OverflowPolicy policy)
-    : capacity_(capacity), policy_(policy), buffer_(capacity) {
+inline MutexRingBufferQueue::MutexRingBufferQueue(std::size_t capacity,
+                                                  OverflowPolicy policy,
+                                                  std::optional<Level> priority_level)
+    : capacity_(capacity), policy_(policy), priority_level_(priority_level), buffer_(capacity) {
   if (capacity_ == 0) {
     capacity_ = 1;
     buffer_.resize(1);
   }
 }
 
-inline EnqueueResult MutexRingBufferQueue::enqueue(LogRecord&& r) {
-  std::unique_lock<std::mutex> lk(m_);
-
+inline EnqueueResult MutexRingBufferQueue::admit_unlocked_(std::unique_lock<std::mutex>& lk,
+                                                            Level level) {
   if (stop_requested_) {
     return EnqueueResult{false, 0};
   }
 
-  std::uint32_t dropped = 0;
-
   if (policy_ == OverflowPolicy::Block) {
     cv_not_full_.wait(lk, [&] { return stop_requested_ || count_ < capacity_; });
     if (stop_requested_) {
       return EnqueueResult{false, 0};
     }
-  } else if (count_ >= capacity_) {
-    if (policy_ == OverflowPolicy::DropNewest) {
-      return EnqueueResult{false, 1};
+    return EnqueueResult{true, 0};
+  }
+  if (count_ < capacity_) {
+    return EnqueueResult{true, 0};
+  }
+
+  const bool incoming_priority = is_priority_(level);
+  const bool oldest_priority = is_priority_(buffer_[head_].level());
+  const bool drop_incoming = (policy_ == OverflowPolicy::DropNewest)
+                                 ? !incoming_priority
+                                 : (oldest_priority && !incoming_priority);
+  if (drop_incoming) {
+    return EnqueueResult{false, 1};
+  }
+  // Evict the oldest (its slot keeps its buffers) and admit the new record.
+  pop_oldest_unlocked_();
+  return EnqueueResult{true, 1, oldest_priority ? 1U : 0U};
+}
+
+inline EnqueueResult MutexRingBufferQueue::enqueue(LogRecord&& r) {
+  std::unique_lock<std::mutex> lk(m_);
+  const EnqueueResult res = admit_unlocked_(lk, r.level());
+  if (res.enqueued) {
+    buffer_[tail_] = std::move(r);
+    commit_push_unlocked_();
+  }
+  return res;
+}
+
+inline EnqueueResult MutexRingBufferQueue::enqueue_copy(const LogRecord& r) {
+  // Per-thread staging record for the contended path. It is grown to fit every
+  // record this thread enqueues (normally during warm-up, outside the lock), so
+  // a later first brush with contention does not allocate.
+  thread_local LogRecord staging;
+  if (!staging.has_capacity_for(r)) {
+    staging = r;
+  }
+
+  std::unique_lock<std::mutex> lk(m_, std::try_to_lock);
+  if (lk.owns_lock()) {
+    // Uncontended: copy straight into the slot, reusing its buffers.
+    const EnqueueResult res = admit_unlocked_(lk, r.level());
+    if (res.enqueued) {
+      buffer_[tail_] = r;
+      commit_push_unlocked_();
     }
-    // DropOldest: evict one then enqueue.
-    pop_oldest_unlocked_();
-    dropped = 1;
+    return res;
   }
 
-  push_unlocked_(std::move(r));
-  cv_not_empty_.notify_one();
-  return EnqueueResult{true, dropped};
+  // Contended: copy before waiting for the lock, so other producers do not
+  // queue behind string copies. Under the lock the staging record is swapped
+  // into the slot and keeps the slot's old buffers for next time.
+  staging = r;
+  lk.lock();
+  const EnqueueResult res = admit_unlocked_(lk, r.level());
+  if (res.enqueued) {
+    buffer_[tail_].swap(staging);
+    commit_push_unlocked_();
+  }
+  return res;
 }
 
 inline std::size_t MutexRingBufferQueue::dequeue_batch(std::vector<LogRecord>& out, std::size_t max) {
   std::unique_lock<std::mutex> lk(m_);
   const std::size_t n = (count_ < max) ? count_ : max;
   for (std::size_t i = 0; i < n; ++i) {
-    // Slots are engaged while counted.
-    out.emplace_back(std::move(*buffer_[head_]));
-    buffer_[head_].reset();
+    out.emplace_back(std::move(buffer_[head_]));
+    head_ = (head_ + 1) % capacity_;
+    --count_;
+  }
+  if (n > 0) {
+    cv_not_full_.notify_all();
+  }
+  return n;
+}
+
+inline std::size_t MutexRingBufferQueue::exchange_batch(std::vector<LogRecord>& batch) {
+  std::unique_lock<std::mutex> lk(m_);
+  const std::size_t n = (count_ < batch.size()) ? count_ : batch.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    batch[i].swap(buffer_[head_]);
     head_ = (head_ + 1) % capacity_;
     --count_;
   }
@@ -115,6 +215,11 @@ inline bool MutexRingBufferQueue::empty() const {
   return count_ == 0;
 }
 
+inline std::size_t MutexRingBufferQueue::size() const {
+  std::lock_guard<std::mutex> lk(m_);
+  return count_;
+}
+
 inline void MutexRingBufferQueue::request_stop() {
   {
     std::lock_guard<std::mutex> lk(m_);
@@ -128,8 +233,18 @@ inline void MutexRingBufferQueue::notify_consumer() {
   cv_not_empty_.notify_all();
 }
 
-inline void MutexRingBufferQueue::wait_for_work(std::unique_lock<std::mutex>& lk) {
+inline bool MutexRingBufferQueue::wait_for_work(std::unique_lock<std::mutex>& lk) {
   cv_not_empty_.wait(lk, [&] { return stop_requested_ || count_ > 0 || flush_kick_; });
+  const bool kicked = flush_kick_;
+  flush_kick_ = false;
+  return kicked;
+}
+
+inline void MutexRingBufferQueue::wait_for_batch(std::unique_lock<std::mutex>& lk,
+                                                 std::size_t min_count,
+                                                 std::chrono::steady_clock::time_point deadline) {
+  cv_not_empty_.wait_until(
+      lk, deadline, [&] { return stop_requested_ || count_ >= min_count || flush_kick_; });
   flush_kick_ = false;
 }
 
@@ -141,14 +256,14 @@ inline void MutexRingBufferQueue::kick_for_flush() {
   cv_not_empty_.notify_all();
 }
 
-inline void MutexRingBufferQueue::push_unlocked_(LogRecord&& r) {
-  buffer_[tail_] = std::move(r);
+inline void MutexRingBufferQueue::commit_push_unlocked_() {
   tail_ = (tail_ + 1) % capacity_;
   ++count_;
+  cv_not_empty_.notify_one();
 }
 
 inline void MutexRingBufferQueue::pop_oldest_unlocked_() {
-  buffer_[head_].reset();
+  // The evicted slot keeps its buffers for the next push.
   head_ = (head_ + 1) % capacity_;
   --count_;
 }
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace sim_logger::detail {
+
+/**
+ * @file name_glob.hpp
+ * @brief Glob matching for dotted logger names.
+ *
+ * @details
+ * Grammar (v1):
+ * - '*' matches any run of characters, including '.' (so "*.sensors" matches
+ *   both "vehicle1.sensors" and "a.b.sensors").
+ * - '?' matches exactly one character.
+ * - All other characters match themselves (case-sensitive).
+ *
+ * The whole name must match; there is no implicit prefix matching.
+ */
+
+/**
+ * @brief Return true if name matches pattern in full.
+ */
+inline bool glob_match(std::string_view pattern, std::string_view name) noexcept {
+  std::size_t p = 0;
+  std::size_t n = 0;
+  std::size_t star_p = std::string_view::npos;
+  std::size_t star_n = 0;
+
+  while (n < name.size()) {
+    if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) {
+      ++p;
+      ++n;
+    } else if (p < pattern.size() && pattern[p] == '*') {
+      star_p = p++;
+      star_n = n;
+    } else if (star_p != std::string_view::npos) {
+      // Backtrack: let the last '*' absorb one more character.
+      p = star_p + 1;
+      n = ++star_n;
+    } else {
+      return false;
+    }
+  }
+
+  while (p < pattern.size() && pattern[p] == '*') {
+    ++p;
+  }
+  return p == pattern.size();
+}
+
+/**
+ * @brief Return the literal prefix of pattern (everything before the first wildcard).
+ */
+inline std::string_view glob_literal_prefix(std::string_view pattern) noexcept {
+  const std::size_t pos = pattern.find_first_of("*?");
+  return (pos == std::string_view::npos) ? pattern : pattern.substr(0, pos);
+}
+
+/**
+ * @brief Return true if pattern contains no wildcards.
+ */
+inline bool glob_is_literal(std::string_view pattern) noexcept {
+  return pattern.find_first_of("*?") == std::string_view::npos;
+}
+
+}  // namespace sim_logger::detail
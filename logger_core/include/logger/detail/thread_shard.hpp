@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+
+namespace sim_logger::detail {
+
+/**
+ * @file thread_shard.hpp
+ * @brief Per-thread shard index shared by the sharded counters.
+ *
+ * @details
+ * Threads are numbered round-robin on first use, so up to kThreadShards
+ * concurrently counting threads each get their own shard (and cache line).
+ */
+
+constexpr std::size_t kThreadShards = 16;
+
+/**
+ * @brief Hand out the next shard index (called once per thread).
+ */
+std::size_t assign_thread_shard() noexcept;
+
+/**
+ * @brief Shard used by the calling thread, in [0, kThreadShards).
+ */
+inline std::size_t thread_shard() noexcept {
+  thread_local const std::size_t shard = assign_thread_shard();
+  return shard;
+}
+
+}  // namespace sim_logger::detail
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "logger/sink.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace sim_logger {
+
+/**
+ * @brief Options for FailoverSink.
+ */
+struct FailoverOptions {
+  /**
+   * @brief A primary write (or flush) taking longer than this counts as a bad write.
+   */
+  std::chrono::microseconds max_write_latency = std::chrono::milliseconds(100);
+
+  /**
+   * @brief Consecutive bad primary writes (errors or slow writes) that trigger failover.
+   */
+  std::uint32_t max_consecutive_failures = 3;
+
+  /**
+   * @brief While on the secondary, how often a record is used to probe the primary.
+   */
+  std::chrono::milliseconds probe_interval = std::chrono::seconds(5);
+
+  /**
+   * @brief Value of the `sink` label on this sink's metrics (see metrics.hpp).
+   *
+   * Empty picks "failover-<n>", numbered in construction order.
+   */
+  std::string metrics_name;
+};
+
+/**
+ * @file failover_sink.hpp
+ * @brief Sink that switches from a primary to a secondary sink when the primary misbehaves.
+ *
+ * @details
+ * Health tracking (primary active):
+ * - Each primary write is timed. A write that throws or exceeds max_write_latency
+ *   is a bad write; max_consecutive_failures in a row switch to the secondary.
+ * - A record whose primary write threw is re-written to the secondary, so it is
+ *   not lost. Slow writes succeeded and are not duplicated.
+ * - Watchdog: if another thread's primary write has been in flight for longer than
+ *   max_write_latency (e.g. a hung NFS write), the caller fails over immediately
+ *   instead of queueing behind it. Each in-flight primary call holds a slot with
+ *   its start time and the watchdog checks the oldest, so a steady stream of
+ *   fast overlapping writes never looks hung. Beyond kWatchdogSlots concurrent
+ *   calls the extra ones are untracked (they are still timed when they return).
+ *
+ * Recovery (secondary active):
+ * - At most once per probe_interval, one record is written to the primary instead
+ *   of the secondary. If that write succeeds within max_write_latency the sink
+ *   switches back; otherwise the record also goes to the secondary if needed.
+ *
+ * Switch events and failure counts are exposed as counters and published to
+ * MetricsRegistry::instance() (sim_logger_failover_* with a `sink` label).
+ *
+ * Failure behavior:
+ * - Exceptions from either sink are swallowed and counted; write() and flush()
+ *   do not throw.
+ */
+class FailoverSink final : public ISink {
+ public:
+  /**
+   * @throws std::invalid_argument if primary or secondary is null.
+   */
+  FailoverSink(std::shared_ptr<ISink> primary,
+               std::shared_ptr<ISink> secondary,
+               FailoverOptions options = {});
+
+  ~FailoverSink() override;
+
+  FailoverSink(const FailoverSink&) = delete;
+  FailoverSink& operator=(const FailoverSink&) = delete;
+
+  void write(const LogRecord& record) override;
+
+  /**
+   * @brief Flush the currently active sink.
+   */
+  void flush() override;
+
+  /**
+   * @brief Accept records that this sink and the currently active target accept.
+   */
+  bool should_log(const LogRecord& record) const noexcept override;
+
+  /**
+   * @brief True while records are being written to the secondary.
+   */
+  bool on_secondary() const noexcept { return on_secondary_.load(std::memory_order_acquire); }
+
+  /// Number of primary -> secondary switches.
+  std::uint64_t failovers_count() const noexcept {
+    return failovers_count_.load(std::memory_order_relaxed);
+  }
+
+  /// Number of secondary -> primary switches.
+  std::uint64_t failbacks_count() const noexcept {
+    return failbacks_count_.load(std::memory_order_relaxed);
+  }
+
+  /// Number of primary writes/flushes that threw.
+  std::uint64_t primary_errors_count() const noexcept {
+    return primary_errors_count_.load(std::memory_order_relaxed);
+  }
+
+  /// Number of primary writes/flushes that exceeded max_write_latency.
+  std::uint64_t primary_slow_writes_count() const noexcept {
+    return primary_slow_writes_count_.load(std::memory_order_relaxed);
+  }
+
+  /// The `sink` label used for this sink's metrics.
+  const std::string& metrics_name() const noexcept { return options_.metrics_name; }
+
+  /// Number of secondary writes/flushes that threw.
+  std::uint64_t secondary_failures_count() const noexcept {
+    return secondary_failures_count_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  enum class Outcome { Ok, Slow, Error };
+
+  static constexpr std::size_t kWatchdogSlots = 16;
+
+  static std::int64_t now_ns_() noexcept;
+
+  /// Run op against the primary, timing it and tracking in-flight state.
+  template <typename Op>
+  Outcome timed_primary_(Op&& op) noexcept;
+
+  bool primary_hung_(std::int64_t now) const noexcept;
+  void note_bad_primary_(Outcome outcome) noexcept;
+  void fail_over_() noexcept;
+  void write_secondary_(const LogRecord& record) noexcept;
+
+  std::shared_ptr<ISink> primary_;
+  std::shared_ptr<ISink> secondary_;
+  FailoverOptions options_;
+
+  std::atomic<bool> on_secondary_{false};
+  std::atomic<std::uint32_t> consecutive_bad_{0};
+  std::atomic<std::int64_t> next_probe_ns_{0};
+
+  /// Watchdog state: start time of each tracked in-flight primary call (0 = free slot).
+  std::array<std::atomic<std::int64_t>, kWatchdogSlots> primary_inflight_since_ns_{};
+
+  std::atomic<std::uint64_t> failovers_count_{0};
+  std::atomic<std::uint64_t> failbacks_count_{0};
+  std::atomic<std::uint64_t> primary_errors_count_{0};
+  std::atomic<std::uint64_t> primary_slow_writes_count_{0};
+  std::atomic<std::uint64_t> secondary_failures_count_{0};
+
+  std::uint64_t metrics_collector_id_ = 0;
+};
+
+}  // namespace sim_logger
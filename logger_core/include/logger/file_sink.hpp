@@ -35,6 +35,9 @@ class FileSink : public ISink {
   void write(const LogRecord& record) override;
   void flush() override;
 
+  const PatternFormatter* formatter() const noexcept override { return &formatter_; }
+  void write_formatted(const LogRecord& record, std::string_view line) override;
+
   const std::string& path() const noexcept { return path_; }
   bool durable_flush() const noexcept { return durable_flush_; }
 
@@ -66,6 +69,8 @@ class FileSink : public ISink {
   std::FILE* file_{nullptr};
   mutable std::mutex mu_;
   std::atomic<std::uint64_t> bytes_written_{0};
+  /// Publishes bytes_written() in MetricsRegistry::instance().
+  std::uint64_t metrics_collector_id_ = 0;
 
   void open_or_throw();
   void close_noexcept() noexcept;
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "logger/level.hpp"
+#include "logger/sink.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace sim_logger {
+
+/**
+ * @brief Options for FlightRecorderSink.
+ */
+struct FlightRecorderOptions {
+  /**
+   * @brief Number of most recent records retained in the ring.
+   */
+  std::size_t capacity = 1024;
+
+  /**
+   * @brief Records at or above this level trigger a dump.
+   */
+  Level trigger_level = Level::Error;
+
+  /**
+   * @brief Value of the `sink` label on this sink's metrics.
+   *
+   * Empty picks "flight-recorder-<n>", numbered in construction order.
+   */
+  std::string metrics_name;
+};
+
+/**
+ * @file flight_recorder_sink.hpp
+ * @brief In-memory ring of recent records, dumped to a target sink on demand or on error.
+ *
+ * @details
+ * During normal operation write() only stores the record in a preallocated ring
+ * (the oldest record is overwritten when full) and nothing reaches the target.
+ * When a record at or above trigger_level arrives, or dump() is called, the ring
+ * is written to the target oldest-first, the target is flushed, and the ring is
+ * cleared. The triggering record is included as the last record of the dump.
+ *
+ * Typical use: attach alongside the production file sink on a DEBUG logger so
+ * full-verbosity context is written only around failures.
+ *
+ * Dumps, target failures and the number of retained records are published in
+ * MetricsRegistry::instance().
+ *
+ * Thread-safety:
+ * - All operations are serialized by an internal mutex. A dump holds the mutex
+ *   while writing to the target so concurrent records are not lost or reordered;
+ *   dumps are expected to be rare.
+ */
+class FlightRecorderSink final : public ISink {
+ public:
+  /**
+   * @param target Sink that receives dumps (must be non-null).
+   * @param options Ring capacity and trigger level.
+   *
+   * @throws std::invalid_argument if target is null.
+   */
+  FlightRecorderSink(std::shared_ptr<ISink> target, FlightRecorderOptions options = {});
+  ~FlightRecorderSink() override;
+
+  FlightRecorderSink(const FlightRecorderSink&) = delete;
+  FlightRecorderSink& operator=(const FlightRecorderSink&) = delete;
+
+  void write(const LogRecord& record) override;
+
+  /**
+   * @brief No-op: the ring is only written out by dump().
+   */
+  void flush() override;
+
+  /**
+   * @brief Write all retained records to the target, flush it, and clear the ring.
+   *
+   * Exceptions from the target are swallowed and counted.
+   */
+  void dump();
+
+  /**
+   * @brief Number of records currently retained.
+   */
+  std::size_t size() const;
+
+  std::size_t capacity() const noexcept { return options_.capacity; }
+
+  /**
+   * @brief Number of dumps performed (triggered or explicit).
+   */
+  std::uint64_t dumps_count() const noexcept {
+    return dumps_count_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Total number of times the target sink threw during a dump.
+   */
+  std::uint64_t sink_failures_count() const noexcept {
+    return sink_failures_count_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief The `sink` label used for this sink's metrics.
+   */
+  const std::string& metrics_name() const noexcept { return options_.metrics_name; }
+
+ private:
+  void dump_locked_() noexcept;
+
+  std::shared_ptr<ISink> target_;
+  FlightRecorderOptions options_;
+
+  mutable std::mutex mutex_;
+  std::vector<std::optional<LogRecord>> ring_;
+  std::size_t head_ = 0;
+  std::size_t count_ = 0;
+
+  std::atomic<std::uint64_t> dumps_count_{0};
+  std::atomic<std::uint64_t> sink_failures_count_{0};
+  std::uint64_t metrics_collector_id_ = 0;
+};
+
+}  // namespace sim_logger
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <string_view>
@@ -25,6 +26,9 @@ enum class Level : uint8_t {
   Fatal = 4
 };
 
+/// Number of Level values (for per-level arrays indexed by the Level value).
+constexpr std::size_t kLevelCount = 5;
+
 /**
  * @brief Return canonical uppercase name.
  */
@@ -1,118 +1,257 @@
 // logger_core/include/logger/log_macros.hpp
 #pragma once
 
+#include "logger/backtrace.hpp"
+#include "logger/call_site.hpp"
 #include "logger/global_time.hpp"
 #include "logger/log_record.hpp"
 #include "logger/logger.hpp"
+#include "logger/static_logger.hpp"
 
+#include <chrono>
 #include <cstdarg>
 #include <cstdio>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <utility>
 #include <vector>
 
 namespace sim_logger::detail {
 
-// Accept Logger& or std::shared_ptr<Logger>.
+// Accept Logger&, std::shared_ptr<Logger> or StaticLogger.
 inline Logger& as_logger(Logger& logger) noexcept { return logger; }
 
+inline Logger& as_logger(StaticLogger& logger) { return logger.get(); }
+
 inline Logger& as_logger(const std::shared_ptr<Logger>& logger) noexcept {
   // Hard failure on null is intentional; macro call sites stay simple.
   return *logger;
 }
 
-inline std::string vformat_printf(const char* fmt, std::va_list ap) {
+// Format into @p out, reusing its capacity. Formats straight into the buffer
+// when it already has room, so steady-state calls make a single pass (the
+// first attempt is capped so one huge message does not make every later call
+// clear a huge buffer).
+inline void vformat_printf_to(std::string& out, const char* fmt, std::va_list ap) {
+  constexpr size_t kMaxFirstPass = 1024;
+  out.clear();
   if (fmt == nullptr) {
-    return {};
+    return;
   }
 
   std::va_list ap_copy;
   va_copy(ap_copy, ap);
-  const int needed = std::vsnprintf(nullptr, 0, fmt, ap_copy);
+  out.resize(out.capacity() < kMaxFirstPass ? out.capacity() : kMaxFirstPass);
+  const int needed = std::vsnprintf(out.data(), out.size() + 1U, fmt, ap_copy);
   va_end(ap_copy);
 
   if (needed <= 0) {
-    return {};
+    out.clear();
+    return;
+  }
+  const auto n = static_cast<size_t>(needed);
+  if (n > out.size()) {
+    out.resize(n);
+    std::vsnprintf(out.data(), out.size() + 1U, fmt, ap);
+  } else {
+    out.resize(n);
   }
+}
 
+inline std::string vformat_printf(const char* fmt, std::va_list ap) {
   std::string out;
-  out.resize(static_cast<size_t>(needed));
-  std::vsnprintf(out.data(), out.size() + 1U, fmt, ap);
+  vformat_printf_to(out, fmt, ap);
   return out;
 }
 
+// Per-thread record and format buffer reused by the macros, so a steady-state
+// enabled call does not allocate once the buffers have grown. `busy` covers
+// re-entry (a sink or time source logging from inside a log call); the nested
+// call falls back to a fresh record.
+struct ScratchRecord {
+  LogRecord record;
+  std::string text;
+  bool busy = false;
+};
+
+inline ScratchRecord& scratch_record() noexcept {
+  thread_local ScratchRecord scratch;
+  return scratch;
+}
+
+// Build records only when they can go somewhere: the site is forced on, the
+// logger's level passes, or backtrace capture wants filtered records too.
+inline bool site_wants_record(CallSiteState state, Logger& logger, Level level) noexcept {
+  return state == CallSiteState::Enabled || level >= logger.effective_level() ||
+         backtrace_active();
+}
+
+// Times the rest of an enabled call and adds it to the site's profile when
+// call-site profiling is on; otherwise costs one relaxed load.
+class SiteProfileScope {
+ public:
+  explicit SiteProfileScope(CallSite& site) noexcept
+      : site_(call_site_profiling() ? &site : nullptr) {
+    if (site_ != nullptr) {
+      start_ = std::chrono::steady_clock::now();
+    }
+  }
+
+  SiteProfileScope(const SiteProfileScope&) = delete;
+  SiteProfileScope& operator=(const SiteProfileScope&) = delete;
+
+  ~SiteProfileScope() {
+    if (site_ != nullptr) {
+      const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start_);
+      site_->add_profile(bytes_, static_cast<std::uint64_t>(ns.count()));
+    }
+  }
+
+  void set_bytes(std::size_t bytes) noexcept { bytes_ = bytes; }
+
+ private:
+  CallSite* site_;
+  std::chrono::steady_clock::time_point start_{};
+  std::size_t bytes_ = 0;
+};
+
+inline void dispatch_at_site(CallSiteState state, Logger& logger, const LogRecord& record) {
+  if (state == CallSiteState::Enabled) {
+    logger.force_log(record);
+  } else {
+    logger.log(record);
+  }
+}
+
+inline void log_at_site(CallSite& site,
+                        CallSiteState state,
+                        Logger& logger,
+                        const char* function,
+                        std::string_view message) {
+  ITimeSource& ts = global_time_source_ref();
+  const char* file = site.file() ? site.file() : "";
+  if (function == nullptr) {
+    function = "";
+  }
+
+  ScratchRecord& scratch = scratch_record();
+  if (scratch.busy) {
+    const LogRecord record(site.level(),
+                           ts.sim_time(),
+                           ts.mission_elapsed(),
+                           ts.wall_time_ns(),
+                           std::this_thread::get_id(),
+                           file,
+                           site.line(),
+                           function,
+                           logger.name(),
+                           std::vector<Tag>{},
+                           std::string(message));
+    dispatch_at_site(state, logger, record);
+    return;
+  }
+
+  struct Release {
+    bool& busy;
+    ~Release() { busy = false; }
+  } release{scratch.busy};
+  scratch.busy = true;
+
+  scratch.record.assign(site.level(),
+                        ts.sim_time(),
+                        ts.mission_elapsed(),
+                        ts.wall_time_ns(),
+                        std::this_thread::get_id(),
+                        file,
+                        site.line(),
+                        function,
+                        logger.name(),
+                        message);
+  dispatch_at_site(state, logger, scratch.record);
+}
+
 template <typename LoggerLike>
-inline void log_string(LoggerLike&& logger_like,
-                       Level level,
-                       const char* file,
-                       unsigned line,
+inline void log_string(CallSite& site,
+                       CallSiteState state,
+                       LoggerLike&& logger_like,
                        const char* function,
-                       std::string message) {
+                       std::string_view message) {
   Logger& logger = as_logger(std::forward<LoggerLike>(logger_like));
-  ITimeSource& ts = global_time_source_ref();
-
-  LogRecord record(level,
-                   ts.sim_time(),
-                   ts.mission_elapsed(),
-                   ts.wall_time_ns(),
-                   std::this_thread::get_id(),
-                   file ? file : "",
-                   line,
-                   function ? function : "",
-                   logger.name(),
-                   std::vector<Tag>{},
-                   std::move(message));
-
-  logger.log(record);
+  if (!site_wants_record(state, logger, site.level())) {
+    logger.count_filtered(site.level());
+    return;
+  }
+  SiteProfileScope profile(site);
+  profile.set_bytes(message.size());
+  log_at_site(site, state, logger, function, message);
 }
 
 template <typename LoggerLike>
-inline void log_printf(LoggerLike&& logger_like,
-                       Level level,
-                       const char* file,
-                       unsigned line,
+inline void log_printf(CallSite& site,
+                       CallSiteState state,
+                       LoggerLike&& logger_like,
                        const char* function,
                        const char* fmt,
                        ...) {
+  Logger& logger = as_logger(std::forward<LoggerLike>(logger_like));
+  if (!site_wants_record(state, logger, site.level())) {
+    logger.count_filtered(site.level());
+    return;  // skip formatting entirely
+  }
+  SiteProfileScope profile(site);
+
+  ScratchRecord& scratch = scratch_record();
+  std::string nested;
+  std::string& text = scratch.busy ? nested : scratch.text;
+
   std::va_list ap;
   va_start(ap, fmt);
-  std::string msg = vformat_printf(fmt, ap);
+  vformat_printf_to(text, fmt, ap);
   va_end(ap);
 
-  log_string(std::forward<LoggerLike>(logger_like),
-             level,
-             file,
-             line,
-             function,
-             std::move(msg));
+  profile.set_bytes(text.size());
+  log_at_site(site, state, logger, function, text);
 }
 
 }  // namespace sim_logger::detail
 
+// -----------------------------------------------------------------------------
+// Call-site wrapper: every expansion owns a constant-initialized CallSite (see
+// call_site.hpp). The site registers (picking up rules) before the arguments
+// are evaluated, so a disabled site costs one load and evaluates neither the
+// logger nor the message arguments, including on its first run.
+// -----------------------------------------------------------------------------
+#define SIM_LOGGER_AT_SITE_(level, helper, logger, ...)                                       \
+  do {                                                                                        \
+    static ::sim_logger::CallSite sim_logger_site_(__FILE__, static_cast<unsigned>(__LINE__), \
+                                                   (level));                                  \
+    const ::sim_logger::CallSiteState sim_logger_state_ = sim_logger_site_.enter(__func__);  \
+    if (sim_logger_state_ != ::sim_logger::CallSiteState::Disabled) {                         \
+      ::sim_logger::detail::helper(sim_logger_site_, sim_logger_state_, logger, __func__,     \
+                                   __VA_ARGS__);                                              \
+    }                                                                                         \
+  } while (false)
+
 // -----------------------------------------------------------------------------
 // Public macros (message-only)
 // -----------------------------------------------------------------------------
-#define LOG_DEBUG(logger, msg)                                                     \
-  ::sim_logger::detail::log_string((logger), ::sim_logger::Level::Debug, __FILE__, \
-                                  static_cast<unsigned>(__LINE__), __func__, (msg))
+#define LOG_DEBUG(logger, msg) \
+  SIM_LOGGER_AT_SITE_(::sim_logger::Level::Debug, log_string, (logger), (msg))
 
-#define LOG_INFO(logger, msg)                                                      \
-  ::sim_logger::detail::log_string((logger), ::sim_logger::Level::Info, __FILE__,  \
-                                  static_cast<unsigned>(__LINE__), __func__, (msg))
+#define LOG_INFO(logger, msg) \
+  SIM_LOGGER_AT_SITE_(::sim_logger::Level::Info, log_string, (logger), (msg))
 
-#define LOG_WARN(logger, msg)                                                      \
-  ::sim_logger::detail::log_string((logger), ::sim_logger::Level::Warn, __FILE__,  \
-                                  static_cast<unsigned>(__LINE__), __func__, (msg))
+#define LOG_WARN(logger, msg) \
+  SIM_LOGGER_AT_SITE_(::sim_logger::Level::Warn, log_string, (logger), (msg))
 
-#define LOG_ERROR(logger, msg)                                                     \
-  ::sim_logger::detail::log_string((logger), ::sim_logger::Level::Error, __FILE__, \
-                                  static_cast<unsigned>(__LINE__), __func__, (msg))
+#define LOG_ERROR(logger, msg) \
+  SIM_LOGGER_AT_SITE_(::sim_logger::Level::Error, log_string, (logger), (msg))
 
-#define LOG_FATAL(logger, msg)                                                     \
-  ::sim_logger::detail::log_string((logger), ::sim_logger::Level::Fatal, __FILE__, \
-                                  static_cast<unsigned>(__LINE__), __func__, (msg))
+#define LOG_FATAL(logger, msg) \
+  SIM_LOGGER_AT_SITE_(::sim_logger::Level::Fatal, log_string, (logger), (msg))
 
 // -----------------------------------------------------------------------------
 // C++17-safe printf-style formatting macros that allow zero varargs:
@@ -135,43 +274,28 @@ inline void log_printf(LoggerLike&& logger_like,
 
 // ---- Implementations: 2-arg and 3+-arg ----
 // (logger, fmt)
-#define SIM_LOGGER_DEBUGF_2(logger, fmt)                                            \
-  ::sim_logger::detail::log_printf((logger), ::sim_logger::Level::Debug, __FILE__,  \
-                                  static_cast<unsigned>(__LINE__), __func__, (fmt))
-#define SIM_LOGGER_INFOF_2(logger, fmt)                                             \
-  ::sim_logger::detail::log_printf((logger), ::sim_logger::Level::Info, __FILE__,   \
-                                  static_cast<unsigned>(__LINE__), __func__, (fmt))
-#define SIM_LOGGER_WARNF_2(logger, fmt)                                             \
-  ::sim_logger::detail::log_printf((logger), ::sim_logger::Level::Warn, __FILE__,   \
-                                  static_cast<unsigned>(__LINE__), __func__, (fmt))
-#define SIM_LOGGER_ERRORF_2(logger, fmt)                                            \
-  ::sim_logger::detail::log_printf((logger), ::sim_logger::Level::Error, __FILE__,  \
-                                  static_cast<unsigned>(__LINE__), __func__, (fmt))
-#define SIM_LOGGER_FATALF_2(logger, fmt)                                            \
-  ::sim_logger::detail::log_printf((logger), ::sim_logger::Level::Fatal, __FILE__,  \
-                                  static_cast<unsigned>(__LINE__), __func__, (fmt))
+#define SIM_LOGGER_DEBUGF_2(logger, fmt) \
+  SIM_LOGGER_AT_SITE_(::sim_logger::Level::Debug, log_printf, (logger), (fmt))
+#define SIM_LOGGER_INFOF_2(logger, fmt) \
+  SIM_LOGGER_AT_SITE_(::sim_logger::Level::Info, log_printf, (logger), (fmt))
+#define SIM_LOGGER_WARNF_2(logger, fmt) \
+  SIM_LOGGER_AT_SITE_(::sim_logger::Level::Warn, log_printf, (logger), (fmt))
+#define SIM_LOGGER_ERRORF_2(logger, fmt) \
+  SIM_LOGGER_AT_SITE_(::sim_logger::Level::Error, log_printf, (logger), (fmt))
+#define SIM_LOGGER_FATALF_2(logger, fmt) \
+  SIM_LOGGER_AT_SITE_(::sim_logger::Level::Fatal, log_printf, (logger), (fmt))
 
 // (logger, fmt, ...)
-#define SIM_LOGGER_DEBUGF_3(logger, fmt, ...)                                       \
-  ::sim_logger::detail::log_printf((logger), ::sim_logger::Level::Debug, __FILE__,  \
-                                  static_cast<unsigned>(__LINE__), __func__, (fmt), \
-                                  __VA_ARGS__)
-#define SIM_LOGGER_INFOF_3(logger, fmt, ...)                                        \
-  ::sim_logger::detail::log_printf((logger), ::sim_logger::Level::Info, __FILE__,   \
-                                  static_cast<unsigned>(__LINE__), __func__, (fmt), \
-                                  __VA_ARGS__)
-#define SIM_LOGGER_WARNF_3(logger, fmt, ...)                                        \
-  ::sim_logger::detail::log_printf((logger), ::sim_logger::Level::Warn, __FILE__,   \
-                                  static_cast<unsigned>(__LINE__), __func__, (fmt), \
-                                  __VA_ARGS__)
-#define SIM_LOGGER_ERRORF_3(logger, fmt, ...)                                       \
-  ::sim_logger::detail::log_printf((logger), ::sim_logger::Level::Error, __FILE__,  \
-                                  static_cast<unsigned>(__LINE__), __func__, (fmt), \
-                                  __VA_ARGS__)
-#define SIM_LOGGER_FATALF_3(logger, fmt, ...)                                       \
-  ::sim_logger::detail::log_printf((logger), ::sim_logger::Level::Fatal, __FILE__,  \
-                                  static_cast<unsigned>(__LINE__), __func__, (fmt), \
-                                  __VA_ARGS__)
+#define SIM_LOGGER_DEBUGF_3(logger, fmt, ...) \
+  SIM_LOGGER_AT_SITE_(::sim_logger::Level::Debug, log_printf, (logger), (fmt), __VA_ARGS__)
+#define SIM_LOGGER_INFOF_3(logger, fmt, ...) \
+  SIM_LOGGER_AT_SITE_(::sim_logger::Level::Info, log_printf, (logger), (fmt), __VA_ARGS__)
+#define SIM_LOGGER_WARNF_3(logger, fmt, ...) \
+  SIM_LOGGER_AT_SITE_(::sim_logger::Level::Warn, log_printf, (logger), (fmt), __VA_ARGS__)
+#define SIM_LOGGER_ERRORF_3(logger, fmt, ...) \
+  SIM_LOGGER_AT_SITE_(::sim_logger::Level::Error, log_printf, (logger), (fmt), __VA_ARGS__)
+#define SIM_LOGGER_FATALF_3(logger, fmt, ...) \
+  SIM_LOGGER_AT_SITE_(::sim_logger::Level::Fatal, log_printf, (logger), (fmt), __VA_ARGS__)
 
 // ---- Dispatch tables per level ----
 // 2 args -> _2, 3..10 args -> _3
@@ -2,6 +2,7 @@
 
 #include "logger/level.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <string_view>
@@ -34,6 +35,11 @@ struct Tag {
  */
 class LogRecord {
  public:
+  /**
+   * @brief Empty record (Info, zero times); used as reusable storage by queues and producers.
+   */
+  LogRecord() = default;
+
   LogRecord(Level level,
             double sim_time,
             double met,
@@ -57,6 +63,74 @@ class LogRecord {
         tags_(std::move(tags)),
         message_(std::move(message)) {}
 
+  /**
+   * @brief Overwrite every field in place, reusing this record's string capacity.
+   *
+   * Lets a producer keep one record per thread and refill it without touching the
+   * heap once its buffers have grown. Tags are cleared.
+   */
+  void assign(Level level,
+              double sim_time,
+              double met,
+              int64_t wall_time_ns,
+              std::thread::id thread_id,
+              std::string_view file,
+              uint32_t line,
+              std::string_view function,
+              std::string_view logger_name,
+              std::string_view message) {
+    level_ = level;
+    sim_time_ = sim_time;
+    met_ = met;
+    wall_time_ns_ = wall_time_ns;
+    thread_id_ = thread_id;
+    file_.assign(file);
+    line_ = line;
+    function_.assign(function);
+    logger_name_.assign(logger_name);
+    tags_.clear();
+    message_.assign(message);
+  }
+
+  /**
+   * @brief Exchange every field with @p other, including string capacity.
+   *
+   * Cheaper than std::swap's three moves; queues use it to trade a filled
+   * record for a slot's spare buffers.
+   */
+  void swap(LogRecord& other) noexcept {
+    using std::swap;
+    swap(level_, other.level_);
+    swap(sim_time_, other.sim_time_);
+    swap(met_, other.met_);
+    swap(wall_time_ns_, other.wall_time_ns_);
+    swap(thread_id_, other.thread_id_);
+    file_.swap(other.file_);
+    swap(line_, other.line_);
+    function_.swap(other.function_);
+    logger_name_.swap(other.logger_name_);
+    tags_.swap(other.tags_);
+    message_.swap(other.message_);
+  }
+
+  /**
+   * @brief True if copy-assigning @p other into this record would not grow any buffer.
+   */
+  bool has_capacity_for(const LogRecord& other) const noexcept {
+    if (file_.capacity() < other.file_.size() || function_.capacity() < other.function_.size() ||
+        logger_name_.capacity() < other.logger_name_.size() ||
+        message_.capacity() < other.message_.size() || tags_.size() < other.tags_.size()) {
+      return false;
+    }
+    for (std::size_t i = 0; i < other.tags_.size(); ++i) {
+      if (tags_[i].key.capacity() < other.tags_[i].key.size() ||
+          tags_[i].value.capacity() < other.tags_[i].value.size()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   Level level() const noexcept { return level_; }
 
   double sim_time() const noexcept { return sim_time_; }
@@ -80,14 +154,14 @@ class LogRecord {
   std::string_view message() const noexcept { return message_; }
 
  private:
-  Level level_;
-  double sim_time_;
-  double met_;
-  int64_t wall_time_ns_;
+  Level level_{Level::Info};
+  double sim_time_{0.0};
+  double met_{0.0};
+  int64_t wall_time_ns_{0};
   std::thread::id thread_id_;
 
   std::string file_;
-  uint32_t line_;
+  uint32_t line_{0};
   std::string function_;
   std::string logger_name_;
   std::vector<Tag> tags_;
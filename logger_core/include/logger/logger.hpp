@@ -1,12 +1,16 @@
 #pragma once
 
+#include "logger/detail/thread_shard.hpp"
 #include "logger/level.hpp"
 #include "logger/log_record.hpp"
 #include "logger/sink.hpp"
 
+#include <array>
 #include <atomic>
+#include <cstdint>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -14,6 +18,31 @@ namespace sim_logger {
 
 class LoggerRegistry;
 
+namespace detail {
+struct SharedLevelSlot;
+}  // namespace detail
+
+/**
+ * @brief Per-level record counts for one logger (or a sum over several).
+ *
+ * Arrays are indexed by the Level value.
+ */
+struct LoggerStats {
+  std::string name;
+  /// Records that passed the logger's level and were offered to its sinks.
+  std::array<std::uint64_t, kLevelCount> emitted{};
+  /// Records below the logger's effective level.
+  std::array<std::uint64_t, kLevelCount> filtered{};
+  /// Message bytes handed to sinks (counted once per sink write).
+  std::uint64_t bytes = 0;
+
+  std::uint64_t emitted_total() const noexcept;
+  std::uint64_t filtered_total() const noexcept;
+
+  /// Add another logger's counts (name is left unchanged).
+  LoggerStats& operator+=(const LoggerStats& other) noexcept;
+};
+
 /**
  * @brief A hierarchical logger that emits LogRecord instances to one or more sinks.
  *
@@ -27,7 +56,9 @@ class LoggerRegistry;
  *
  * Failure behavior:
  * - Sink exceptions are swallowed; failures are counted and logging continues.
- * - If a record is filtered out by level, it is not emitted to sinks.
+ * - If a record is filtered out by level, it is not emitted to sinks (it is only
+ *   retained in the calling thread's backtrace ring when backtrace is enabled;
+ *   see backtrace.hpp).
  */
 class Logger final {
  public:
@@ -59,13 +90,28 @@ class Logger final {
    * @brief Clears the level override so the logger may inherit from its parent.
    *
    * After clearing, effective_level() returns:
+   * - the registry level rule matching this logger, if any (see
+   *   LoggerRegistry::set_level_rules), otherwise
    * - parent's effective level if a parent exists, otherwise the local default.
    */
   void clear_level_override() noexcept;
 
+  /**
+   * @brief The level set by set_level(), or nullopt if it has not been set or was cleared.
+   */
+  std::optional<Level> level_override() const noexcept;
+
   /**
    * @brief Returns the level used for filtering records on this logger.
    * @return The effective (inherited or overridden) Level.
+   *
+   * Precedence: shared-memory override (see shared_level_table.hpp), then
+   * set_level() override, then matching registry level rule, then parent's
+   * effective level, then the local default (Info).
+   *
+   * The result is cached and re-resolved whenever an input changes (own override,
+   * level rule, or an ancestor's effective level), so this is one or two relaxed
+   * atomic loads.
    */
   Level effective_level() const noexcept;
 
@@ -144,10 +190,21 @@ class Logger final {
    * @brief Emit a log record to the effective sinks if it passes level filtering.
    * @param record Record to emit.
    *
+   * Each sink's should_log() (sink level and filter predicate) is consulted before
+   * its write() is called.
+   *
    * Exceptions thrown by sinks are swallowed and counted in sink_failures_count().
    */
   void log(const LogRecord& record) noexcept;
 
+  /**
+   * @brief Emit a record regardless of this logger's level.
+   *
+   * Used for call sites forced on through set_call_sites() (see call_site.hpp).
+   * Sink levels and filters still apply.
+   */
+  void force_log(const LogRecord& record) noexcept;
+
   /**
    * @brief Returns number of records dropped (typically due to filtering).
    * @return Count of dropped records.
@@ -160,6 +217,25 @@ class Logger final {
    */
   std::uint64_t sink_failures_count() const noexcept;
 
+  /**
+   * @brief Count a record at @p level that was filtered before a LogRecord was built.
+   *
+   * For front ends that check the level themselves (the LOG_* macros and the C
+   * API); log() counts its own filtered records.
+   */
+  void count_filtered(Level level) noexcept {
+    stats_[detail::thread_shard()].filtered[static_cast<std::size_t>(level)].fetch_add(
+        1, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Emitted/filtered records per level and bytes handed to sinks so far.
+   *
+   * Counters are sharded per thread, so counting adds no cache line shared
+   * between logging threads; this sums the shards (not an atomic snapshot).
+   */
+  LoggerStats stats() const;
+
  private:
   /// LoggerRegistry needs internal access to set hierarchical parent relationships.
   friend class LoggerRegistry;
@@ -170,6 +246,36 @@ class Logger final {
    */
   void set_parent(std::shared_ptr<Logger> parent) noexcept;
 
+  /**
+   * @brief Register a child whose cached level depends on this logger (used by LoggerRegistry).
+   */
+  void add_child(const std::shared_ptr<Logger>& child);
+
+  /**
+   * @brief Set or clear the level resolved from registry rules (used by LoggerRegistry).
+   */
+  void set_rule_level(std::optional<Level> level) noexcept;
+
+  /**
+   * @brief Recompute the cached effective level and propagate it to children.
+   */
+  void refresh_effective_level_() noexcept;
+
+  /**
+   * @brief Attach (or with nullptr, detach) this logger's shared-memory slot (used by LoggerRegistry).
+   */
+  void set_shared_slot(detail::SharedLevelSlot* slot) noexcept;
+
+  /**
+   * @brief Write a record that already passed level filtering to the effective sinks.
+   */
+  void emit_(const LogRecord& record);
+
+  /**
+   * @brief Append the effective sinks to @p out (effective_sinks() without the copy).
+   */
+  void append_effective_sinks_(std::vector<std::shared_ptr<ISink>>& out) const;
+
   /// Logger name.
   std::string name_;
 
@@ -182,6 +288,26 @@ class Logger final {
   /// True if this logger's level is explicitly overridden.
   bool level_overridden_{false};
 
+  /// Level from the last matching registry rule, if any.
+  std::optional<Level> rule_level_;
+
+  /// Cached effective level (see effective_level()).
+  std::atomic<Level> effective_level_{Level::Info};
+
+  /// Shared-memory level slot, if a SharedLevelTable is attached to the registry.
+  std::atomic<detail::SharedLevelSlot*> shared_slot_{nullptr};
+
+  /// Per-thread-shard counters behind stats().
+  struct alignas(64) StatsShard {
+    std::array<std::atomic<std::uint64_t>, kLevelCount> emitted{};
+    std::array<std::atomic<std::uint64_t>, kLevelCount> filtered{};
+    std::atomic<std::uint64_t> bytes{0};
+  };
+  std::array<StatsShard, detail::kThreadShards> stats_{};
+
+  /// Children whose cached level inherits from this logger.
+  std::vector<std::weak_ptr<Logger>> children_;
+
   /// Sink list used when sinks are overridden.
   std::vector<std::shared_ptr<ISink>> sinks_;
 
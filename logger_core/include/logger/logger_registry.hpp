@@ -1,13 +1,36 @@
 #pragma once
 
+#include "logger/detail/thread_shard.hpp"
+#include "logger/level.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <vector>
 
 namespace sim_logger {
 
 class Logger;
+struct LoggerStats;
+class SharedLevelTable;
+
+/**
+ * @brief One level rule: loggers whose name matches pattern get level.
+ *
+ * Patterns use the glob grammar of detail/name_glob.hpp ('*' spans dots, '?' is
+ * one character, whole-name match), so "vehicle1.*" is a prefix rule for the
+ * subtree below vehicle1 and "*.sensors" matches every sensors logger.
+ */
+struct LevelRule {
+  std::string pattern;
+  Level level = Level::Info;
+};
 
 /**
  * @brief Global registry for named loggers.
@@ -19,7 +42,25 @@ class Logger;
  *
  * Thread-safety:
  * - get_logger() is safe to call concurrently.
+ * - Lookups of existing loggers take no locks: the registry publishes an
+ *   insert-only open-addressing table of immutable nodes through an atomic
+ *   pointer. Only creation takes mutex_ (and grows/republishes the table).
  * - Returned shared_ptr instances are stable (cached).
+ * - clear() is safe to call concurrently with get_logger(). Lock-free readers
+ *   announce themselves in per-thread-shard counters; replaced tables and
+ *   cleared nodes are retired and freed at the first grace point (every shard
+ *   seen idle after the retirement), or by the destructor.
+ *
+ * Level rules:
+ * - An ordered rule list ("vehicle*.gnc=debug,*.sensors=warn") assigns levels
+ *   by name. The last matching rule wins. Rules are evaluated once per logger
+ *   (on creation and whenever the rule list changes) and folded into the
+ *   logger's cached effective level, so they cost nothing when logging.
+ * - A rule level ranks below an explicit Logger::set_level() and above
+ *   inheritance from the parent.
+ * - The initial rules are read from the SIM_LOGGER_LEVELS environment variable
+ *   when the registry is first used (an invalid value is ignored). Rules survive
+ *   clear().
  */
 class LoggerRegistry final {
  public:
@@ -28,6 +69,11 @@ class LoggerRegistry final {
    */
   static LoggerRegistry& instance();
 
+  ~LoggerRegistry();
+
+  LoggerRegistry(const LoggerRegistry&) = delete;
+  LoggerRegistry& operator=(const LoggerRegistry&) = delete;
+
   /**
    * @brief Get (or create) a logger with the specified name.
    * @param name Logger name. "root" is treated as the root logger.
@@ -36,30 +82,154 @@ class LoggerRegistry final {
    * If the logger does not exist, it is created and inserted into the registry.
    * Parent loggers are created as needed.
    */
-  std::shared_ptr<Logger> get_logger(const std::string& name);
+  std::shared_ptr<Logger> get_logger(std::string_view name);
+
+  /**
+   * @brief Snapshot of all registered loggers, in creation order (parents first).
+   */
+  std::vector<std::shared_ptr<Logger>> loggers() const;
+
+  /**
+   * @brief Stats of every logger whose name matches @p pattern, in creation order.
+   *
+   * @p pattern uses the level-rule glob syntax (detail/name_glob.hpp), e.g.
+   * "vehicle1.*" for everything below vehicle1 or "*" for all loggers.
+   */
+  std::vector<LoggerStats> logger_stats(std::string_view pattern = "*") const;
+
+  /**
+   * @brief Sum of logger_stats(@p pattern); the result's name is the pattern.
+   */
+  LoggerStats total_logger_stats(std::string_view pattern = "*") const;
 
   /**
    * @brief Remove all loggers from the registry.
    *
-   * Useful for tests to ensure clean state between cases.
+   * Useful for tests to ensure clean state between cases. Loggers still being
+   * returned to concurrent get_logger() callers are released once those calls
+   * have finished (see the thread-safety notes above).
    */
   void clear();
 
+  /**
+   * @brief Counter bumped by every clear().
+   *
+   * Lets callers that cache Logger pointers (e.g. StaticLogger) detect that the
+   * registry was reset and re-resolve.
+   */
+  std::uint64_t generation() const noexcept { return generation_.load(std::memory_order_acquire); }
+
+  /**
+   * @brief Replace the level rules with those parsed from @p spec.
+   *
+   * Grammar: comma-separated entries "pattern=level"; whitespace around tokens is
+   * ignored, and a bare "level" entry is shorthand for "*=level". An empty spec
+   * removes all rules.
+   *
+   * @throws std::invalid_argument if any entry is malformed (no rule is changed).
+   */
+  void set_level_rules(std::string_view spec);
+
+  /**
+   * @brief Replace the level rules and re-resolve every existing logger.
+   */
+  void set_level_rules(std::vector<LevelRule> rules);
+
+  /**
+   * @brief Remove all level rules.
+   */
+  void clear_level_rules() { set_level_rules(std::vector<LevelRule>{}); }
+
+  /**
+   * @brief Return a copy of the current level rules, in evaluation order.
+   */
+  std::vector<LevelRule> level_rules() const;
+
+  /**
+   * @brief Publish every logger (existing and future) in @p table; nullptr detaches.
+   *
+   * Tables stay mapped for the life of the registry once attached, because
+   * loggers read their slots without synchronization.
+   */
+  void attach_shared_level_table(std::shared_ptr<SharedLevelTable> table);
+
+  /**
+   * @brief Parse a rule spec (see set_level_rules(std::string_view)).
+   *
+   * @throws std::invalid_argument on a malformed entry.
+   */
+  static std::vector<LevelRule> parse_level_rules(std::string_view spec);
+
  private:
-  LoggerRegistry() = default;
+  LoggerRegistry();
+
+  struct Node {
+    std::string name;
+    std::size_t hash;
+    std::shared_ptr<Logger> logger;
+  };
+
+  struct Table {
+    explicit Table(std::size_t capacity);
+
+    std::size_t mask;
+    std::unique_ptr<std::atomic<const Node*>[]> slots;
+  };
 
   /**
    * @brief Compute the parent name for a dot-separated logger name.
    * @param name Child logger name.
    * @return Parent name, or empty string if none.
    */
-  static std::string parent_name_for(const std::string& name);
+  static std::string_view parent_name_for(std::string_view name);
+
+  static const Node* find_in_(const Table& table, std::string_view name, std::size_t hash) noexcept;
+
+  /// Publish @p node (not yet in nodes_) in the current table, growing it if
+  /// needed. Caller holds mutex_.
+  void insert_locked_(const Node* node);
+
+  /// Free retired_nodes_/retired_tables_ if no lock-free reader is active
+  /// (caller holds mutex_, after retiring).
+  void reclaim_retired_locked_() noexcept;
+
+  /// Level from the last rule matching @p name (caller holds mutex_).
+  std::optional<Level> rule_level_for_locked_(std::string_view name) const noexcept;
+
+  /// Serializes creation, growth, clear() and level-rule changes.
+  mutable std::mutex mutex_;
+
+  /// Ordered level rules (guarded by mutex_).
+  std::vector<LevelRule> level_rules_;
+
+  /// Current shared level table (guarded by mutex_); every table ever attached
+  /// is kept in shared_tables_.
+  SharedLevelTable* shared_table_ = nullptr;
+  std::vector<std::shared_ptr<SharedLevelTable>> shared_tables_;
+
+  /// Published lookup table (read lock-free).
+  std::atomic<Table*> table_{nullptr};
+
+  /// Owned nodes and tables. Tables replaced by growth stay alive because
+  /// readers may still be probing them; clear() retires all of them.
+  std::vector<std::unique_ptr<Node>> nodes_;
+  std::vector<std::unique_ptr<Table>> tables_;
+
+  /// Cleared by clear() but possibly still reachable by a reader that loaded
+  /// the old table (guarded by mutex_).
+  std::vector<std::unique_ptr<Node>> retired_nodes_;
+  std::vector<std::unique_ptr<Table>> retired_tables_;
+
+  /// Lock-free readers in flight, per thread shard.
+  struct alignas(64) ReaderShard {
+    std::atomic<std::uint32_t> active{0};
+  };
+  std::array<ReaderShard, detail::kThreadShards> readers_{};
 
-  /// Protects the map of cached loggers.
-  std::mutex mutex_;
+  std::atomic<std::uint64_t> generation_{0};
 
-  /// Cached loggers keyed by name.
-  std::unordered_map<std::string, std::shared_ptr<Logger>> loggers_;
+  /// Publishes per-logger counters in MetricsRegistry::instance().
+  std::uint64_t metrics_collector_id_ = 0;
 };
 
 }  // namespace sim_logger
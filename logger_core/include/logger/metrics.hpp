@@ -0,0 +1,308 @@
+#pragma once
+
+#include "logger/detail/thread_shard.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace sim_logger {
+
+/**
+ * @file metrics.hpp
+ * @brief Process-wide metrics for the logging pipeline (counters, gauges, histograms).
+ *
+ * @details
+ * Two ways to publish:
+ * - Owned metrics: MetricsRegistry::counter()/gauge()/histogram() return a
+ *   shared metric keyed by (name, labels); hot paths update it directly.
+ * - Collectors: a component registers a callback that appends samples at
+ *   snapshot() time and removes it on destruction, so nothing outlives its
+ *   owner. Loggers, AsyncSink and FileSink publish this way.
+ *
+ * Counters are sharded across cache-line-sized slots, picked per thread, so
+ * concurrent add() calls from different threads do not contend on one line.
+ *
+ * snapshot() returns every sample; to_prometheus() renders a snapshot in the
+ * Prometheus text exposition format, and MetricsFileExporter writes that
+ * periodically to a file (e.g. for node_exporter's textfile collector).
+ *
+ * Thread-safety:
+ * - All functions are safe to call concurrently.
+ */
+
+enum class MetricType : std::uint8_t { Counter, Gauge, Histogram };
+
+std::string_view to_string(MetricType type) noexcept;
+
+/// Label pairs, rendered in the given order.
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+struct MetricSample;
+
+/**
+ * @brief Monotonic counter sharded per thread.
+ */
+class ShardedCounter final {
+ public:
+  static constexpr std::size_t kShards = detail::kThreadShards;
+
+  ShardedCounter() = default;
+  ShardedCounter(const ShardedCounter&) = delete;
+  ShardedCounter& operator=(const ShardedCounter&) = delete;
+
+  void add(std::uint64_t n = 1) noexcept {
+    shards_[detail::thread_shard()].value.fetch_add(n, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Sum over all shards (not an atomic snapshot across shards).
+   */
+  std::uint64_t value() const noexcept;
+
+ private:
+  struct alignas(64) Shard {
+    std::atomic<std::uint64_t> value{0};
+  };
+  std::array<Shard, kShards> shards_{};
+};
+
+/**
+ * @brief Value that can go up and down.
+ */
+class Gauge final {
+ public:
+  Gauge() = default;
+  Gauge(const Gauge&) = delete;
+  Gauge& operator=(const Gauge&) = delete;
+
+  void set(double v) noexcept { value_.store(v, std::memory_order_relaxed); }
+  void add(double delta) noexcept;
+  double value() const noexcept { return value_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<double> value_{0.0};
+};
+
+/**
+ * @brief Fixed-bucket histogram (Prometheus semantics: bucket i counts values <= bounds[i]).
+ */
+class Histogram final {
+ public:
+  /**
+   * @param upper_bounds Strictly increasing finite bucket bounds; +Inf is implicit.
+   * @throws std::invalid_argument if bounds are empty or not strictly increasing.
+   */
+  explicit Histogram(std::vector<double> upper_bounds);
+
+  Histogram(const Histogram&) = delete;
+  Histogram& operator=(const Histogram&) = delete;
+
+  void observe(double v) noexcept;
+
+  const std::vector<double>& upper_bounds() const noexcept { return bounds_; }
+
+  /**
+   * @brief Per-bucket (non-cumulative) counts; the last entry is the +Inf bucket.
+   */
+  std::vector<std::uint64_t> bucket_counts() const;
+
+  std::uint64_t count() const noexcept;
+  double sum() const noexcept { return sum_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Fill the type, bucket and sum/count fields of @p out from the current state.
+   */
+  void fill_sample(MetricSample& out) const;
+
+ private:
+  std::vector<double> bounds_;
+  std::unique_ptr<ShardedCounter[]> buckets_;  // bounds_.size() + 1
+  std::atomic<double> sum_{0.0};
+};
+
+/**
+ * @brief One sample in a snapshot.
+ *
+ * For histograms, value is the sum of observations, count the number of
+ * observations, and bucket_counts are cumulative per bound (the +Inf bucket is
+ * count).
+ */
+struct MetricSample {
+  std::string name;
+  MetricLabels labels;
+  MetricType type = MetricType::Counter;
+  std::string help;
+  double value = 0.0;
+  std::uint64_t count = 0;
+  std::vector<double> bucket_bounds;
+  std::vector<std::uint64_t> bucket_counts;
+};
+
+using MetricsSnapshot = std::vector<MetricSample>;
+
+/**
+ * @brief Callback that appends samples to a snapshot.
+ */
+using MetricsCollector = std::function<void(MetricsSnapshot&)>;
+
+class MetricsRegistry final {
+ public:
+  /**
+   * @brief Process-wide registry (never destroyed, so components may unregister during static destruction).
+   */
+  static MetricsRegistry& instance();
+
+  MetricsRegistry() = default;
+  MetricsRegistry(const MetricsRegistry&) = delete;
+  MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+  /**
+   * @brief Get or create the counter (name, labels).
+   * @throws std::invalid_argument if the name is invalid or already registered with another type.
+   */
+  std::shared_ptr<ShardedCounter> counter(const std::string& name,
+                                          const MetricLabels& labels = {},
+                                          const std::string& help = {});
+
+  /**
+   * @brief Get or create the gauge (name, labels).
+   * @throws std::invalid_argument as for counter().
+   */
+  std::shared_ptr<Gauge> gauge(const std::string& name,
+                               const MetricLabels& labels = {},
+                               const std::string& help = {});
+
+  /**
+   * @brief Get or create the histogram (name, labels); bounds apply only on creation.
+   * @throws std::invalid_argument as for counter(), or for invalid bounds.
+   */
+  std::shared_ptr<Histogram> histogram(const std::string& name,
+                                       std::vector<double> upper_bounds,
+                                       const MetricLabels& labels = {},
+                                       const std::string& help = {});
+
+  /**
+   * @brief Register a collector run on every snapshot().
+   * @return Id for remove_collector().
+   */
+  std::uint64_t add_collector(MetricsCollector collector);
+
+  /**
+   * @brief Remove a collector; once this returns it is not running and will not run again.
+   */
+  void remove_collector(std::uint64_t id) noexcept;
+
+  /**
+   * @brief Every owned metric plus every collector's samples.
+   */
+  MetricsSnapshot snapshot() const;
+
+ private:
+  struct Entry {
+    std::string name;
+    MetricLabels labels;
+    MetricType type;
+    std::string help;
+    std::shared_ptr<ShardedCounter> counter;
+    std::shared_ptr<Gauge> gauge;
+    std::shared_ptr<Histogram> histogram;
+  };
+
+  Entry& find_or_add_(const std::string& name, const MetricLabels& labels, MetricType type,
+                      const std::string& help);
+
+  mutable std::mutex metrics_mutex_;
+  std::vector<Entry> entries_;
+
+  /// A registered collector. snapshot() runs it under its own mutex, without
+  /// holding collectors_mutex_, so a component may unregister while other
+  /// collectors run (e.g. a sink destroyed under LoggerRegistry's lock while
+  /// the registry's collector waits for that lock).
+  struct CollectorSlot {
+    std::mutex m;
+    bool alive = true;
+    MetricsCollector fn;
+  };
+
+  mutable std::mutex collectors_mutex_;
+  std::map<std::uint64_t, std::shared_ptr<CollectorSlot>> collectors_;
+  std::uint64_t next_collector_id_ = 1;
+};
+
+/**
+ * @brief Render @p snapshot in the Prometheus text exposition format (version 0.0.4).
+ *
+ * Samples sharing a name are grouped under one HELP/TYPE header.
+ */
+std::string to_prometheus(const MetricsSnapshot& snapshot);
+
+/**
+ * @brief Periodically writes to_prometheus(registry.snapshot()) to a file.
+ *
+ * Each export writes "<path>.tmp" and renames it over @p path, so readers never
+ * see a partial file. Failures on the export thread are counted, not thrown.
+ */
+class MetricsFileExporter final {
+ public:
+  /**
+   * @throws std::invalid_argument if path is empty or interval is not positive.
+   */
+  MetricsFileExporter(std::string path,
+                      std::chrono::milliseconds interval,
+                      MetricsRegistry& registry = MetricsRegistry::instance());
+
+  ~MetricsFileExporter();
+
+  MetricsFileExporter(const MetricsFileExporter&) = delete;
+  MetricsFileExporter& operator=(const MetricsFileExporter&) = delete;
+
+  /**
+   * @brief Start the export thread (exports once immediately).
+   * @throws std::runtime_error if already running.
+   */
+  void start();
+
+  /**
+   * @brief Stop the export thread after a final export. Idempotent.
+   */
+  void stop() noexcept;
+
+  /**
+   * @brief Write one export now on the calling thread.
+   * @throws std::runtime_error if the file cannot be written.
+   */
+  void export_now();
+
+  std::uint64_t exports_count() const noexcept { return exports_.load(std::memory_order_relaxed); }
+  std::uint64_t failures_count() const noexcept { return failures_.load(std::memory_order_relaxed); }
+
+ private:
+  void run_() noexcept;
+  void export_noexcept_() noexcept;
+
+  std::string path_;
+  std::chrono::milliseconds interval_;
+  MetricsRegistry& registry_;
+
+  std::thread thread_;
+  std::mutex m_;
+  std::condition_variable cv_;
+  bool stop_ = false;
+  std::atomic<std::uint64_t> exports_{0};
+  std::atomic<std::uint64_t> failures_{0};
+};
+
+}  // namespace sim_logger
@@ -63,6 +63,7 @@ class PatternFormatter {
    * - {function}-> record.function()
    * - {logger}  -> record.logger_name()
    * - {msg}     -> record.message()
+   * - {tags}    -> record.tags() as "key=value" pairs separated by spaces
    *
    * Unknown tokens are preserved verbatim (including braces).
    *
@@ -75,6 +76,16 @@ class PatternFormatter {
    */
   std::string format(const LogRecord& record) const;
 
+  /**
+   * @brief Append the formatted record to @p out.
+   *
+   * @details
+   * Same output as format(), but lets callers reuse a buffer across records.
+   * Existing contents of @p out are kept. Safe to call concurrently on a shared
+   * formatter (it holds no mutable state).
+   */
+  void format_to(const LogRecord& record, std::string& out) const;
+
   /**
    * @brief Return the raw pattern string.
    */
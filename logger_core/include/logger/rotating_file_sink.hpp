@@ -3,6 +3,7 @@
 #include "logger/file_sink.hpp"
 #include "logger/pattern_formatter.hpp"
 
+#include <atomic>
 #include <cstdint>
 #include <cstddef>
 #include <string>
@@ -19,6 +20,9 @@ namespace sim_logger {
  * - Size-based rotation only.
  * - Rename-with-timestamp is required.
  * - Compression/zip is out-of-scope.
+ *
+ * Besides FileSink's `sim_logger_file_bytes`, rotations and failed rotations are
+ * published in MetricsRegistry::instance() under the base path.
  */
 class RotatingFileSink final : public FileSink {
  public:
@@ -38,19 +42,28 @@ class RotatingFileSink final : public FileSink {
                    bool durable_flush = false,
                    std::size_t max_rotated_files = 0);
 
-  ~RotatingFileSink() override = default;
+  ~RotatingFileSink() override;
 
-  void write(const LogRecord& record) override;
+  // write() is inherited: FileSink formats the record and dispatches here.
+  void write_formatted(const LogRecord& record, std::string_view line) override;
 
   std::uint64_t max_bytes() const noexcept { return max_bytes_; }
-  std::uint64_t rotations_performed() const noexcept { return rotations_performed_; }
+  std::uint64_t rotations_performed() const noexcept {
+    return rotations_performed_.load(std::memory_order_relaxed);
+  }
+  /// Number of rotations that threw (rename or reopen failed).
+  std::uint64_t rotation_failures() const noexcept {
+    return rotation_failures_.load(std::memory_order_relaxed);
+  }
   std::size_t max_rotated_files() const noexcept { return max_rotated_files_; }
 
  private:
   std::string base_path_;
   std::uint64_t max_bytes_{0};
-  std::uint64_t rotations_performed_{0};
+  std::atomic<std::uint64_t> rotations_performed_{0};
+  std::atomic<std::uint64_t> rotation_failures_{0};
   std::size_t max_rotated_files_{0};
+  std::uint64_t rotation_collector_id_ = 0;
 
   void rotate_locked();
   void prune_old_rotations_locked() noexcept;
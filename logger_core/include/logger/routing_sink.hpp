@@ -0,0 +1,152 @@
+#pragma once
+
+#include "logger/level.hpp"
+#include "logger/sink.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace sim_logger {
+
+/**
+ * @file routing_sink.hpp
+ * @brief Sink that dispatches records to target sinks based on ordered rules.
+ *
+ * @details
+ * Typical use: one RoutingSink attached to the root logger splits output by
+ * subsystem, e.g. "vehicle*.gnc.*" -> gnc.log and ERROR+ -> alerts.log.
+ *
+ * Rules are evaluated in declaration order. A record is written to the target of
+ * every matching rule until a matching rule with stop=true is reached. If no rule
+ * writes the record, it goes to the fallback sink (when provided). A rule whose
+ * target rejects the record via should_log() does not count as a match.
+ */
+
+/**
+ * @brief Tag predicate: the record must carry a tag with this key (and value, if set).
+ */
+struct TagMatch {
+  std::string key;
+  std::optional<std::string> value;
+};
+
+/**
+ * @brief One routing rule.
+ */
+struct RoutingRule {
+  /**
+   * @brief Logger-name glob (see detail/name_glob.hpp). "*" matches every logger.
+   */
+  std::string logger_glob = "*";
+
+  /**
+   * @brief Inclusive level range.
+   */
+  Level min_level = Level::Debug;
+  Level max_level = Level::Fatal;
+
+  /**
+   * @brief All tag predicates must match.
+   */
+  std::vector<TagMatch> tags;
+
+  /**
+   * @brief Destination sink (must be non-null).
+   */
+  std::shared_ptr<ISink> sink;
+
+  /**
+   * @brief If true, evaluation stops after this rule matches.
+   */
+  bool stop = false;
+};
+
+/**
+ * @brief Rule-based fan-out sink.
+ *
+ * @details
+ * Logger-name globs are compiled at construction into a character trie keyed by
+ * each pattern's literal prefix, so only rules whose prefix matches the name are
+ * glob-tested. The per-name result (the ordered list of rules whose glob matches)
+ * is cached, so steady-state routing costs one hash lookup plus the level and tag
+ * checks of the candidate rules.
+ *
+ * Thread-safety:
+ * - Rules are immutable after construction.
+ * - The name cache is guarded by a shared mutex (shared on hit, exclusive on miss).
+ *
+ * Failure behavior:
+ * - Exceptions from target sinks are swallowed and counted so one failing target
+ *   does not prevent delivery to the others.
+ */
+class RoutingSink final : public ISink {
+ public:
+  /**
+   * @param rules Ordered routing rules (each sink must be non-null).
+   * @param fallback Optional sink for records no rule wrote.
+   *
+   * @throws std::invalid_argument if a rule has a null sink or min_level > max_level.
+   */
+  explicit RoutingSink(std::vector<RoutingRule> rules, std::shared_ptr<ISink> fallback = nullptr);
+
+  RoutingSink(const RoutingSink&) = delete;
+  RoutingSink& operator=(const RoutingSink&) = delete;
+
+  void write(const LogRecord& record) override;
+
+  /**
+   * @brief Flush every distinct target (and the fallback).
+   */
+  void flush() override;
+
+  /**
+   * @brief Number of logger names currently held in the decision cache.
+   */
+  std::size_t cached_names_count() const;
+
+  /**
+   * @brief Total number of times a target sink threw during write/flush.
+   */
+  std::uint64_t sink_failures_count() const noexcept {
+    return sink_failures_count_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct TrieNode {
+    /// (character, child node index), sorted by character.
+    std::vector<std::pair<char, std::uint32_t>> children;
+    /// Rules whose literal prefix ends at this node.
+    std::vector<std::uint32_t> rules;
+  };
+
+  void compile_();
+  std::vector<std::uint32_t> match_name_(std::string_view name) const;
+  const std::vector<std::uint32_t>& rules_for_(std::string_view name);
+  static bool tags_match_(const RoutingRule& rule, const LogRecord& record) noexcept;
+
+  std::vector<RoutingRule> rules_;
+  std::shared_ptr<ISink> fallback_;
+
+  /// Distinct sinks to flush (rule targets + fallback).
+  std::vector<std::shared_ptr<ISink>> flush_targets_;
+
+  /// Compiled literal-prefix trie; node 0 is the root.
+  std::vector<TrieNode> trie_;
+
+  /// Decision cache keyed by logger name. Keys view into names_ (stable storage).
+  mutable std::shared_mutex cache_mutex_;
+  std::deque<std::string> names_;
+  std::unordered_map<std::string_view, std::vector<std::uint32_t>> cache_;
+
+  std::atomic<std::uint64_t> sink_failures_count_{0};
+};
+
+}  // namespace sim_logger
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "logger/level.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace sim_logger {
+
+/**
+ * @file shared_level_table.hpp
+ * @brief Logger levels published in POSIX shared memory.
+ *
+ * @details
+ * A zero-syscall alternative to ControlServer: the process publishes one slot
+ * per logger (id = slot index, keyed by logger name) in a shm_open() segment.
+ * Each slot carries the logger's effective level, written by the process, and
+ * an override byte written by external tools. Logger::effective_level() checks
+ * the override with a relaxed atomic load, so a tool flipping the byte changes
+ * the level immediately, with no thread or syscall in the logging process.
+ *
+ * Overrides are per logger (they do not propagate to children) and take
+ * precedence over every other level source. Writing kNoOverride removes one.
+ *
+ * Slots are allocated append-only and never reused for another name, so ids are
+ * stable for the life of the segment (including across LoggerRegistry::clear()).
+ * Names longer than kNameCapacity - 1 bytes are not published.
+ *
+ * Platform: POSIX only (create/open throw elsewhere).
+ */
+
+namespace detail {
+
+/// One logger's entry. Layout is shared with external processes.
+struct SharedLevelSlot {
+  static constexpr std::size_t kNameCapacity = 96;
+
+  char name[kNameCapacity];
+  /// Effective level as computed by the process (Level value).
+  std::atomic<std::uint8_t> effective;
+  /// Level forced by a tool, or SharedLevelTable::kNoOverride.
+  std::atomic<std::uint8_t> override_level;
+  /// Set (release) once name is fully written.
+  std::atomic<std::uint8_t> used;
+};
+
+struct SharedLevelHeader {
+  std::uint32_t magic;
+  std::uint32_t version;
+  std::uint32_t capacity;
+  /// Number of allocated slots (release after the slot is initialized).
+  std::atomic<std::uint32_t> count;
+};
+
+static_assert(std::atomic<std::uint8_t>::is_always_lock_free,
+              "shared level bytes must be lock-free to live in shared memory");
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free,
+              "shared level count must be lock-free to live in shared memory");
+
+}  // namespace detail
+
+class SharedLevelTable final {
+ public:
+  static constexpr std::uint8_t kNoOverride = 0xFF;
+  static constexpr std::uint32_t kMagic = 0x534C4C54;  // "SLLT"
+  static constexpr std::uint32_t kVersion = 1;
+
+  /**
+   * @brief Create the segment @p shm_name (e.g. "/sim_levels").
+   *
+   * The creating process owns the segment and unlinks it on destruction.
+   *
+   * An existing segment of that name is left alone (another process or table
+   * may be publishing through it) unless @p replace_existing is set, e.g. to
+   * recover a segment left behind by a crashed process. Replacing detaches
+   * every tool mapped to the old segment.
+   *
+   * @throws std::runtime_error if the segment already exists (and
+   *         replace_existing is false) or on failure; std::invalid_argument if
+   *         capacity is 0.
+   */
+  static std::shared_ptr<SharedLevelTable> create(const std::string& shm_name,
+                                                  std::size_t capacity = 1024,
+                                                  bool replace_existing = false);
+
+  /**
+   * @brief Map an existing segment (external tools).
+   *
+   * @throws std::runtime_error if it does not exist or has an unexpected layout.
+   */
+  static std::shared_ptr<SharedLevelTable> open(const std::string& shm_name);
+
+  ~SharedLevelTable();
+
+  SharedLevelTable(const SharedLevelTable&) = delete;
+  SharedLevelTable& operator=(const SharedLevelTable&) = delete;
+
+  std::size_t capacity() const noexcept;
+
+  /**
+   * @brief Number of allocated slots (ids are 0..size()-1).
+   */
+  std::size_t size() const noexcept;
+
+  /**
+   * @brief Find the slot for @p logger_name, allocating one if needed.
+   *
+   * @return nullptr if the table is full or the name is too long.
+   */
+  detail::SharedLevelSlot* acquire_slot(std::string_view logger_name);
+
+  /**
+   * @brief Id of @p logger_name, if it has a slot.
+   */
+  std::optional<std::size_t> find(std::string_view logger_name) const noexcept;
+
+  std::string_view name(std::size_t id) const noexcept;
+  std::optional<Level> effective_level(std::size_t id) const noexcept;
+  std::optional<Level> override_level(std::size_t id) const noexcept;
+
+  /**
+   * @brief Force (or with std::nullopt, release) the level of logger @p id.
+   *
+   * @return false if id is out of range.
+   */
+  bool set_override(std::size_t id, std::optional<Level> level) noexcept;
+
+ private:
+  SharedLevelTable(std::string shm_name, void* base, std::size_t bytes, bool owner) noexcept;
+
+  detail::SharedLevelHeader* header_() const noexcept;
+  detail::SharedLevelSlot* slots_() const noexcept;
+
+  std::string shm_name_;
+  void* base_;
+  std::size_t bytes_;
+  bool owner_;
+  /// Identity (st_dev, st_ino) of the owned segment, so the destructor does not
+  /// unlink a segment that replaced it under the same name.
+  std::uint64_t owned_dev_ = 0;
+  std::uint64_t owned_ino_ = 0;
+
+  /// Serializes slot allocation within this process.
+  std::mutex alloc_mutex_;
+};
+
+}  // namespace sim_logger
@@ -1,7 +1,13 @@
 #pragma once
 
+#include "logger/level.hpp"
 #include "logger/log_record.hpp"
 
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string_view>
+
 namespace sim_logger {
 
 /**
@@ -21,8 +27,22 @@ namespace sim_logger {
  * all exceptions arising from sinks and formatting.
  *
  * The sink interface is intentionally minimal in Sprint 2.
+ *
+ * Per-sink filtering:
+ *  - Each sink carries an optional minimum level and filter predicate.
+ *  - Dispatchers (Logger::log, RoutingSink) consult should_log() before calling
+ *    write(), so rejected records are never copied or enqueued by the sink.
+ *  - write() itself does not re-check the filter; direct callers (e.g. a flight
+ *    recorder dump) bypass it by design.
  */
 
+/**
+ * @brief Per-sink record predicate. Returning false rejects the record.
+ */
+using SinkFilter = std::function<bool(const LogRecord&)>;
+
+class PatternFormatter;
+
 /**
  * @brief Abstract sink interface.
  */
@@ -51,6 +71,71 @@ class ISink {
    * (exceptions must not propagate into simulation code).
    */
   virtual void flush() = 0;
+
+  /**
+   * @brief Set the minimum level this sink accepts (default: Debug, i.e. everything).
+   */
+  void set_level(Level level) noexcept { level_.store(level, std::memory_order_relaxed); }
+
+  /**
+   * @brief Minimum level this sink accepts.
+   */
+  Level level() const noexcept { return level_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Install a filter predicate (replaces any previous one).
+   *
+   * @note
+   * The predicate may be called concurrently from multiple threads and must be
+   * thread-safe. A predicate that throws rejects the record.
+   */
+  void set_filter(SinkFilter filter);
+
+  /**
+   * @brief Remove the filter predicate.
+   */
+  void clear_filter() noexcept;
+
+  /**
+   * @brief Return true if this sink wants the record.
+   *
+   * @details
+   * The default implementation checks the sink level first and then the filter
+   * predicate (if any). Decorator sinks override this to also consult the sink
+   * they wrap, so a filter on the final destination is honored before any
+   * copying or queueing happens upstream.
+   */
+  virtual bool should_log(const LogRecord& record) const noexcept;
+
+  /**
+   * @brief Formatter used by text-oriented sinks (nullptr if the sink does not render text).
+   *
+   * @details
+   * A non-null formatter lets upstream stages (AsyncSink's formatting threads)
+   * render lines ahead of time and hand them to write_formatted().
+   */
+  virtual const PatternFormatter* formatter() const noexcept { return nullptr; }
+
+  /**
+   * @brief Consume a record whose line was already rendered with formatter().
+   *
+   * @details
+   * The default ignores @p line and calls write(). Text sinks override this to
+   * skip formatting. Same thread-safety and exception rules as write().
+   */
+  virtual void write_formatted(const LogRecord& record, std::string_view line) {
+    (void)line;
+    write(record);
+  }
+
+ private:
+  std::atomic<Level> level_{Level::Debug};
+
+  /// Fast-path flag so sinks without a predicate never touch filter_.
+  std::atomic<bool> has_filter_{false};
+
+  /// Accessed with std::atomic_load/std::atomic_store.
+  std::shared_ptr<const SinkFilter> filter_;
 };
 
 } // namespace sim_logger
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace sim_logger {
+
+class Logger;
+
+/**
+ * @file static_logger.hpp
+ * @brief Once-resolved logger handles for hot call sites.
+ *
+ * @details
+ * A StaticLogger names a logger and resolves it through LoggerRegistry on first
+ * use, then hands out a cached Logger& with no hashing or locking. It has a
+ * constexpr constructor, so namespace-scope and function-local instances are
+ * constant-initialized (no static-init-order or guard cost).
+ *
+ * Registry resets:
+ * - The cached pointer is tagged with LoggerRegistry::generation(); after
+ *   LoggerRegistry::clear() the next get() re-resolves the name.
+ * - A handle keeps its current Logger and the one it replaced alive, so a
+ *   Logger& obtained before a clear() stays valid until the handle re-resolves
+ *   after the next clear(). Older Loggers (and their sinks) are released once
+ *   nothing else holds them.
+ *
+ * Thread-safety:
+ * - get() is safe to call concurrently; racing first calls resolve to the same
+ *   registry entry.
+ */
+class StaticLogger final {
+ public:
+  /**
+   * @param name Logger name; must outlive the handle (typically a string literal).
+   */
+  explicit constexpr StaticLogger(const char* name) noexcept : name_(name) {}
+
+  StaticLogger(const StaticLogger&) = delete;
+  StaticLogger& operator=(const StaticLogger&) = delete;
+
+  /**
+   * @brief Return the logger, resolving it on first use or after a registry reset.
+   *
+   * @throws std::bad_alloc if the logger has to be created and allocation fails.
+   */
+  Logger& get();
+
+  Logger& operator*() { return get(); }
+  Logger* operator->() { return &get(); }
+
+  const char* name() const noexcept { return name_; }
+
+ private:
+  Logger& resolve_(std::uint64_t generation);
+
+  const char* name_;
+  std::atomic<Logger*> logger_{nullptr};
+  std::atomic<std::uint64_t> generation_{0};
+};
+
+}  // namespace sim_logger
+
+/**
+ * @brief Define a translation-unit-local StaticLogger named @p var.
+ *
+ * Usage (namespace scope):
+ *   SIM_LOGGER_DEFINE(gnc_log, "vehicle1.gnc");
+ *   LOG_INFO(gnc_log, "guidance converged");
+ */
+#define SIM_LOGGER_DEFINE(var, name) static ::sim_logger::StaticLogger var{name}
+
+/**
+ * @brief Expression yielding a Logger& cached per call site.
+ *
+ * Usage:
+ *   LOG_DEBUG(SIM_LOGGER_GET_STATIC("vehicle1.gnc"), "step");
+ */
+#define SIM_LOGGER_GET_STATIC(name)                           \
+  ([]() -> ::sim_logger::Logger& {                            \
+    static ::sim_logger::StaticLogger sim_logger_static_{name}; \
+    return sim_logger_static_.get();                          \
+  }())
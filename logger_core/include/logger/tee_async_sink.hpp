@@ -0,0 +1,117 @@
+#pragma once
+
+#include "logger/async_sink.hpp"
+#include "logger/sink.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace sim_logger {
+
+/**
+ * @brief One destination of a TeeAsyncSink.
+ */
+struct TeeTarget {
+  /**
+   * @brief Destination sink (must be non-null).
+   */
+  std::shared_ptr<ISink> sink;
+
+  /**
+   * @brief Overflow behavior when this target's backlog reaches capacity.
+   */
+  OverflowPolicy overflow_policy = OverflowPolicy::Block;
+
+  /**
+   * @brief Maximum number of records queued for this target.
+   */
+  std::size_t capacity = 1024;
+};
+
+/**
+ * @file tee_async_sink.hpp
+ * @brief Async fan-out sink with independent per-target backlogs.
+ *
+ * @details
+ * Wrapping a fan-out in a single AsyncSink couples all targets: one worker
+ * writes to each sink in turn, so a slow terminal throttles the file too.
+ *
+ * TeeAsyncSink instead copies each record once into a shared, preallocated slot
+ * pool and appends the slot index to a per-target ring. Each target has its own
+ * worker thread, cursor, capacity and overflow policy, and drains at its own
+ * speed. A slot is recycled once every target it was queued for has written it.
+ *
+ * Overflow is applied per target:
+ *  - Block: the producer waits for room in that target's backlog.
+ *  - DropNewest: the record is not queued for that target.
+ *  - DropOldest: that target's oldest queued record is discarded.
+ * Only a Block target can slow producers; Drop* targets affect only themselves.
+ *
+ * flush() returns once every target has drained and flushed.
+ *
+ * Per-target queue depth, drops and sink failures are published in
+ * MetricsRegistry::instance() with `sink` and `target` (index) labels.
+ */
+class TeeAsyncSink final : public ISink {
+ public:
+  /// Upper bound on the number of targets.
+  static constexpr std::size_t kMaxTargets = 64;
+
+  /**
+   * @param targets Destinations (1..kMaxTargets, each sink non-null).
+   * @param max_batch Maximum number of records a target worker drains per iteration.
+   * @param metrics_name Value of the `sink` label on this sink's metrics; empty
+   *        picks "tee-<n>", numbered in construction order.
+   *
+   * @throws std::invalid_argument on an empty/oversized target list or a null sink.
+   */
+  explicit TeeAsyncSink(std::vector<TeeTarget> targets,
+                        std::size_t max_batch = 256,
+                        std::string metrics_name = {});
+  ~TeeAsyncSink() override;
+
+  TeeAsyncSink(const TeeAsyncSink&) = delete;
+  TeeAsyncSink& operator=(const TeeAsyncSink&) = delete;
+
+  void write(const LogRecord& record) override;
+  void flush() override;
+
+  /**
+   * @brief Accept records this sink accepts and at least one target accepts.
+   *
+   * Each target's should_log() is also checked per record in write(), so a
+   * target never queues records it would reject.
+   */
+  bool should_log(const LogRecord& record) const noexcept override;
+
+  std::size_t targets_count() const noexcept;
+
+  /**
+   * @brief Records dropped by the given target's overflow policy.
+   */
+  std::uint64_t dropped_records_count(std::size_t target) const noexcept;
+
+  /**
+   * @brief Number of times the given target threw during write/flush.
+   */
+  std::uint64_t sink_failures_count(std::size_t target) const noexcept;
+
+  /**
+   * @brief Records currently queued for the given target.
+   */
+  std::size_t queue_depth(std::size_t target) const;
+
+  /**
+   * @brief The `sink` label used for this sink's metrics.
+   */
+  const std::string& metrics_name() const noexcept;
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace sim_logger
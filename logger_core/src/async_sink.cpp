@@ -2,10 +2,15 @@
 
 #include "logger/detail/async_queue.hpp"
 #include "logger/detail/mutex_ring_buffer_queue.hpp"
+#include "logger/metrics.hpp"
+#include "logger/pattern_formatter.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
 #include <stdexcept>
+#include <string>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -15,12 +20,164 @@ namespace sim_logger {
 using detail::IQueue;
 using detail::MutexRingBufferQueue;
 
+namespace {
+
+/**
+ * @brief Renders a batch on helper threads plus the calling thread.
+ *
+ * lines[i] / ok[i] correspond to batch[i] for i < count. Work is claimed in small chunks
+ * through an atomic cursor; format() returns once every chunk is done and no
+ * helper is still touching the job.
+ */
+class FormatPool {
+ public:
+  FormatPool(const PatternFormatter& formatter, std::size_t threads) : formatter_(formatter) {
+    helpers_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+      helpers_.emplace_back([this] { helper_loop_(); });
+    }
+  }
+
+  ~FormatPool() {
+    {
+      std::lock_guard<std::mutex> lk(m_);
+      stop_ = true;
+    }
+    cv_job_.notify_all();
+    for (auto& t : helpers_) {
+      t.join();
+    }
+  }
+
+  FormatPool(const FormatPool&) = delete;
+  FormatPool& operator=(const FormatPool&) = delete;
+
+  void format(const std::vector<LogRecord>& batch,
+              std::size_t count,
+              std::vector<std::string>& lines,
+              std::vector<char>& ok) noexcept {
+    if (lines.size() < count) {
+      lines.resize(count);
+    }
+    ok.assign(count, 0);
+
+    {
+      std::lock_guard<std::mutex> lk(m_);
+      batch_ = &batch;
+      count_ = count;
+      lines_ = &lines;
+      ok_ = &ok;
+      next_.store(0, std::memory_order_relaxed);
+      completed_ = 0;
+      ++job_gen_;
+    }
+    cv_job_.notify_all();
+
+    run_chunks_(batch, count, lines, ok);
+
+    std::unique_lock<std::mutex> lk(m_);
+    cv_done_.wait(lk, [&] { return completed_ == count && active_ == 0; });
+    batch_ = nullptr;
+  }
+
+ private:
+  static constexpr std::size_t kChunk = 8;
+
+  void run_chunks_(const std::vector<LogRecord>& batch,
+                   std::size_t n,
+                   std::vector<std::string>& lines,
+                   std::vector<char>& ok) noexcept {
+    for (;;) {
+      const std::size_t begin = next_.fetch_add(kChunk, std::memory_order_relaxed);
+      if (begin >= n) {
+        return;
+      }
+      const std::size_t end = std::min(begin + kChunk, n);
+      for (std::size_t i = begin; i < end; ++i) {
+        lines[i].clear();
+        try {
+          formatter_.format_to(batch[i], lines[i]);
+          ok[i] = 1;
+        } catch (...) {
+          ok[i] = 0;  // the writer falls back to write()
+        }
+      }
+      {
+        std::lock_guard<std::mutex> lk(m_);
+        completed_ += end - begin;
+      }
+      cv_done_.notify_one();
+    }
+  }
+
+  void helper_loop_() noexcept {
+    std::uint64_t seen = 0;
+    std::unique_lock<std::mutex> lk(m_);
+    for (;;) {
+      cv_job_.wait(lk, [&] { return stop_ || (batch_ != nullptr && job_gen_ != seen); });
+      if (stop_) {
+        return;
+      }
+      seen = job_gen_;
+      const auto& batch = *batch_;
+      const std::size_t count = count_;
+      auto& lines = *lines_;
+      auto& ok = *ok_;
+      ++active_;
+      lk.unlock();
+
+      run_chunks_(batch, count, lines, ok);
+
+      lk.lock();
+      if (--active_ == 0) {
+        cv_done_.notify_one();
+      }
+    }
+  }
+
+  const PatternFormatter& formatter_;
+  std::vector<std::thread> helpers_;
+
+  std::mutex m_;
+  std::condition_variable cv_job_;
+  std::condition_variable cv_done_;
+
+  const std::vector<LogRecord>* batch_ = nullptr;
+  std::size_t count_ = 0;
+  std::vector<std::string>* lines_ = nullptr;
+  std::vector<char>* ok_ = nullptr;
+  std::atomic<std::size_t> next_{0};
+  std::size_t completed_ = 0;
+  std::size_t active_ = 0;
+  std::uint64_t job_gen_ = 0;
+  bool stop_ = false;
+};
+
+}  // namespace
+
 struct AsyncSink::Impl {
   std::thread worker;
   std::mutex flush_m;
   std::condition_variable flush_cv;
+
+  // Parallel formatting (format_threads > 0 and a text sink); worker-thread only.
+  std::unique_ptr<FormatPool> format_pool;
+  std::vector<std::string> lines;
+  std::vector<char> formatted_ok;
+
+  // Metrics: enqueued is bumped by every producer, hence sharded; the batch
+  // histogram is only touched by the worker.
+  ShardedCounter enqueued;
+  Histogram batch_size{{1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024}};
+  std::uint64_t collector_id = 0;
 };
 
+namespace {
+
+std::atomic<std::uint64_t> g_async_sink_seq{0};
+
+}  // namespace
+
 AsyncSink::AsyncSink(std::shared_ptr<ISink> wrapped, AsyncOptions options)
     : wrapped_(std::move(wrapped)), options_(options), impl_(std::make_unique<Impl>()) {
   if (!wrapped_) {
@@ -32,12 +189,84 @@ AsyncSink::AsyncSink(std::shared_ptr<ISink> wrapped, AsyncOptions options)
   if (options_.max_batch == 0) {
     options_.max_batch = 1;
   }
+  if (options_.linger.count() < 0) {
+    options_.linger = std::chrono::microseconds(0);
+  }
+  const std::size_t batch_limit = std::min(options_.capacity, options_.max_batch);
+  // A linger that stops at one record would never coalesce anything; with the
+  // default min_batch, linger alone waits for a full batch.
+  if (options_.linger.count() > 0 && options_.min_batch <= 1) {
+    options_.min_batch = batch_limit;
+  }
+  options_.min_batch = std::clamp<std::size_t>(options_.min_batch, 1, batch_limit);
 
-  queue_ = std::make_unique<MutexRingBufferQueue>(options_.capacity, options_.overflow_policy);
-  impl_->worker = std::thread([this] { worker_loop_(); });
+  if (options_.format_threads > 0) {
+    if (const PatternFormatter* fmt = wrapped_->formatter()) {
+      impl_->format_pool = std::make_unique<FormatPool>(*fmt, options_.format_threads);
+    }
+  }
+
+  if (options_.metrics_name.empty()) {
+    options_.metrics_name = "async-" + std::to_string(g_async_sink_seq.fetch_add(1) + 1);
+  }
+
+  queue_ = std::make_unique<MutexRingBufferQueue>(options_.capacity, options_.overflow_policy,
+                                                  options_.priority_level);
+
+  // Register the collector before starting the worker: if registration throws,
+  // there is no running thread to leave behind (destroying a joinable
+  // std::thread would terminate).
+  impl_->collector_id = MetricsRegistry::instance().add_collector([this](MetricsSnapshot& out) {
+    const MetricLabels labels{{"sink", options_.metrics_name}};
+    const auto counter = [&](const char* name, const char* help, std::uint64_t v) {
+      MetricSample s;
+      s.name = name;
+      s.labels = labels;
+      s.type = MetricType::Counter;
+      s.help = help;
+      s.value = static_cast<double>(v);
+      out.push_back(std::move(s));
+    };
+    counter("sim_logger_async_enqueued_records_total", "Records accepted into the AsyncSink queue",
+            impl_->enqueued.value());
+    counter("sim_logger_async_dropped_records_total", "Records dropped by the AsyncSink overflow policy",
+            dropped_records_count());
+    counter("sim_logger_async_priority_dropped_records_total",
+            "Priority records dropped by the AsyncSink overflow policy",
+            priority_dropped_records_count());
+    counter("sim_logger_async_sink_failures_total", "Exceptions from the sink wrapped by an AsyncSink",
+            sink_failures_count());
+    counter("sim_logger_async_priority_flushes_total", "Wrapped-sink flushes triggered by priority records",
+            priority_flushes_count());
+
+    MetricSample depth;
+    depth.name = "sim_logger_async_queue_depth";
+    depth.labels = labels;
+    depth.type = MetricType::Gauge;
+    depth.help = "Records currently queued in the AsyncSink";
+    depth.value = static_cast<double>(queue_->size());
+    out.push_back(std::move(depth));
+
+    MetricSample batch;
+    batch.name = "sim_logger_async_batch_size";
+    batch.labels = labels;
+    batch.help = "Records written per AsyncSink worker batch";
+    impl_->batch_size.fill_sample(batch);
+    out.push_back(std::move(batch));
+  });
+
+  try {
+    impl_->worker = std::thread([this] { worker_loop_(); });
+  } catch (...) {
+    MetricsRegistry::instance().remove_collector(impl_->collector_id);
+    throw;
+  }
 }
 
 AsyncSink::~AsyncSink() {
+  if (impl_) {
+    MetricsRegistry::instance().remove_collector(impl_->collector_id);
+  }
   request_stop_();
   if (impl_ && impl_->worker.joinable()) {
     impl_->worker.join();
@@ -60,16 +289,33 @@ void AsyncSink::request_stop_() noexcept {
 }
 
 void AsyncSink::write(const LogRecord& record) {
-  // LogRecord is immutable; copy then move into queue.
-  LogRecord copy = record;
-  const auto res = queue_->enqueue(std::move(copy));
+  // Copy straight into a queue slot, reusing its buffers.
+  const auto res = queue_->enqueue_copy(record);
+  if (res.enqueued) {
+    impl_->enqueued.add();
+  }
   if (res.dropped > 0) {
     dropped_records_count_.fetch_add(res.dropped, std::memory_order_relaxed);
   }
+  if (res.priority_dropped > 0) {
+    priority_dropped_records_count_.fetch_add(res.priority_dropped, std::memory_order_relaxed);
+  }
   if (!res.enqueued && res.dropped == 0) {
     // Stop requested (or other non-overflow rejection) counts as a drop.
     dropped_records_count_.fetch_add(1, std::memory_order_relaxed);
   }
+
+  // Priority records must not sit out the batch linger.
+  if (res.enqueued && options_.linger.count() > 0 && options_.priority_level &&
+      record.level() >= *options_.priority_level) {
+    if (auto* q = dynamic_cast<MutexRingBufferQueue*>(queue_.get())) {
+      q->kick_for_flush();
+    }
+  }
+}
+
+bool AsyncSink::should_log(const LogRecord& record) const noexcept {
+  return ISink::should_log(record) && wrapped_->should_log(record);
 }
 
 void AsyncSink::flush() {
@@ -86,9 +332,43 @@ void AsyncSink::flush() {
   impl_->flush_cv.wait(lk, [&] { return flush_done_gen_.load(std::memory_order_acquire) >= gen; });
 }
 
+void AsyncSink::write_batch_(const std::vector<LogRecord>& batch, std::size_t count) noexcept {
+  impl_->batch_size.observe(static_cast<double>(count));
+
+  FormatPool* pool = impl_->format_pool.get();
+  if (pool != nullptr) {
+    pool->format(batch, count, impl_->lines, impl_->formatted_ok);
+  }
+
+  for (std::size_t i = 0; i < count; ++i) {
+    const LogRecord& r = batch[i];
+    try {
+      if (pool != nullptr && impl_->formatted_ok[i] != 0) {
+        wrapped_->write_formatted(r, impl_->lines[i]);
+      } else {
+        wrapped_->write(r);
+      }
+    } catch (...) {
+      sink_failures_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Priority lane: make this record (and everything before it) durable now
+    // rather than after the rest of the batch and the backlog.
+    if (options_.priority_level && r.level() >= *options_.priority_level) {
+      try {
+        wrapped_->flush();
+      } catch (...) {
+        sink_failures_count_.fetch_add(1, std::memory_order_relaxed);
+      }
+      priority_flushes_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+}
+
 void AsyncSink::worker_loop_() noexcept {
-  std::vector<LogRecord> batch;
-  batch.reserve(options_.max_batch);
+  // Fixed-size batch exchanged with the queue's slots (see exchange_batch()),
+  // so record buffers circulate instead of being freed after every write.
+  std::vector<LogRecord> batch(options_.max_batch);
 
   // Specialize waiting logic for MutexRingBufferQueue (v1 backend).
   auto* q = dynamic_cast<MutexRingBufferQueue*>(queue_.get());
@@ -98,27 +378,28 @@ void AsyncSink::worker_loop_() noexcept {
   }
 
   std::uint64_t last_seen_flush_gen = 0;
+  const bool lingering = options_.linger.count() > 0 && options_.min_batch > 1;
 
   for (;;) {
     // Wait for work, flush request, or stop.
     {
       std::unique_lock<std::mutex> lk(q->mutex());
-      q->wait_for_work(lk);
+      const bool kicked = q->wait_for_work(lk);
       if (q->stop_requested_unlocked() && !q->has_items_unlocked()) {
         break;
       }
+
+      // Linger: give the batch a chance to fill unless a flush, stop or priority
+      // record is already pending.
+      if (lingering && !kicked && q->has_items_unlocked() && !q->stop_requested_unlocked() &&
+          flush_request_gen_.load(std::memory_order_acquire) == last_seen_flush_gen) {
+        q->wait_for_batch(lk, options_.min_batch, std::chrono::steady_clock::now() + options_.linger);
+      }
     }
 
     // Drain batches.
-    while (queue_->dequeue_batch(batch, options_.max_batch) > 0) {
-      for (const auto& r : batch) {
-        try {
-          wrapped_->write(r);
-        } catch (...) {
-          sink_failures_count_.fetch_add(1, std::memory_order_relaxed);
-        }
-      }
-      batch.clear();
+    while (const std::size_t n = queue_->exchange_batch(batch)) {
+      write_batch_(batch, n);
     }
 
     // Handle flush requests.
@@ -141,15 +422,8 @@ void AsyncSink::worker_loop_() noexcept {
   }
 
   // Final drain on shutdown (best-effort).
-  while (queue_->dequeue_batch(batch, options_.max_batch) > 0) {
-    for (const auto& r : batch) {
-      try {
-        wrapped_->write(r);
-      } catch (...) {
-        sink_failures_count_.fetch_add(1, std::memory_order_relaxed);
-      }
-    }
-    batch.clear();
+  while (const std::size_t n = queue_->exchange_batch(batch)) {
+    write_batch_(batch, n);
   }
   try {
     wrapped_->flush();
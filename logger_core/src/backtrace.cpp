@@ -0,0 +1,214 @@
+#include "logger/backtrace.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace sim_logger {
+
+namespace {
+
+/**
+ * @brief Minimal guard for a per-ring atomic_flag.
+ *
+ * @details
+ * Only the owning thread and an in-progress dump ever take the flag, so the
+ * owning thread effectively never spins.
+ */
+class SpinGuard {
+ public:
+  explicit SpinGuard(std::atomic_flag& flag) noexcept : flag_(flag) {
+    while (flag_.test_and_set(std::memory_order_acquire)) {
+      std::this_thread::yield();
+    }
+  }
+  ~SpinGuard() { flag_.clear(std::memory_order_release); }
+
+  SpinGuard(const SpinGuard&) = delete;
+  SpinGuard& operator=(const SpinGuard&) = delete;
+
+ private:
+  std::atomic_flag& flag_;
+};
+
+struct ThreadRing {
+  std::atomic_flag busy = ATOMIC_FLAG_INIT;
+  std::uint64_t generation = 0;
+  std::vector<std::optional<LogRecord>> slots;
+  std::size_t head = 0;
+  std::size_t count = 0;
+
+  void push(const LogRecord& record) {
+    SpinGuard guard(busy);
+    const std::size_t tail = (head + count) % slots.size();
+    slots[tail] = record;
+    if (count < slots.size()) {
+      ++count;
+    } else {
+      head = (head + 1) % slots.size();
+    }
+  }
+
+  void drain_into(std::vector<LogRecord>& out) {
+    SpinGuard guard(busy);
+    for (std::size_t i = 0; i < count; ++i) {
+      out.push_back(std::move(*slots[(head + i) % slots.size()]));
+    }
+    head = 0;
+    count = 0;
+  }
+};
+
+struct BacktraceState {
+  /// Protects target and rings.
+  std::mutex mutex;
+  std::shared_ptr<ISink> target;
+  std::vector<std::shared_ptr<ThreadRing>> rings;
+
+  /// Bumped on every enable/disable so threads re-register fresh rings.
+  std::atomic<std::uint64_t> generation{0};
+  std::atomic<std::size_t> capacity{0};
+  std::atomic<Level> trigger_level{Level::Error};
+};
+
+BacktraceState& state() {
+  static BacktraceState s;
+  return s;
+}
+
+thread_local std::shared_ptr<ThreadRing> tls_ring;
+
+void write_all(const std::shared_ptr<ISink>& target, const std::vector<LogRecord>& records) noexcept {
+  if (!target || records.empty()) {
+    return;
+  }
+  for (const auto& r : records) {
+    try {
+      target->write(r);
+    } catch (...) {
+      // Best-effort: a failing target must not affect the producer.
+    }
+  }
+  try {
+    target->flush();
+  } catch (...) {
+  }
+}
+
+}  // namespace
+
+void enable_backtrace(std::shared_ptr<ISink> target, BacktraceOptions options) {
+  if (!target) {
+    throw std::invalid_argument("enable_backtrace requires a target sink");
+  }
+  if (options.per_thread_capacity == 0) {
+    options.per_thread_capacity = 1;
+  }
+
+  auto& s = state();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  s.target = std::move(target);
+  s.rings.clear();
+  s.capacity.store(options.per_thread_capacity, std::memory_order_relaxed);
+  s.trigger_level.store(options.trigger_level, std::memory_order_relaxed);
+  s.generation.fetch_add(1, std::memory_order_release);
+  detail::backtrace_active_flag.store(true, std::memory_order_release);
+}
+
+void disable_backtrace() noexcept {
+  auto& s = state();
+  detail::backtrace_active_flag.store(false, std::memory_order_release);
+
+  std::lock_guard<std::mutex> lock(s.mutex);
+  s.target.reset();
+  s.rings.clear();
+  s.generation.fetch_add(1, std::memory_order_release);
+}
+
+void dump_backtrace() noexcept {
+  auto& s = state();
+
+  try {
+    std::vector<LogRecord> merged;
+    std::shared_ptr<ISink> target;
+    {
+      std::lock_guard<std::mutex> lock(s.mutex);
+      target = s.target;
+      for (const auto& ring : s.rings) {
+        ring->drain_into(merged);
+      }
+      // Rings referenced only by this list belong to threads that have exited.
+      s.rings.erase(std::remove_if(s.rings.begin(), s.rings.end(),
+                                   [](const auto& ring) { return ring.use_count() == 1; }),
+                    s.rings.end());
+    }
+
+    std::stable_sort(merged.begin(), merged.end(), [](const LogRecord& a, const LogRecord& b) {
+      return a.wall_time_ns() < b.wall_time_ns();
+    });
+    write_all(target, merged);
+  } catch (...) {
+    // Best-effort.
+  }
+}
+
+namespace detail {
+
+void backtrace_capture(const LogRecord& record) noexcept {
+  auto& s = state();
+
+  try {
+    const std::uint64_t gen = s.generation.load(std::memory_order_acquire);
+    if (!tls_ring || tls_ring->generation != gen) {
+      auto ring = std::make_shared<ThreadRing>();
+      ring->generation = gen;
+      ring->slots.resize(s.capacity.load(std::memory_order_relaxed));
+      if (ring->slots.empty()) {
+        return;  // disabled concurrently
+      }
+
+      std::lock_guard<std::mutex> lock(s.mutex);
+      if (s.generation.load(std::memory_order_relaxed) != gen) {
+        return;  // reconfigured concurrently; register on the next record
+      }
+      s.rings.push_back(ring);
+      tls_ring = std::move(ring);
+    }
+
+    tls_ring->push(record);
+  } catch (...) {
+    // Capture is best-effort (e.g. std::bad_alloc).
+  }
+}
+
+void backtrace_on_emit(const LogRecord& record) noexcept {
+  auto& s = state();
+  if (record.level() < s.trigger_level.load(std::memory_order_relaxed)) {
+    return;
+  }
+  if (!tls_ring || tls_ring->generation != s.generation.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  try {
+    std::vector<LogRecord> records;
+    tls_ring->drain_into(records);
+
+    std::shared_ptr<ISink> target;
+    {
+      std::lock_guard<std::mutex> lock(s.mutex);
+      target = s.target;
+    }
+    write_all(target, records);
+  } catch (...) {
+    // Best-effort.
+  }
+}
+
+}  // namespace detail
+
+}  // namespace sim_logger
@@ -0,0 +1,350 @@
+#include "logger/call_site.hpp"
+
+#include "logger/detail/name_glob.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace sim_logger {
+
+namespace detail {
+
+std::atomic<bool> g_call_site_profiling{false};
+
+/**
+ * @brief Global list of registered sites plus the rules applied to them.
+ *
+ * Intentionally leaked so sites that first run during static destruction can
+ * still register.
+ */
+struct CallSiteRegistry {
+  struct Rule {
+    std::string file;
+    unsigned first_line = 0;
+    unsigned last_line = std::numeric_limits<unsigned>::max();
+    CallSiteState state = CallSiteState::Default;
+  };
+
+  std::mutex m;
+  CallSite* head = nullptr;
+  CallSite* tail = nullptr;
+  std::vector<Rule> rules;
+
+  static CallSiteRegistry& instance() {
+    static auto* r = new CallSiteRegistry();
+    return *r;
+  }
+
+  static std::string_view basename(std::string_view path) noexcept {
+    const auto pos = path.find_last_of("/\\");
+    return (pos == std::string_view::npos) ? path : path.substr(pos + 1);
+  }
+
+  static bool matches(const Rule& rule, const CallSite& site) noexcept {
+    if (site.line_ < rule.first_line || site.line_ > rule.last_line) {
+      return false;
+    }
+    const std::string_view file = site.file_ != nullptr ? site.file_ : "";
+    return glob_match(rule.file, file) || glob_match(rule.file, basename(file));
+  }
+
+  // Caller holds m.
+  std::uint8_t state_for_locked(const CallSite& site) const noexcept {
+    CallSiteState state = CallSiteState::Default;
+    for (const auto& rule : rules) {
+      if (matches(rule, site)) {
+        state = rule.state;
+      }
+    }
+    return static_cast<std::uint8_t>(state);
+  }
+
+  static unsigned parse_line(std::string_view s, std::string_view spec) {
+    if (s.empty() || s.size() > 9 || s.find_first_not_of("0123456789") != std::string_view::npos) {
+      throw std::invalid_argument("invalid call-site line in '" + std::string(spec) + "'");
+    }
+    return static_cast<unsigned>(std::strtoul(std::string(s).c_str(), nullptr, 10));
+  }
+
+  static Rule parse_rule(std::string_view spec, CallSiteState state) {
+    Rule rule;
+    rule.state = state;
+
+    std::string_view file = spec;
+    const auto colon = spec.rfind(':');
+    if (colon != std::string_view::npos) {
+      const std::string_view lines = spec.substr(colon + 1);
+      // A colon followed by something other than a line range is part of the
+      // path (e.g. a Windows drive letter).
+      if (!lines.empty() && lines.find_first_not_of("0123456789-") == std::string_view::npos) {
+        file = spec.substr(0, colon);
+        const auto dash = lines.find('-');
+        if (dash == std::string_view::npos) {
+          rule.first_line = rule.last_line = parse_line(lines, spec);
+        } else {
+          rule.first_line = parse_line(lines.substr(0, dash), spec);
+          rule.last_line = parse_line(lines.substr(dash + 1), spec);
+          if (rule.first_line > rule.last_line) {
+            throw std::invalid_argument("empty call-site line range in '" + std::string(spec) + "'");
+          }
+        }
+      }
+    }
+    if (file.empty()) {
+      throw std::invalid_argument("call-site spec '" + std::string(spec) + "' has no file");
+    }
+    rule.file = std::string(file);
+    return rule;
+  }
+
+  std::size_t apply(Rule rule) {
+    std::lock_guard<std::mutex> lk(m);
+    std::size_t matched = 0;
+    for (CallSite* site = head; site != nullptr; site = site->next_) {
+      if (matches(rule, *site)) {
+        site->state_.store(static_cast<std::uint8_t>(rule.state), std::memory_order_relaxed);
+        ++matched;
+      }
+    }
+    rules.push_back(std::move(rule));
+    return matched;
+  }
+
+  void clear_rules() noexcept {
+    std::lock_guard<std::mutex> lk(m);
+    rules.clear();
+    for (CallSite* site = head; site != nullptr; site = site->next_) {
+      site->state_.store(static_cast<std::uint8_t>(CallSiteState::Default), std::memory_order_relaxed);
+    }
+  }
+
+  std::vector<CallSiteInfo> snapshot() {
+    std::lock_guard<std::mutex> lk(m);
+    std::vector<CallSiteInfo> out;
+    for (const CallSite* site = head; site != nullptr; site = site->next_) {
+      CallSiteInfo info;
+      info.file = site->file_ != nullptr ? site->file_ : "";
+      info.line = site->line_;
+      info.function = site->function_ != nullptr ? site->function_ : "";
+      info.level = site->level_;
+      info.state = static_cast<CallSiteState>(site->state_.load(std::memory_order_relaxed));
+      info.hits = site->hits_.load(std::memory_order_relaxed);
+      info.records = site->records_.load(std::memory_order_relaxed);
+      info.bytes = site->bytes_.load(std::memory_order_relaxed);
+      info.frontend_ns = site->frontend_ns_.load(std::memory_order_relaxed);
+      out.push_back(std::move(info));
+    }
+    return out;
+  }
+
+  void reset_profiles() noexcept {
+    std::lock_guard<std::mutex> lk(m);
+    for (CallSite* site = head; site != nullptr; site = site->next_) {
+      site->hits_.store(0, std::memory_order_relaxed);
+      site->records_.store(0, std::memory_order_relaxed);
+      site->bytes_.store(0, std::memory_order_relaxed);
+      site->frontend_ns_.store(0, std::memory_order_relaxed);
+    }
+  }
+};
+
+namespace {
+
+std::uint64_t order_key(const CallSiteInfo& info, CallSiteOrder order) noexcept {
+  switch (order) {
+    case CallSiteOrder::Records:
+      return info.records;
+    case CallSiteOrder::Bytes:
+      return info.bytes;
+    case CallSiteOrder::Time:
+      return info.frontend_ns;
+  }
+  return info.records;
+}
+
+/// Parameters of the exit-time report (set by report_call_sites_at_exit()).
+struct ExitReport {
+  std::mutex m;
+  bool registered = false;
+  std::size_t n = 0;
+  std::string path;
+
+  static ExitReport& instance() {
+    static auto* r = new ExitReport();
+    return *r;
+  }
+};
+
+void write_exit_report() noexcept {
+  try {
+    auto& er = ExitReport::instance();
+    std::size_t n = 0;
+    std::string path;
+    {
+      std::lock_guard<std::mutex> lk(er.m);
+      n = er.n;
+      path = er.path;
+    }
+    const std::string text = call_site_report(n, CallSiteOrder::Records) + "\n" +
+                             call_site_report(n, CallSiteOrder::Time);
+    std::FILE* out = path.empty() ? stderr : std::fopen(path.c_str(), "w");
+    if (out == nullptr) {
+      return;
+    }
+    std::fwrite(text.data(), 1, text.size(), out);
+    if (out != stderr) {
+      std::fclose(out);
+    } else {
+      std::fflush(out);
+    }
+  } catch (...) {
+    // Nothing sensible to do this late in shutdown.
+  }
+}
+
+}  // namespace
+
+}  // namespace detail
+
+using detail::CallSiteRegistry;
+
+std::string_view to_string(CallSiteState state) noexcept {
+  switch (state) {
+    case CallSiteState::Default:
+      return "default";
+    case CallSiteState::Enabled:
+      return "enabled";
+    case CallSiteState::Disabled:
+      return "disabled";
+  }
+  return "default";
+}
+
+std::string_view to_string(CallSiteOrder order) noexcept {
+  switch (order) {
+    case CallSiteOrder::Records:
+      return "records";
+    case CallSiteOrder::Bytes:
+      return "bytes";
+    case CallSiteOrder::Time:
+      return "time";
+  }
+  return "records";
+}
+
+std::optional<CallSiteOrder> call_site_order_from_string(std::string_view s) noexcept {
+  if (s == "records") {
+    return CallSiteOrder::Records;
+  }
+  if (s == "bytes") {
+    return CallSiteOrder::Bytes;
+  }
+  if (s == "time") {
+    return CallSiteOrder::Time;
+  }
+  return std::nullopt;
+}
+
+void set_call_site_profiling(bool enabled) noexcept {
+  detail::g_call_site_profiling.store(enabled, std::memory_order_relaxed);
+}
+
+std::uint8_t CallSite::register_(const char* function) noexcept {
+  auto& reg = CallSiteRegistry::instance();
+  std::lock_guard<std::mutex> lk(reg.m);
+
+  const std::uint8_t current = state_.load(std::memory_order_relaxed);
+  if (current != kUnregistered) {
+    return current;  // another thread registered it first
+  }
+
+  function_ = function;
+  if (reg.tail != nullptr) {
+    reg.tail->next_ = this;
+  } else {
+    reg.head = this;
+  }
+  reg.tail = this;
+
+  const std::uint8_t state = reg.state_for_locked(*this);
+  state_.store(state, std::memory_order_release);
+  return state;
+}
+
+std::size_t set_call_sites(std::string_view spec, CallSiteState state) {
+  return CallSiteRegistry::instance().apply(CallSiteRegistry::parse_rule(spec, state));
+}
+
+void clear_call_site_rules() noexcept { CallSiteRegistry::instance().clear_rules(); }
+
+std::vector<CallSiteInfo> call_sites() { return CallSiteRegistry::instance().snapshot(); }
+
+std::vector<CallSiteInfo> top_call_sites(std::size_t n, CallSiteOrder order) {
+  auto sites = call_sites();
+  sites.erase(std::remove_if(sites.begin(), sites.end(),
+                             [](const CallSiteInfo& s) { return s.records == 0; }),
+              sites.end());
+  // Stable, so ties keep registration order.
+  std::stable_sort(sites.begin(), sites.end(), [order](const CallSiteInfo& a, const CallSiteInfo& b) {
+    return detail::order_key(a, order) > detail::order_key(b, order);
+  });
+  if (sites.size() > n) {
+    sites.resize(n);
+  }
+  return sites;
+}
+
+void reset_call_site_profiles() noexcept { CallSiteRegistry::instance().reset_profiles(); }
+
+std::string call_site_report(std::size_t n, CallSiteOrder order) {
+  std::uint64_t total = 0;
+  std::uint64_t total_records = 0;
+  for (const auto& s : call_sites()) {
+    total += detail::order_key(s, order);
+    total_records += s.records;
+  }
+  const auto top = top_call_sites(n, order);
+
+  std::string out = "top " + std::to_string(top.size()) + " call sites by " +
+                    std::string(to_string(order)) + " (" + std::to_string(total_records) +
+                    " records profiled)\n";
+  char line[160];
+  std::snprintf(line, sizeof(line), "%12s %14s %12s %10s %7s %7s  %s\n", "records", "bytes",
+                "time_ms", "avg_ns", "share", "cum", "site");
+  out += line;
+
+  std::uint64_t cumulative = 0;
+  for (const auto& s : top) {
+    const std::uint64_t key = detail::order_key(s, order);
+    cumulative += key;
+    const double share = total == 0 ? 0.0 : 100.0 * static_cast<double>(key) / static_cast<double>(total);
+    const double cum =
+        total == 0 ? 0.0 : 100.0 * static_cast<double>(cumulative) / static_cast<double>(total);
+    std::snprintf(line, sizeof(line), "%12llu %14llu %12.3f %10llu %6.1f%% %6.1f%%  ",
+                  static_cast<unsigned long long>(s.records), static_cast<unsigned long long>(s.bytes),
+                  static_cast<double>(s.frontend_ns) / 1e6,
+                  static_cast<unsigned long long>(s.frontend_ns / s.records), share, cum);
+    out += line;
+    out += s.file + ":" + std::to_string(s.line) + " " + s.function + " [" +
+           std::string(to_string(s.level)) + "]\n";
+  }
+  return out;
+}
+
+void report_call_sites_at_exit(std::size_t n, std::string path) {
+  auto& er = detail::ExitReport::instance();
+  std::lock_guard<std::mutex> lk(er.m);
+  er.n = n;
+  er.path = std::move(path);
+  if (!er.registered) {
+    er.registered = true;
+    std::atexit([] { detail::write_exit_report(); });
+  }
+}
+
+}  // namespace sim_logger
@@ -0,0 +1,614 @@
+#include "logger/config.hpp"
+
+#include "logger/async_sink.hpp"
+#include "logger/console_sink.hpp"
+#include "logger/detail/name_glob.hpp"
+#include "logger/file_sink.hpp"
+#include "logger/logger.hpp"
+#include "logger/logger_registry.hpp"
+#include "logger/pattern_formatter.hpp"
+#include "logger/rotating_file_sink.hpp"
+
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <utility>
+
+namespace sim_logger {
+
+namespace {
+
+constexpr std::string_view kDefaultPattern = "{met} {level} {logger}: {msg}";
+
+std::string_view trim(std::string_view s) noexcept {
+  while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front())) != 0) {
+    s.remove_prefix(1);
+  }
+  while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back())) != 0) {
+    s.remove_suffix(1);
+  }
+  return s;
+}
+
+[[noreturn]] void fail(int line, const std::string& what) {
+  throw ConfigError(std::to_string(line) + ": " + what);
+}
+
+std::string lower(std::string_view s) {
+  std::string out(s);
+  for (char& c : out) {
+    c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  }
+  return out;
+}
+
+/// Remove a trailing comment introduced by '#' or ';' preceded by whitespace
+/// (so patterns like "{a};{b}" survive).
+std::string_view strip_comment(std::string_view s) noexcept {
+  for (std::size_t i = 0; i < s.size(); ++i) {
+    if ((s[i] == '#' || s[i] == ';') &&
+        (i == 0 || std::isspace(static_cast<unsigned char>(s[i - 1])) != 0)) {
+      return s.substr(0, i);
+    }
+  }
+  return s;
+}
+
+std::vector<std::string> split_list(std::string_view s) {
+  std::vector<std::string> out;
+  while (!s.empty()) {
+    const auto comma = s.find(',');
+    const auto item = trim(s.substr(0, comma));
+    if (!item.empty()) {
+      out.emplace_back(item);
+    }
+    s = (comma == std::string_view::npos) ? std::string_view{} : s.substr(comma + 1);
+  }
+  return out;
+}
+
+std::uint64_t parse_u64(int line, std::string_view key, std::string_view value) {
+  std::uint64_t out = 0;
+  const auto* end = value.data() + value.size();
+  const auto [ptr, ec] = std::from_chars(value.data(), end, out);
+  if (ec != std::errc{} || ptr != end) {
+    fail(line, "'" + std::string(key) + "' expects a non-negative integer, got '" +
+                   std::string(value) + "'");
+  }
+  return out;
+}
+
+bool parse_bool(int line, std::string_view key, std::string_view value) {
+  const std::string v = lower(value);
+  if (v == "true" || v == "yes" || v == "on" || v == "1") {
+    return true;
+  }
+  if (v == "false" || v == "no" || v == "off" || v == "0") {
+    return false;
+  }
+  fail(line, "'" + std::string(key) + "' expects a boolean, got '" + std::string(value) + "'");
+}
+
+Level parse_level(int line, std::string_view key, std::string_view value) {
+  const auto level = level_from_string(value);
+  if (!level) {
+    fail(line, "'" + std::string(key) + "' expects a level, got '" + std::string(value) + "'");
+  }
+  return *level;
+}
+
+OverflowPolicy parse_overflow(int line, std::string_view value) {
+  const std::string v = lower(value);
+  if (v == "block") {
+    return OverflowPolicy::Block;
+  }
+  if (v == "drop_newest") {
+    return OverflowPolicy::DropNewest;
+  }
+  if (v == "drop_oldest") {
+    return OverflowPolicy::DropOldest;
+  }
+  fail(line, "unknown overflow policy '" + std::string(value) + "'");
+}
+
+ConsoleSink::ColorMode parse_color(int line, std::string_view value) {
+  const std::string v = lower(value);
+  if (v == "auto") {
+    return ConsoleSink::ColorMode::Auto;
+  }
+  if (v == "always") {
+    return ConsoleSink::ColorMode::Always;
+  }
+  if (v == "never") {
+    return ConsoleSink::ColorMode::Never;
+  }
+  fail(line, "unknown color mode '" + std::string(value) + "'");
+}
+
+const std::set<std::string>& allowed_keys(const std::string& type) {
+  static const std::set<std::string> console{"level", "pattern", "color", "stream"};
+  static const std::set<std::string> file{"level", "pattern", "path", "durable_flush"};
+  static const std::set<std::string> rotating{"level",         "pattern",   "path",
+                                              "durable_flush", "max_bytes", "max_files"};
+  static const std::set<std::string> async{"level",          "target",    "capacity",
+                                           "overflow",       "max_batch", "priority_level",
+                                           "linger_us",      "min_batch", "format_threads"};
+  static const std::set<std::string> none;
+  if (type == "console") return console;
+  if (type == "file") return file;
+  if (type == "rotating") return rotating;
+  if (type == "async") return async;
+  return none;
+}
+
+/**
+ * @brief Typed accessors over a SinkSpec's options (all parse errors carry the line).
+ */
+class SinkOptions {
+ public:
+  explicit SinkOptions(const SinkSpec& spec) : spec_(spec) {}
+
+  std::optional<std::string_view> raw(const char* key) const {
+    const auto it = spec_.options.find(key);
+    if (it == spec_.options.end()) {
+      return std::nullopt;
+    }
+    return std::string_view(it->second);
+  }
+
+  std::string str(const char* key, std::string_view def) const {
+    return std::string(raw(key).value_or(def));
+  }
+
+  std::uint64_t u64(const char* key, std::uint64_t def) const {
+    const auto v = raw(key);
+    return v ? parse_u64(spec_.line, key, *v) : def;
+  }
+
+  bool boolean(const char* key, bool def) const {
+    const auto v = raw(key);
+    return v ? parse_bool(spec_.line, key, *v) : def;
+  }
+
+  std::optional<Level> level(const char* key) const {
+    const auto v = raw(key);
+    return v ? std::optional<Level>(parse_level(spec_.line, key, *v)) : std::nullopt;
+  }
+
+  std::string required(const char* key) const {
+    const auto v = raw(key);
+    if (!v || v->empty()) {
+      fail(spec_.line, "sink '" + spec_.name + "' requires '" + key + "'");
+    }
+    return std::string(*v);
+  }
+
+  AsyncOptions async_options() const {
+    AsyncOptions opt;
+    opt.capacity = static_cast<std::size_t>(u64("capacity", opt.capacity));
+    if (const auto v = raw("overflow")) {
+      opt.overflow_policy = parse_overflow(spec_.line, *v);
+    }
+    opt.max_batch = static_cast<std::size_t>(u64("max_batch", opt.max_batch));
+    opt.priority_level = level("priority_level");
+    opt.linger = std::chrono::microseconds(u64("linger_us", 0));
+    opt.min_batch = static_cast<std::size_t>(u64("min_batch", opt.min_batch));
+    opt.format_threads = static_cast<std::size_t>(u64("format_threads", opt.format_threads));
+    return opt;
+  }
+
+  ConsoleSink::ColorMode color() const {
+    const auto v = raw("color");
+    return v ? parse_color(spec_.line, *v) : ConsoleSink::ColorMode::Auto;
+  }
+
+  std::FILE* stream() const {
+    const std::string v = lower(raw("stream").value_or("stdout"));
+    if (v == "stdout") {
+      return stdout;
+    }
+    if (v == "stderr") {
+      return stderr;
+    }
+    fail(spec_.line, "unknown stream '" + v + "'");
+  }
+
+ private:
+  const SinkSpec& spec_;
+};
+
+/// Run every typed accessor once so bad values are reported by parse_config().
+void validate_sink_values(const SinkSpec& spec) {
+  const SinkOptions o(spec);
+  o.level("level");
+  if (spec.type == "console") {
+    o.color();
+    o.stream();
+  } else if (spec.type == "file" || spec.type == "rotating") {
+    o.required("path");
+    o.boolean("durable_flush", false);
+    if (spec.type == "rotating" && o.u64("max_bytes", 0) == 0) {
+      fail(spec.line, "sink '" + spec.name + "' requires 'max_bytes' > 0");
+    }
+    o.u64("max_files", 0);
+  } else {
+    o.required("target");
+    o.async_options();
+  }
+}
+
+const SinkSpec* find_sink(const ConfigSpec& spec, std::string_view name) {
+  for (const auto& s : spec.sinks) {
+    if (s.name == name) {
+      return &s;
+    }
+  }
+  return nullptr;
+}
+
+void validate_references(const ConfigSpec& spec) {
+  // Async targets must exist and must not form a cycle.
+  for (const auto& s : spec.sinks) {
+    if (s.type != "async") {
+      continue;
+    }
+    std::set<std::string> seen{s.name};
+    const SinkSpec* cur = &s;
+    while (cur->type == "async") {
+      const std::string& target = cur->options.at("target");
+      const SinkSpec* next = find_sink(spec, target);
+      if (next == nullptr) {
+        fail(cur->line, "sink '" + cur->name + "' targets unknown sink '" + target + "'");
+      }
+      if (!seen.insert(next->name).second) {
+        fail(s.line, "async sink '" + s.name + "' is part of a target cycle");
+      }
+      cur = next;
+    }
+  }
+
+  for (const auto& l : spec.loggers) {
+    if (!l.sinks) {
+      continue;
+    }
+    for (const auto& name : *l.sinks) {
+      if (find_sink(spec, name) == nullptr) {
+        fail(l.line, "logger '" + l.name + "' references unknown sink '" + name + "'");
+      }
+    }
+  }
+}
+
+std::string parent_of(std::string_view name) {
+  if (name.empty() || name == "root") {
+    return {};
+  }
+  while (!name.empty() && name.back() == '.') {
+    name.remove_suffix(1);
+  }
+  const auto pos = name.find_last_of('.');
+  if (pos == std::string_view::npos || pos == 0) {
+    return "root";
+  }
+  return std::string(name.substr(0, pos));
+}
+
+std::shared_ptr<ISink> build_sink(const ConfigSpec& spec,
+                                  const SinkSpec& s,
+                                  std::map<std::string, std::shared_ptr<ISink>>& built) {
+  if (const auto it = built.find(s.name); it != built.end()) {
+    return it->second;
+  }
+
+  const SinkOptions o(s);
+  std::shared_ptr<ISink> sink;
+  if (s.type == "console") {
+    sink = std::make_shared<ConsoleSink>(PatternFormatter(o.str("pattern", kDefaultPattern)),
+                                         o.color(), o.stream());
+  } else if (s.type == "file") {
+    sink = std::make_shared<FileSink>(o.required("path"),
+                                      PatternFormatter(o.str("pattern", kDefaultPattern)),
+                                      o.boolean("durable_flush", false));
+  } else if (s.type == "rotating") {
+    sink = std::make_shared<RotatingFileSink>(
+        o.required("path"), PatternFormatter(o.str("pattern", kDefaultPattern)),
+        o.u64("max_bytes", 0), o.boolean("durable_flush", false),
+        static_cast<std::size_t>(o.u64("max_files", 0)));
+  } else {
+    const SinkSpec* target = find_sink(spec, o.required("target"));
+    sink = std::make_shared<AsyncSink>(build_sink(spec, *target, built), o.async_options());
+  }
+
+  if (const auto level = o.level("level")) {
+    sink->set_level(*level);
+  }
+  built.emplace(s.name, sink);
+  return sink;
+}
+
+}  // namespace
+
+ConfigSpec parse_config(std::string_view text) {
+  ConfigSpec spec;
+
+  enum class Section { None, Registry, Sink, Logger };
+  Section section = Section::None;
+  std::set<std::string> sink_names;
+  std::set<std::string> logger_names;
+
+  int line_no = 0;
+  while (!text.empty()) {
+    ++line_no;
+    const auto nl = text.find('\n');
+    std::string_view line = text.substr(0, nl);
+    text = (nl == std::string_view::npos) ? std::string_view{} : text.substr(nl + 1);
+
+    line = trim(strip_comment(line));
+    if (line.empty()) {
+      continue;
+    }
+
+    if (line.front() == '[') {
+      if (line.back() != ']') {
+        fail(line_no, "unterminated section header");
+      }
+      const std::string_view header = trim(line.substr(1, line.size() - 2));
+      if (header == "registry") {
+        section = Section::Registry;
+      } else if (header.substr(0, 5) == "sink." && header.size() > 5) {
+        const std::string name(header.substr(5));
+        if (!sink_names.insert(name).second) {
+          fail(line_no, "duplicate sink '" + name + "'");
+        }
+        spec.sinks.push_back(SinkSpec{name, {}, {}, line_no});
+        section = Section::Sink;
+      } else if (header.substr(0, 7) == "logger." && header.size() > 7) {
+        const std::string name(header.substr(7));
+        if (!logger_names.insert(name).second) {
+          fail(line_no, "duplicate logger '" + name + "'");
+        }
+        LoggerSpec l;
+        l.name = name;
+        l.line = line_no;
+        spec.loggers.push_back(std::move(l));
+        section = Section::Logger;
+      } else {
+        fail(line_no, "unknown section '" + std::string(header) + "'");
+      }
+      continue;
+    }
+
+    const auto eq = line.find('=');
+    if (eq == std::string_view::npos) {
+      fail(line_no, "expected 'key = value'");
+    }
+    const std::string key = lower(trim(line.substr(0, eq)));
+    const std::string_view value = trim(line.substr(eq + 1));
+
+    switch (section) {
+      case Section::None:
+        fail(line_no, "key '" + key + "' outside of a section");
+      case Section::Registry:
+        if (key != "level_rules") {
+          fail(line_no, "unknown registry key '" + key + "'");
+        }
+        try {
+          LoggerRegistry::parse_level_rules(value);
+        } catch (const std::invalid_argument& e) {
+          fail(line_no, e.what());
+        }
+        spec.level_rules = std::string(value);
+        break;
+      case Section::Sink: {
+        auto& s = spec.sinks.back();
+        if (key == "type") {
+          s.type = lower(value);
+          if (allowed_keys(s.type).empty()) {
+            fail(line_no, "unknown sink type '" + std::string(value) + "'");
+          }
+        } else if (!s.options.emplace(key, std::string(value)).second) {
+          fail(line_no, "duplicate key '" + key + "'");
+        }
+        break;
+      }
+      case Section::Logger: {
+        auto& l = spec.loggers.back();
+        if (key == "level") {
+          l.level = parse_level(line_no, key, value);
+        } else if (key == "sinks") {
+          l.sinks = split_list(value);
+        } else if (key == "immediate_flush") {
+          l.immediate_flush = parse_bool(line_no, key, value);
+        } else {
+          fail(line_no, "unknown logger key '" + key + "'");
+        }
+        break;
+      }
+    }
+  }
+
+  for (const auto& s : spec.sinks) {
+    if (s.type.empty()) {
+      fail(s.line, "sink '" + s.name + "' requires 'type'");
+    }
+    const auto& allowed = allowed_keys(s.type);
+    for (const auto& [key, value] : s.options) {
+      if (allowed.count(key) == 0) {
+        fail(s.line, "sink '" + s.name + "' (" + s.type + ") does not accept '" + key + "'");
+      }
+    }
+    validate_sink_values(s);
+  }
+  validate_references(spec);
+
+  return spec;
+}
+
+ConfigSpec parse_config_file(const std::string& path) {
+  std::ifstream in(path);
+  if (!in) {
+    throw ConfigError("cannot read config file '" + path + "'");
+  }
+  std::ostringstream buf;
+  buf << in.rdbuf();
+  try {
+    return parse_config(buf.str());
+  } catch (const ConfigError& e) {
+    throw ConfigError(path + ":" + e.what());
+  }
+}
+
+AppliedConfig apply_config(const ConfigSpec& spec, LoggerRegistry& registry) {
+  AppliedConfig applied;
+  for (const auto& s : spec.sinks) {
+    build_sink(spec, s, applied.sinks);
+  }
+
+  if (spec.level_rules) {
+    registry.set_level_rules(*spec.level_rules);
+  }
+
+  for (const auto& l : spec.loggers) {
+    auto logger = registry.get_logger(l.name);
+    if (l.level) {
+      logger->set_level(*l.level);
+    }
+    if (l.sinks) {
+      std::vector<std::shared_ptr<ISink>> sinks;
+      for (const auto& name : *l.sinks) {
+        sinks.push_back(applied.sinks.at(name));
+      }
+      logger->set_sinks(std::move(sinks));
+    }
+    if (l.immediate_flush) {
+      logger->set_immediate_flush(*l.immediate_flush);
+    }
+  }
+
+  return applied;
+}
+
+std::string describe_config(const ConfigSpec& spec) {
+  std::ostringstream out;
+
+  out << "sinks:\n";
+  for (const auto& s : spec.sinks) {
+    const SinkOptions o(s);
+    out << "  " << s.name << " (" << s.type << ")";
+    if (const auto level = o.level("level")) {
+      out << " level=" << to_string(*level);
+    }
+    if (s.type == "console") {
+      out << " pattern=\"" << o.str("pattern", kDefaultPattern) << "\"";
+    } else if (s.type == "file" || s.type == "rotating") {
+      out << " path=" << o.required("path") << " pattern=\"" << o.str("pattern", kDefaultPattern)
+          << "\"";
+      if (s.type == "rotating") {
+        out << " max_bytes=" << o.u64("max_bytes", 0) << " max_files=" << o.u64("max_files", 0);
+      }
+    } else {
+      const AsyncOptions a = o.async_options();
+      out << " -> " << o.required("target") << " capacity=" << a.capacity << " overflow="
+          << (a.overflow_policy == OverflowPolicy::Block
+                  ? "block"
+                  : a.overflow_policy == OverflowPolicy::DropNewest ? "drop_newest"
+                                                                    : "drop_oldest")
+          << " max_batch=" << a.max_batch;
+      if (a.priority_level) {
+        out << " priority_level=" << to_string(*a.priority_level);
+      }
+      if (a.linger.count() > 0) {
+        out << " linger_us=" << a.linger.count() << " min_batch=" << a.min_batch;
+      }
+      if (a.format_threads > 0) {
+        out << " format_threads=" << a.format_threads;
+      }
+    }
+    out << "\n";
+  }
+
+  // Logger tree: configured loggers plus their implied ancestors.
+  std::map<std::string, const LoggerSpec*> by_name;
+  for (const auto& l : spec.loggers) {
+    by_name[l.name] = &l;
+  }
+  std::set<std::string> names{"root"};
+  for (const auto& l : spec.loggers) {
+    for (std::string n = l.name; !n.empty(); n = parent_of(n)) {
+      names.insert(n);
+    }
+  }
+
+  const auto rules = spec.level_rules ? LoggerRegistry::parse_level_rules(*spec.level_rules)
+                                      : std::vector<LevelRule>{};
+
+  std::map<std::string, std::vector<std::string>> children;
+  for (const auto& n : names) {
+    if (n != "root") {
+      children[parent_of(n)].push_back(n);
+    }
+  }
+
+  struct Resolved {
+    Level level;
+    std::string level_from;
+    std::vector<std::string> sinks;
+    std::string sinks_from;
+  };
+
+  out << "loggers:\n";
+  const auto emit = [&](const auto& self, const std::string& name, const Resolved& parent,
+                        int depth) -> void {
+    Resolved r = parent;
+    const auto it = by_name.find(name);
+    const LoggerSpec* l = (it != by_name.end()) ? it->second : nullptr;
+
+    std::optional<Level> rule_level;
+    for (auto ri = rules.rbegin(); ri != rules.rend(); ++ri) {
+      if (detail::glob_match(ri->pattern, name)) {
+        rule_level = ri->level;
+        break;
+      }
+    }
+
+    if (l != nullptr && l->level) {
+      r.level = *l->level;
+      r.level_from = "set";
+    } else if (rule_level) {
+      r.level = *rule_level;
+      r.level_from = "rule";
+    } else if (name != "root") {
+      r.level_from = "inherited";
+    }
+    if (l != nullptr && l->sinks) {
+      r.sinks = *l->sinks;
+      r.sinks_from = "set";
+    } else if (name != "root") {
+      r.sinks_from = "inherited";
+    }
+
+    out << std::string(static_cast<std::size_t>(2 + depth * 2), ' ') << name
+        << " level=" << to_string(r.level) << " (" << r.level_from << ") sinks=[";
+    for (std::size_t i = 0; i < r.sinks.size(); ++i) {
+      out << (i == 0 ? "" : ", ") << r.sinks[i];
+    }
+    out << "] (" << r.sinks_from << ")";
+    if (l != nullptr && l->immediate_flush) {
+      out << " immediate_flush=" << (*l->immediate_flush ? "true" : "false");
+    }
+    out << "\n";
+
+    for (const auto& child : children[name]) {
+      self(self, child, r, depth + 1);
+    }
+  };
+  emit(emit, "root", Resolved{Level::Info, "default", {}, "default"}, 0);
+
+  return out.str();
+}
+
+}  // namespace sim_logger
@@ -51,8 +51,10 @@ ConsoleSink::ConsoleSink(PatternFormatter formatter, ColorMode color_mode, std::
 }
 
 void ConsoleSink::write(const LogRecord& record) {
-  const std::string line = formatter_.format(record);
+  write_formatted(record, formatter_.format(record));
+}
 
+void ConsoleSink::write_formatted(const LogRecord& record, std::string_view line) {
   std::lock_guard<std::mutex> lock(mu_);
 
   const bool colorize = should_colorize_locked();
@@ -62,7 +64,7 @@ void ConsoleSink::write(const LogRecord& record) {
     }
   }
 
-  write_all_or_throw(stream_, line.c_str(), line.size());
+  write_all_or_throw(stream_, line.data(), line.size());
 
   // Always terminate with a newline (pattern strings typically omit it).
   if (line.empty() || line.back() != '\n') {
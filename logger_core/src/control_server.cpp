@@ -0,0 +1,542 @@
+#include "logger/control_server.hpp"
+
+#include "logger/async_sink.hpp"
+#include "logger/backtrace.hpp"
+#include "logger/call_site.hpp"
+#include "logger/detail/name_glob.hpp"
+#include "logger/flight_recorder_sink.hpp"
+#include "logger/logger.hpp"
+#include "logger/logger_registry.hpp"
+#include "logger/metrics.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#if !defined(_WIN32) && !defined(MSG_NOSIGNAL)
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace sim_logger {
+
+namespace {
+
+/// Upper bound on a command line; longer input is rejected.
+constexpr std::size_t kMaxCommand = 4096;
+
+/// How long a connected client may take to send its command.
+constexpr int kClientTimeoutMs = 1000;
+
+std::vector<std::string> split_words(std::string_view s) {
+  std::vector<std::string> out;
+  std::size_t i = 0;
+  while (i < s.size()) {
+    while (i < s.size() && (s[i] == ' ' || s[i] == '\t' || s[i] == '\r' || s[i] == '\n')) {
+      ++i;
+    }
+    const std::size_t start = i;
+    while (i < s.size() && s[i] != ' ' && s[i] != '\t' && s[i] != '\r' && s[i] != '\n') {
+      ++i;
+    }
+    if (i > start) {
+      out.emplace_back(s.substr(start, i - start));
+    }
+  }
+  return out;
+}
+
+constexpr const char* kHelp =
+    "ok commands: level <glob> <level|reset>, levels, site <file[:lines]> <on|off|default>, "
+    "sites, profile <on|off|reset>, hot [n] [records|bytes|time], flush, metrics [prometheus], stats [glob], dump [name|backtrace], help";
+
+}  // namespace
+
+ControlServer::ControlServer(std::string socket_path)
+    : ControlServer(std::move(socket_path), LoggerRegistry::instance()) {}
+
+ControlServer::ControlServer(std::string socket_path, LoggerRegistry& registry)
+    : socket_path_(std::move(socket_path)), registry_(registry) {}
+
+ControlServer::~ControlServer() { stop(); }
+
+void ControlServer::register_sink(std::string name, std::shared_ptr<ISink> sink) {
+  if (!sink) {
+    throw std::invalid_argument("ControlServer::register_sink requires a sink");
+  }
+  std::lock_guard<std::mutex> lk(sinks_mutex_);
+  sinks_[std::move(name)] = std::move(sink);
+}
+
+std::string ControlServer::execute(std::string_view command) noexcept {
+  try {
+    const auto words = split_words(command);
+    if (words.empty() || words[0] == "help") {
+      return kHelp;
+    }
+    const std::string& cmd = words[0];
+
+    if (cmd == "level") {
+      if (words.size() != 3) {
+        return "error: usage: level <glob> <level|reset>";
+      }
+      const std::string& glob = words[1];
+      const bool reset = words[2] == "reset";
+      std::optional<Level> level;
+      if (!reset) {
+        level = level_from_string(words[2]);
+        if (!level) {
+          return "error: unknown level '" + words[2] + "'";
+        }
+      }
+
+      std::lock_guard<std::mutex> lk(levels_mutex_);
+      auto rules = registry_.level_rules();
+      rules.erase(std::remove_if(rules.begin(), rules.end(),
+                                 [&](const LevelRule& r) { return r.pattern == glob; }),
+                  rules.end());
+      if (level) {
+        rules.push_back(LevelRule{glob, *level});
+      }
+
+      const auto loggers = registry_.loggers();
+      std::vector<Level> before;
+      before.reserve(loggers.size());
+      for (const auto& logger : loggers) {
+        before.push_back(logger->effective_level());
+      }
+
+      // Rules rank below set_level(). Suspend explicit levels (from code or a
+      // config file) on matching loggers so the rule takes effect, and keep them
+      // so `reset` can put them back.
+      std::size_t suspended = 0;
+      std::size_t restored = 0;
+      if (!reset) {
+        auto& saved = suspended_levels_[glob];
+        for (const auto& logger : loggers) {
+          if (!detail::glob_match(glob, logger->name())) {
+            continue;
+          }
+          if (const auto explicit_level = logger->level_override()) {
+            saved.emplace_back(logger, *explicit_level);
+            logger->clear_level_override();
+            ++suspended;
+          }
+        }
+        if (saved.empty()) {
+          suspended_levels_.erase(glob);
+        }
+        registry_.set_level_rules(std::move(rules));
+      } else {
+        // Restore before dropping the rule so the logger never passes through
+        // its inherited level.
+        const auto it = suspended_levels_.find(glob);
+        if (it != suspended_levels_.end()) {
+          for (const auto& [weak, saved_level] : it->second) {
+            // A level set explicitly since the rule was added wins over the saved one.
+            const auto logger = weak.lock();
+            if (logger && !logger->level_override()) {
+              logger->set_level(saved_level);
+              ++restored;
+            }
+          }
+          suspended_levels_.erase(it);
+        }
+        registry_.set_level_rules(std::move(rules));
+      }
+
+      std::size_t changed = 0;
+      for (std::size_t i = 0; i < loggers.size(); ++i) {
+        changed += (loggers[i]->effective_level() != before[i]) ? 1U : 0U;
+      }
+      std::string reply = "ok changed " + std::to_string(changed) + " loggers";
+      if (suspended > 0) {
+        reply += ", suspended " + std::to_string(suspended) + " explicit levels";
+      }
+      if (restored > 0) {
+        reply += ", restored " + std::to_string(restored) + " explicit levels";
+      }
+      return reply;
+    }
+
+    if (cmd == "levels") {
+      std::string out = "ok";
+      for (const auto& r : registry_.level_rules()) {
+        out += "\n" + r.pattern + "=" + std::string(to_string(r.level));
+      }
+      return out;
+    }
+
+    if (cmd == "site") {
+      if (words.size() != 3) {
+        return "error: usage: site <file[:lines]> <on|off|default>";
+      }
+      CallSiteState state = CallSiteState::Default;
+      if (words[2] == "on") {
+        state = CallSiteState::Enabled;
+      } else if (words[2] == "off") {
+        state = CallSiteState::Disabled;
+      } else if (words[2] != "default") {
+        return "error: unknown call-site state '" + words[2] + "'";
+      }
+      const std::size_t matched = set_call_sites(words[1], state);
+      return "ok matched " + std::to_string(matched) + " sites";
+    }
+
+    if (cmd == "sites") {
+      std::ostringstream out;
+      out << "ok";
+      for (const auto& site : call_sites()) {
+        out << "\n" << site.file << ":" << site.line << " " << site.function << " "
+            << to_string(site.level) << " " << to_string(site.state) << " hits=" << site.hits;
+      }
+      return out.str();
+    }
+
+    if (cmd == "profile") {
+      if (words.size() != 2) {
+        return "error: usage: profile <on|off|reset>";
+      }
+      if (words[1] == "on") {
+        set_call_site_profiling(true);
+      } else if (words[1] == "off") {
+        set_call_site_profiling(false);
+      } else if (words[1] == "reset") {
+        reset_call_site_profiles();
+      } else {
+        return "error: usage: profile <on|off|reset>";
+      }
+      return "ok";
+    }
+
+    if (cmd == "hot") {
+      std::size_t n = 10;
+      CallSiteOrder order = CallSiteOrder::Records;
+      for (std::size_t i = 1; i < words.size(); ++i) {
+        if (const auto o = call_site_order_from_string(words[i])) {
+          order = *o;
+        } else if (!words[i].empty() && words[i].size() <= 6 &&
+                   words[i].find_first_not_of("0123456789") == std::string::npos) {
+          n = static_cast<std::size_t>(std::stoul(words[i]));
+        } else {
+          return "error: usage: hot [n] [records|bytes|time]";
+        }
+      }
+      return "ok\n" + call_site_report(n, order);
+    }
+
+    if (cmd == "flush") {
+      std::set<ISink*> seen;
+      std::vector<std::shared_ptr<ISink>> sinks;
+      for (const auto& logger : registry_.loggers()) {
+        for (auto& s : logger->effective_sinks()) {
+          if (seen.insert(s.get()).second) {
+            sinks.push_back(std::move(s));
+          }
+        }
+      }
+      {
+        std::lock_guard<std::mutex> lk(sinks_mutex_);
+        for (const auto& [name, s] : sinks_) {
+          if (seen.insert(s.get()).second) {
+            sinks.push_back(s);
+          }
+        }
+      }
+      std::size_t failures = 0;
+      for (const auto& s : sinks) {
+        try {
+          s->flush();
+        } catch (...) {
+          ++failures;
+        }
+      }
+      return "ok flushed " + std::to_string(sinks.size()) + " sinks" +
+             (failures > 0 ? ", " + std::to_string(failures) + " failed" : "");
+    }
+
+    if (cmd == "metrics") {
+      if (words.size() > 1) {
+        if (words[1] != "prometheus") {
+          return "error: usage: metrics [prometheus]";
+        }
+        return "ok\n" + to_prometheus(MetricsRegistry::instance().snapshot());
+      }
+      std::ostringstream out;
+      out << "ok";
+      for (const auto& logger : registry_.loggers()) {
+        out << "\nlogger " << logger->name() << " level=" << to_string(logger->effective_level())
+            << " dropped=" << logger->dropped_records_count()
+            << " sink_failures=" << logger->sink_failures_count();
+      }
+      std::lock_guard<std::mutex> lk(sinks_mutex_);
+      for (const auto& [name, s] : sinks_) {
+        out << "\nsink " << name;
+        if (const auto* a = dynamic_cast<const AsyncSink*>(s.get())) {
+          out << " dropped=" << a->dropped_records_count()
+              << " sink_failures=" << a->sink_failures_count()
+              << " priority_flushes=" << a->priority_flushes_count();
+        } else if (const auto* f = dynamic_cast<const FlightRecorderSink*>(s.get())) {
+          out << " retained=" << f->size() << " dumps=" << f->dumps_count()
+              << " sink_failures=" << f->sink_failures_count();
+        }
+      }
+      return out.str();
+    }
+
+    if (cmd == "stats") {
+      const std::string pattern = (words.size() > 1) ? words[1] : std::string("*");
+      const auto line = [](std::ostringstream& out, const LoggerStats& s) {
+        out << " emitted=" << s.emitted_total() << " filtered=" << s.filtered_total()
+            << " bytes=" << s.bytes;
+        for (std::size_t i = 0; i < kLevelCount; ++i) {
+          out << " " << to_string(static_cast<Level>(i)) << "=" << s.emitted[i] << "/"
+              << s.filtered[i];
+        }
+      };
+      std::ostringstream out;
+      out << "ok";
+      LoggerStats total;
+      for (const auto& s : registry_.logger_stats(pattern)) {
+        out << "\nlogger " << s.name;
+        line(out, s);
+        total += s;
+      }
+      out << "\ntotal " << pattern;
+      line(out, total);
+      return out.str();
+    }
+
+    if (cmd == "dump") {
+      const std::string which = (words.size() > 1) ? words[1] : std::string();
+      std::size_t dumped = 0;
+      if (which.empty() || which == "backtrace") {
+        dump_backtrace();
+      }
+      if (which != "backtrace") {
+        std::lock_guard<std::mutex> lk(sinks_mutex_);
+        for (const auto& [name, s] : sinks_) {
+          if (!which.empty() && name != which) {
+            continue;
+          }
+          if (auto* f = dynamic_cast<FlightRecorderSink*>(s.get())) {
+            f->dump();
+            ++dumped;
+          }
+        }
+        if (!which.empty() && dumped == 0) {
+          return "error: no flight recorder named '" + which + "'";
+        }
+      }
+      return "ok dumped " + std::to_string(dumped) + " flight recorders";
+    }
+
+    return "error: unknown command '" + cmd + "'";
+  } catch (const std::exception& e) {
+    return std::string("error: ") + e.what();
+  } catch (...) {
+    return "error: internal failure";
+  }
+}
+
+#if defined(_WIN32)
+
+void ControlServer::start() {
+  throw std::runtime_error("ControlServer requires Unix domain sockets");
+}
+
+void ControlServer::stop() noexcept {}
+
+void ControlServer::serve_() noexcept {}
+
+void ControlServer::handle_client_(int) noexcept {}
+
+#else
+
+void ControlServer::start() {
+  if (running_.load(std::memory_order_acquire)) {
+    throw std::runtime_error("ControlServer already running");
+  }
+  if (socket_path_.empty()) {
+    throw std::runtime_error("ControlServer socket path is empty");
+  }
+
+  // Only ever replace a stale socket; a mistyped path must not delete a file.
+  struct stat existing {};
+  if (::lstat(socket_path_.c_str(), &existing) == 0) {
+    if (!S_ISSOCK(existing.st_mode)) {
+      throw std::runtime_error("ControlServer socket path '" + socket_path_ +
+                               "' exists and is not a socket");
+    }
+  } else if (errno != ENOENT) {
+    const int err = errno;
+    throw std::runtime_error("ControlServer cannot stat '" + socket_path_ +
+                             "': " + std::strerror(err));
+  }
+
+  // bind() creates the socket file with the process umask, which this library
+  // must not change. Bind inside a private 0700 directory next to the target
+  // instead, narrow the socket to 0600 there, then rename it into place.
+  const std::size_t slash = socket_path_.rfind('/');
+  const std::string dir = (slash == std::string::npos) ? std::string(".")
+                          : (slash == 0)               ? std::string("/")
+                                                       : socket_path_.substr(0, slash);
+  std::string staging_dir = dir + "/.ctlXXXXXX";
+  std::string staging_path = staging_dir + "/s";
+
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  if (socket_path_.size() >= sizeof(addr.sun_path) ||
+      staging_path.size() >= sizeof(addr.sun_path)) {
+    throw std::runtime_error("ControlServer socket path is too long");
+  }
+
+  bool staged = false;
+  const auto fail = [&](const char* what) {
+    const int err = errno;
+    if (listen_fd_ >= 0) {
+      ::close(listen_fd_);
+      listen_fd_ = -1;
+    }
+    for (int& fd : wake_pipe_) {
+      if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+      }
+    }
+    if (staged) {
+      ::unlink(staging_path.c_str());
+      ::rmdir(staging_dir.c_str());
+    }
+    throw std::runtime_error(std::string("ControlServer ") + what + ": " + std::strerror(err));
+  };
+
+  if (::pipe(wake_pipe_) != 0) {
+    fail("pipe failed");
+  }
+  listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listen_fd_ < 0) {
+    fail("socket failed");
+  }
+  ::fcntl(listen_fd_, F_SETFD, FD_CLOEXEC);
+
+  if (::mkdtemp(staging_dir.data()) == nullptr) {
+    fail("mkdtemp failed");
+  }
+  staged = true;
+  staging_path = staging_dir + "/s";
+  std::memcpy(addr.sun_path, staging_path.c_str(), staging_path.size() + 1);
+
+  if (::bind(listen_fd_, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) {
+    fail("bind failed");
+  }
+  if (::chmod(staging_path.c_str(), S_IRUSR | S_IWUSR) != 0) {
+    fail("chmod failed");
+  }
+  if (::listen(listen_fd_, 4) != 0) {
+    fail("listen failed");
+  }
+  // Atomically replaces a stale socket from a previous run.
+  if (::rename(staging_path.c_str(), socket_path_.c_str()) != 0) {
+    fail("rename failed");
+  }
+  ::rmdir(staging_dir.c_str());
+
+  running_.store(true, std::memory_order_release);
+  thread_ = std::thread([this] { serve_(); });
+}
+
+void ControlServer::stop() noexcept {
+  if (!running_.exchange(false, std::memory_order_acq_rel)) {
+    return;
+  }
+  const char b = 0;
+  (void)!::write(wake_pipe_[1], &b, 1);
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+
+  ::close(listen_fd_);
+  listen_fd_ = -1;
+  for (int& fd : wake_pipe_) {
+    ::close(fd);
+    fd = -1;
+  }
+  struct stat st {};
+  if (::lstat(socket_path_.c_str(), &st) == 0 && S_ISSOCK(st.st_mode)) {
+    ::unlink(socket_path_.c_str());
+  }
+}
+
+void ControlServer::serve_() noexcept {
+  for (;;) {
+    pollfd fds[2] = {{listen_fd_, POLLIN, 0}, {wake_pipe_[0], POLLIN, 0}};
+    if (::poll(fds, 2, -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return;
+    }
+    if ((fds[1].revents & POLLIN) != 0) {
+      return;
+    }
+    if ((fds[0].revents & POLLIN) != 0) {
+      const int client = ::accept(listen_fd_, nullptr, nullptr);
+      if (client >= 0) {
+        handle_client_(client);
+        ::close(client);
+      }
+    }
+  }
+}
+
+void ControlServer::handle_client_(int fd) noexcept {
+  std::string command;
+  char buf[256];
+  while (command.find('\n') == std::string::npos && command.size() <= kMaxCommand) {
+    pollfd p{fd, POLLIN, 0};
+    if (::poll(&p, 1, kClientTimeoutMs) <= 0) {
+      return;
+    }
+    const ssize_t n = ::read(fd, buf, sizeof(buf));
+    if (n <= 0) {
+      break;  // EOF without newline: treat what we have as the command
+    }
+    command.append(buf, static_cast<std::size_t>(n));
+  }
+
+  std::string reply;
+  if (command.size() > kMaxCommand) {
+    reply = "error: command too long";
+  } else {
+    reply = execute(std::string_view(command).substr(0, command.find('\n')));
+  }
+  reply.push_back('\n');
+
+  std::size_t off = 0;
+  while (off < reply.size()) {
+    const ssize_t n = ::send(fd, reply.data() + off, reply.size() - off, MSG_NOSIGNAL);
+    if (n <= 0) {
+      return;
+    }
+    off += static_cast<std::size_t>(n);
+  }
+}
+
+#endif
+
+}  // namespace sim_logger
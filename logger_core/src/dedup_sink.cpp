@@ -0,0 +1,155 @@
+#include "logger/dedup_sink.hpp"
+
+#include "logger/metrics.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace sim_logger {
+namespace {
+
+constexpr std::uint64_t kFnvOffset = 14695981039346656037ULL;
+constexpr std::uint64_t kFnvPrime = 1099511628211ULL;
+
+std::uint64_t fnv1a(std::string_view s, std::uint64_t h = kFnvOffset) noexcept {
+  for (const char c : s) {
+    h ^= static_cast<unsigned char>(c);
+    h *= kFnvPrime;
+  }
+  return h;
+}
+
+std::uint64_t site_key(const LogRecord& record) noexcept {
+  std::uint64_t h = fnv1a(record.logger_name());
+  h = fnv1a(record.file(), h ^ 0xff);
+  return (h ^ record.line()) * kFnvPrime;
+}
+
+std::uint64_t message_key(const LogRecord& record) noexcept {
+  return fnv1a(record.message(), kFnvOffset ^ static_cast<std::uint64_t>(record.level()));
+}
+
+std::atomic<std::uint64_t> g_dedup_sink_seq{0};
+
+}  // namespace
+
+DedupSink::DedupSink(std::shared_ptr<ISink> wrapped, DedupOptions options)
+    : wrapped_(std::move(wrapped)), options_(options) {
+  if (!wrapped_) {
+    throw std::invalid_argument("DedupSink requires a wrapped sink");
+  }
+  if (options_.metrics_name.empty()) {
+    options_.metrics_name = "dedup-" + std::to_string(g_dedup_sink_seq.fetch_add(1) + 1);
+  }
+
+  metrics_collector_id_ = MetricsRegistry::instance().add_collector([this](MetricsSnapshot& out) {
+    MetricSample suppressed;
+    suppressed.name = "sim_logger_dedup_suppressed_records_total";
+    suppressed.labels = {{"sink", options_.metrics_name}};
+    suppressed.type = MetricType::Counter;
+    suppressed.help = "Records suppressed by a DedupSink as repeats";
+    suppressed.value = static_cast<double>(suppressed_records_count());
+    out.push_back(std::move(suppressed));
+
+    MetricSample sites;
+    sites.name = "sim_logger_dedup_tracked_sites";
+    sites.labels = {{"sink", options_.metrics_name}};
+    sites.type = MetricType::Gauge;
+    sites.help = "Call sites tracked by a DedupSink";
+    sites.value = static_cast<double>(tracked_sites_count());
+    out.push_back(std::move(sites));
+  });
+}
+
+DedupSink::~DedupSink() {
+  MetricsRegistry::instance().remove_collector(metrics_collector_id_);
+  // A run still being counted would otherwise vanish at shutdown; its summary
+  // is often the last trace of a flood of repeats.
+  try {
+    for (const auto& s : take_summaries_()) {
+      wrapped_->write(s);
+    }
+    wrapped_->flush();
+  } catch (...) {
+    // Destructors must not throw; the wrapped sink's failure is not recoverable here.
+  }
+}
+
+LogRecord DedupSink::make_summary_(const LogRecord& last, std::uint64_t repeats) {
+  return LogRecord(last.level(),
+                   last.sim_time(),
+                   last.mission_elapsed(),
+                   last.wall_time_ns(),
+                   last.thread_id(),
+                   std::string(last.file()),
+                   last.line(),
+                   std::string(last.function()),
+                   std::string(last.logger_name()),
+                   last.tags(),
+                   "last message repeated " + std::to_string(repeats) + " times");
+}
+
+void DedupSink::write(const LogRecord& record) {
+  const std::uint64_t key = site_key(record);
+  const std::uint64_t msg = message_key(record);
+
+  std::optional<LogRecord> summary;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto [it, inserted] = sites_.try_emplace(key);
+    SiteState& site = it->second;
+
+    const bool within_window =
+        (record.wall_time_ns() - site.first_wall_time_ns) < options_.window.count();
+    if (!inserted && site.message_hash == msg && within_window) {
+      ++site.repeats;
+      site.last = record;
+      suppressed_records_count_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+
+    if (site.repeats > 0) {
+      summary = make_summary_(*site.last, site.repeats);
+    }
+    site.message_hash = msg;
+    site.first_wall_time_ns = record.wall_time_ns();
+    site.repeats = 0;
+  }
+
+  if (summary) {
+    wrapped_->write(*summary);
+  }
+  wrapped_->write(record);
+}
+
+std::size_t DedupSink::tracked_sites_count() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return sites_.size();
+}
+
+bool DedupSink::should_log(const LogRecord& record) const noexcept {
+  return ISink::should_log(record) && wrapped_->should_log(record);
+}
+
+std::vector<LogRecord> DedupSink::take_summaries_() {
+  std::vector<LogRecord> summaries;
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& [key, site] : sites_) {
+    if (site.repeats > 0) {
+      summaries.push_back(make_summary_(*site.last, site.repeats));
+      site.repeats = 0;
+    }
+  }
+  return summaries;
+}
+
+void DedupSink::flush() {
+  for (const auto& s : take_summaries_()) {
+    wrapped_->write(s);
+  }
+  wrapped_->flush();
+}
+
+}  // namespace sim_logger
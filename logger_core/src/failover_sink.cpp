@@ -0,0 +1,222 @@
+#include "logger/failover_sink.hpp"
+
+#include "logger/metrics.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+namespace sim_logger {
+
+namespace {
+
+std::atomic<std::uint64_t> g_failover_sink_seq{0};
+
+}  // namespace
+
+FailoverSink::FailoverSink(std::shared_ptr<ISink> primary,
+                           std::shared_ptr<ISink> secondary,
+                           FailoverOptions options)
+    : primary_(std::move(primary)), secondary_(std::move(secondary)), options_(options) {
+  if (!primary_ || !secondary_) {
+    throw std::invalid_argument("FailoverSink requires primary and secondary sinks");
+  }
+  if (options_.max_consecutive_failures == 0) {
+    options_.max_consecutive_failures = 1;
+  }
+  if (options_.metrics_name.empty()) {
+    options_.metrics_name = "failover-" + std::to_string(g_failover_sink_seq.fetch_add(1) + 1);
+  }
+
+  metrics_collector_id_ = MetricsRegistry::instance().add_collector([this](MetricsSnapshot& out) {
+    const auto sample = [&](const char* name, MetricType type, const char* help, MetricLabels labels,
+                            double v) {
+      MetricSample s;
+      s.name = name;
+      s.labels = std::move(labels);
+      s.type = type;
+      s.help = help;
+      s.value = v;
+      out.push_back(std::move(s));
+    };
+    const std::string& sink = options_.metrics_name;
+    const char* switches_help = "FailoverSink switches between primary and secondary";
+    sample("sim_logger_failover_switches_total", MetricType::Counter, switches_help,
+           {{"sink", sink}, {"direction", "failover"}}, static_cast<double>(failovers_count()));
+    sample("sim_logger_failover_switches_total", MetricType::Counter, switches_help,
+           {{"sink", sink}, {"direction", "failback"}}, static_cast<double>(failbacks_count()));
+    sample("sim_logger_failover_primary_errors_total", MetricType::Counter,
+           "FailoverSink primary writes/flushes that threw", {{"sink", sink}},
+           static_cast<double>(primary_errors_count()));
+    sample("sim_logger_failover_primary_slow_writes_total", MetricType::Counter,
+           "FailoverSink primary writes/flushes slower than max_write_latency", {{"sink", sink}},
+           static_cast<double>(primary_slow_writes_count()));
+    sample("sim_logger_failover_secondary_failures_total", MetricType::Counter,
+           "FailoverSink secondary writes/flushes that threw", {{"sink", sink}},
+           static_cast<double>(secondary_failures_count()));
+    sample("sim_logger_failover_on_secondary", MetricType::Gauge,
+           "1 while the FailoverSink writes to its secondary", {{"sink", sink}},
+           on_secondary() ? 1.0 : 0.0);
+  });
+}
+
+FailoverSink::~FailoverSink() { MetricsRegistry::instance().remove_collector(metrics_collector_id_); }
+
+std::int64_t FailoverSink::now_ns_() noexcept {
+  using clock = std::chrono::steady_clock;
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now().time_since_epoch())
+      .count();
+}
+
+template <typename Op>
+FailoverSink::Outcome FailoverSink::timed_primary_(Op&& op) noexcept {
+  const std::int64_t start = now_ns_();
+  // Claim a free watchdog slot; when all are taken, older calls are already tracked.
+  std::atomic<std::int64_t>* slot = nullptr;
+  for (auto& candidate : primary_inflight_since_ns_) {
+    std::int64_t expected = 0;
+    if (candidate.compare_exchange_strong(expected, start == 0 ? 1 : start,
+                                          std::memory_order_acq_rel)) {
+      slot = &candidate;
+      break;
+    }
+  }
+
+  Outcome outcome = Outcome::Ok;
+  try {
+    op();
+  } catch (...) {
+    outcome = Outcome::Error;
+  }
+
+  const std::int64_t elapsed = now_ns_() - start;
+  if (slot != nullptr) {
+    slot->store(0, std::memory_order_release);
+  }
+
+  const auto max_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          options_.max_write_latency)
+                          .count();
+  if (outcome == Outcome::Ok && elapsed > max_ns) {
+    outcome = Outcome::Slow;
+  }
+  return outcome;
+}
+
+bool FailoverSink::primary_hung_(std::int64_t now) const noexcept {
+  const auto max_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          options_.max_write_latency)
+                          .count();
+  for (const auto& slot : primary_inflight_since_ns_) {
+    const std::int64_t since = slot.load(std::memory_order_acquire);
+    if (since != 0 && (now - since) > max_ns) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void FailoverSink::note_bad_primary_(Outcome outcome) noexcept {
+  if (outcome == Outcome::Error) {
+    primary_errors_count_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    primary_slow_writes_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  const std::uint32_t bad = consecutive_bad_.fetch_add(1, std::memory_order_acq_rel) + 1;
+  if (bad >= options_.max_consecutive_failures) {
+    fail_over_();
+  }
+}
+
+void FailoverSink::fail_over_() noexcept {
+  if (on_secondary_.exchange(true, std::memory_order_acq_rel)) {
+    return;
+  }
+  consecutive_bad_.store(0, std::memory_order_relaxed);
+  next_probe_ns_.store(now_ns_() + std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                       options_.probe_interval)
+                                       .count(),
+                       std::memory_order_relaxed);
+  failovers_count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FailoverSink::write_secondary_(const LogRecord& record) noexcept {
+  try {
+    secondary_->write(record);
+  } catch (...) {
+    secondary_failures_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void FailoverSink::write(const LogRecord& record) {
+  if (!on_secondary()) {
+    if (primary_hung_(now_ns_())) {
+      // Another thread is stuck in the primary; do not queue up behind it.
+      primary_slow_writes_count_.fetch_add(1, std::memory_order_relaxed);
+      fail_over_();
+      write_secondary_(record);
+      return;
+    }
+
+    const Outcome outcome = timed_primary_([&] { primary_->write(record); });
+    if (outcome == Outcome::Ok) {
+      consecutive_bad_.store(0, std::memory_order_relaxed);
+      return;
+    }
+    note_bad_primary_(outcome);
+    if (outcome == Outcome::Error) {
+      write_secondary_(record);
+    }
+    return;
+  }
+
+  // On the secondary: let one caller per interval probe the primary.
+  const std::int64_t now = now_ns_();
+  std::int64_t due = next_probe_ns_.load(std::memory_order_relaxed);
+  const auto interval_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(options_.probe_interval).count();
+  if (now >= due && !primary_hung_(now) &&
+      next_probe_ns_.compare_exchange_strong(due, now + interval_ns, std::memory_order_acq_rel)) {
+    const Outcome outcome = timed_primary_([&] { primary_->write(record); });
+    if (outcome == Outcome::Ok) {
+      consecutive_bad_.store(0, std::memory_order_relaxed);
+      if (on_secondary_.exchange(false, std::memory_order_acq_rel)) {
+        failbacks_count_.fetch_add(1, std::memory_order_relaxed);
+      }
+      return;
+    }
+    if (outcome == Outcome::Error) {
+      primary_errors_count_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      primary_slow_writes_count_.fetch_add(1, std::memory_order_relaxed);
+      return;  // written, just too slowly to trust yet
+    }
+  }
+
+  write_secondary_(record);
+}
+
+void FailoverSink::flush() {
+  if (!on_secondary()) {
+    const Outcome outcome = timed_primary_([&] { primary_->flush(); });
+    if (outcome != Outcome::Ok) {
+      note_bad_primary_(outcome);
+    }
+  }
+
+  // The secondary may hold records re-written after primary errors.
+  try {
+    secondary_->flush();
+  } catch (...) {
+    secondary_failures_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+bool FailoverSink::should_log(const LogRecord& record) const noexcept {
+  if (!ISink::should_log(record)) {
+    return false;
+  }
+  return on_secondary() ? secondary_->should_log(record) : primary_->should_log(record);
+}
+
+}  // namespace sim_logger
@@ -1,5 +1,7 @@
 #include "logger/file_sink.hpp"
 
+#include "logger/metrics.hpp"
+
 #include <cerrno>
 #include <cstdint>
 #include <cstring>
@@ -74,9 +76,22 @@ FileSink::FileSink(std::string path, PatternFormatter formatter, bool durable_fl
     throw std::invalid_argument("FileSink path must not be empty");
   }
   open_or_throw();
+
+  metrics_collector_id_ = MetricsRegistry::instance().add_collector([this, path = path_](MetricsSnapshot& out) {
+    MetricSample s;
+    s.name = "sim_logger_file_bytes";
+    s.labels = {{"path", path}};  // path_ may change under rotation
+    s.type = MetricType::Gauge;
+    s.help = "Bytes written to the current file";
+    s.value = static_cast<double>(bytes_written());
+    out.push_back(std::move(s));
+  });
 }
 
-FileSink::~FileSink() { close_noexcept(); }
+FileSink::~FileSink() {
+  MetricsRegistry::instance().remove_collector(metrics_collector_id_);
+  close_noexcept();
+}
 
 void FileSink::open_or_throw() {
   std::lock_guard<std::mutex> lock(mu_);
@@ -89,8 +104,10 @@ void FileSink::close_noexcept() noexcept {
 }
 
 void FileSink::write(const LogRecord& record) {
-  const std::string line = format_record(record);
+  write_formatted(record, format_record(record));
+}
 
+void FileSink::write_formatted(const LogRecord& /*record*/, std::string_view line) {
   std::lock_guard<std::mutex> lock(mu_);
   write_line_locked(line);
 }
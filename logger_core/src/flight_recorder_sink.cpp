@@ -0,0 +1,110 @@
+#include "logger/flight_recorder_sink.hpp"
+
+#include "logger/metrics.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace sim_logger {
+
+namespace {
+
+std::atomic<std::uint64_t> g_flight_recorder_seq{0};
+
+}  // namespace
+
+FlightRecorderSink::FlightRecorderSink(std::shared_ptr<ISink> target, FlightRecorderOptions options)
+    : target_(std::move(target)), options_(options) {
+  if (!target_) {
+    throw std::invalid_argument("FlightRecorderSink requires a target sink");
+  }
+  if (options_.capacity == 0) {
+    options_.capacity = 1;
+  }
+  ring_.resize(options_.capacity);
+  if (options_.metrics_name.empty()) {
+    options_.metrics_name =
+        "flight-recorder-" + std::to_string(g_flight_recorder_seq.fetch_add(1) + 1);
+  }
+
+  metrics_collector_id_ = MetricsRegistry::instance().add_collector([this](MetricsSnapshot& out) {
+    const auto sample = [&](const char* name, MetricType type, const char* help, double v) {
+      MetricSample s;
+      s.name = name;
+      s.labels = {{"sink", options_.metrics_name}};
+      s.type = type;
+      s.help = help;
+      s.value = v;
+      out.push_back(std::move(s));
+    };
+    sample("sim_logger_flight_recorder_dumps_total", MetricType::Counter,
+           "FlightRecorderSink dumps (triggered or explicit)", static_cast<double>(dumps_count()));
+    sample("sim_logger_flight_recorder_sink_failures_total", MetricType::Counter,
+           "Exceptions from a FlightRecorderSink target during dumps",
+           static_cast<double>(sink_failures_count()));
+    sample("sim_logger_flight_recorder_records", MetricType::Gauge,
+           "Records currently retained by a FlightRecorderSink", static_cast<double>(size()));
+  });
+}
+
+FlightRecorderSink::~FlightRecorderSink() {
+  MetricsRegistry::instance().remove_collector(metrics_collector_id_);
+}
+
+void FlightRecorderSink::write(const LogRecord& record) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  const std::size_t tail = (head_ + count_) % options_.capacity;
+  ring_[tail] = record;
+  if (count_ < options_.capacity) {
+    ++count_;
+  } else {
+    // Full: the slot just written was the oldest record.
+    head_ = (head_ + 1) % options_.capacity;
+  }
+
+  if (record.level() >= options_.trigger_level) {
+    dump_locked_();
+  }
+}
+
+void FlightRecorderSink::flush() {
+  // Nothing is written outside of dumps.
+}
+
+void FlightRecorderSink::dump() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  dump_locked_();
+}
+
+void FlightRecorderSink::dump_locked_() noexcept {
+  if (count_ == 0) {
+    return;
+  }
+
+  // Slots stay engaged after a dump so later writes reuse their string storage.
+  for (std::size_t i = 0; i < count_; ++i) {
+    try {
+      target_->write(*ring_[(head_ + i) % options_.capacity]);
+    } catch (...) {
+      sink_failures_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  head_ = 0;
+  count_ = 0;
+
+  try {
+    target_->flush();
+  } catch (...) {
+    sink_failures_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+  dumps_count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::size_t FlightRecorderSink::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return count_;
+}
+
+}  // namespace sim_logger
@@ -1,5 +1,9 @@
 #include "logger/logger.hpp"
 
+#include "logger/backtrace.hpp"
+#include "logger/shared_level_table.hpp"
+
+#include <algorithm>
 #include <exception>
 
 namespace sim_logger {
@@ -12,29 +16,97 @@ const std::string& Logger::name() const noexcept {
 }
 
 void Logger::set_level(Level level) noexcept {
-  std::lock_guard<std::mutex> lock(mutex_);
-  level_ = level;
-  level_overridden_ = true;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    level_ = level;
+    level_overridden_ = true;
+  }
+  refresh_effective_level_();
 }
 
 void Logger::clear_level_override() noexcept {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    level_overridden_ = false;
+  }
+  refresh_effective_level_();
+}
+
+std::optional<Level> Logger::level_override() const noexcept {
   std::lock_guard<std::mutex> lock(mutex_);
-  level_overridden_ = false;
+  return level_overridden_ ? std::optional<Level>(level_) : std::nullopt;
+}
+
+void Logger::set_rule_level(std::optional<Level> level) noexcept {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (rule_level_ == level) {
+      return;
+    }
+    rule_level_ = level;
+  }
+  refresh_effective_level_();
 }
 
 Level Logger::effective_level() const noexcept {
-  std::lock_guard<std::mutex> lock(mutex_);
+  if (const auto* slot = shared_slot_.load(std::memory_order_relaxed)) {
+    const std::uint8_t forced = slot->override_level.load(std::memory_order_relaxed);
+    if (forced <= static_cast<std::uint8_t>(Level::Fatal)) {
+      return static_cast<Level>(forced);
+    }
+  }
+  return effective_level_.load(std::memory_order_relaxed);
+}
+
+void Logger::set_shared_slot(detail::SharedLevelSlot* slot) noexcept {
+  shared_slot_.store(slot, std::memory_order_release);
+  refresh_effective_level_();
+}
 
-  if (level_overridden_) {
-    return level_;
+void Logger::refresh_effective_level_() noexcept {
+  std::vector<std::shared_ptr<Logger>> children;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Level level = level_;
+    if (!level_overridden_) {
+      if (rule_level_) {
+        level = *rule_level_;
+      } else if (auto parent = parent_.lock()) {
+        // Shared-memory overrides are per logger, so inherit the cached level.
+        level = parent->effective_level_.load(std::memory_order_relaxed);
+      }
+    }
+    effective_level_.store(level, std::memory_order_relaxed);
+    if (auto* slot = shared_slot_.load(std::memory_order_relaxed)) {
+      slot->effective.store(static_cast<std::uint8_t>(level), std::memory_order_relaxed);
+    }
+
+    // Snapshot live children (best-effort: on allocation failure descendants
+    // keep their previous cached level).
+    try {
+      for (const auto& weak : children_) {
+        if (auto child = weak.lock()) {
+          children.push_back(std::move(child));
+        }
+      }
+    } catch (...) {
+    }
   }
 
-  auto parent = parent_.lock();
-  if (parent) {
-    return parent->effective_level();
+  // Propagate without holding our own lock (children lock only themselves and
+  // read our cached level).
+  for (const auto& child : children) {
+    child->refresh_effective_level_();
   }
+}
 
-  return level_;
+void Logger::add_child(const std::shared_ptr<Logger>& child) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  children_.erase(std::remove_if(children_.begin(), children_.end(),
+                                 [](const std::weak_ptr<Logger>& w) { return w.expired(); }),
+                  children_.end());
+  children_.push_back(child);
 }
 
 void Logger::add_sink(std::shared_ptr<ISink> sink) {
@@ -56,18 +128,23 @@ void Logger::clear_sink_override() noexcept {
 }
 
 std::vector<std::shared_ptr<ISink>> Logger::effective_sinks() const {
+  std::vector<std::shared_ptr<ISink>> out;
+  append_effective_sinks_(out);
+  return out;
+}
+
+void Logger::append_effective_sinks_(std::vector<std::shared_ptr<ISink>>& out) const {
   std::lock_guard<std::mutex> lock(mutex_);
 
   if (sinks_overridden_) {
-    return sinks_;
+    out.insert(out.end(), sinks_.begin(), sinks_.end());
+    return;
   }
 
   auto parent = parent_.lock();
   if (parent) {
-    return parent->effective_sinks();
+    parent->append_effective_sinks_(out);
   }
-
-  return {};
 }
 
 std::shared_ptr<Logger> Logger::parent() const noexcept {
@@ -77,37 +154,127 @@ std::shared_ptr<Logger> Logger::parent() const noexcept {
 void Logger::log(const LogRecord& record) noexcept {
   try {
     if (record.level() < effective_level()) {
+      count_filtered(record.level());
+      if (detail::backtrace_active()) {
+        detail::backtrace_capture(record);
+      }
       return;
     }
+    emit_(record);
+  } catch (...) {
+    dropped_records_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void Logger::force_log(const LogRecord& record) noexcept {
+  try {
+    emit_(record);
+  } catch (...) {
+    dropped_records_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void Logger::emit_(const LogRecord& record) {
+  if (detail::backtrace_active()) {
+    detail::backtrace_on_emit(record);
+  }
+
+  // Snapshot the sinks into a per-thread vector so steady-state logging does not
+  // allocate. A sink that logs from inside write() re-enters here and gets its
+  // own vector instead.
+  thread_local std::vector<std::shared_ptr<ISink>> tls_sinks;
+  thread_local bool tls_sinks_busy = false;
+
+  std::vector<std::shared_ptr<ISink>> nested;
+  const bool reuse = !tls_sinks_busy;
+  auto& sinks = reuse ? tls_sinks : nested;
+  struct Release {
+    std::vector<std::shared_ptr<ISink>>& sinks;
+    bool reused;
+    ~Release() {
+      sinks.clear();  // drop references, keep capacity
+      if (reused) {
+        tls_sinks_busy = false;
+      }
+    }
+  } release{sinks, reuse};
+  if (reuse) {
+    tls_sinks_busy = true;
+  }
 
-    const auto sinks = effective_sinks();
-    const bool do_flush = effective_immediate_flush();
+  append_effective_sinks_(sinks);
+  const bool do_flush = effective_immediate_flush();
 
-    for (const auto& sink : sinks) {
-      try {
-        sink->write(record);
-        if (do_flush) {
-          sink->flush();
-        }
-      } catch (...) {
-        sink_failures_count_.fetch_add(1, std::memory_order_relaxed);
+  StatsShard& shard = stats_[detail::thread_shard()];
+  shard.emitted[static_cast<std::size_t>(record.level())].fetch_add(1, std::memory_order_relaxed);
+
+  for (const auto& sink : sinks) {
+    if (!sink->should_log(record)) {
+      continue;
+    }
+    try {
+      shard.bytes.fetch_add(record.message().size(), std::memory_order_relaxed);
+      sink->write(record);
+      if (do_flush) {
+        sink->flush();
       }
+    } catch (...) {
+      sink_failures_count_.fetch_add(1, std::memory_order_relaxed);
     }
-  } catch (...) {
-    dropped_records_count_.fetch_add(1, std::memory_order_relaxed);
   }
 }
 
 
 void Logger::set_parent(std::shared_ptr<Logger> parent) noexcept {
-  std::lock_guard<std::mutex> lock(mutex_);
-  parent_ = parent;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    parent_ = parent;
+  }
+  refresh_effective_level_();
 }
 
 std::uint64_t Logger::sink_failures_count() const noexcept {
   return sink_failures_count_.load(std::memory_order_relaxed);
 }
 
+LoggerStats Logger::stats() const {
+  LoggerStats out;
+  out.name = name_;
+  for (const auto& shard : stats_) {
+    for (std::size_t i = 0; i < kLevelCount; ++i) {
+      out.emitted[i] += shard.emitted[i].load(std::memory_order_relaxed);
+      out.filtered[i] += shard.filtered[i].load(std::memory_order_relaxed);
+    }
+    out.bytes += shard.bytes.load(std::memory_order_relaxed);
+  }
+  return out;
+}
+
+std::uint64_t LoggerStats::emitted_total() const noexcept {
+  std::uint64_t total = 0;
+  for (const auto n : emitted) {
+    total += n;
+  }
+  return total;
+}
+
+std::uint64_t LoggerStats::filtered_total() const noexcept {
+  std::uint64_t total = 0;
+  for (const auto n : filtered) {
+    total += n;
+  }
+  return total;
+}
+
+LoggerStats& LoggerStats::operator+=(const LoggerStats& other) noexcept {
+  for (std::size_t i = 0; i < kLevelCount; ++i) {
+    emitted[i] += other.emitted[i];
+    filtered[i] += other.filtered[i];
+  }
+  bytes += other.bytes;
+  return *this;
+}
+
 std::uint64_t Logger::dropped_records_count() const noexcept {
   return dropped_records_count_.load(std::memory_order_relaxed);
 }
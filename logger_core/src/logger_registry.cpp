@@ -1,25 +1,181 @@
 #include "logger/logger_registry.hpp"
 
+#include "logger/detail/name_glob.hpp"
 #include "logger/logger.hpp"
+#include "logger/metrics.hpp"
+#include "logger/shared_level_table.hpp"
 
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
 #include <stdexcept>
+#include <utility>
 
 namespace sim_logger {
 
+namespace {
+
+constexpr std::size_t kInitialCapacity = 64;
+
+std::string_view trim(std::string_view s) noexcept {
+  while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) {
+    s.remove_prefix(1);
+  }
+  while (!s.empty() && (s.back() == ' ' || s.back() == '\t')) {
+    s.remove_suffix(1);
+  }
+  return s;
+}
+
+}  // namespace
+
+LoggerRegistry::Table::Table(std::size_t capacity)
+    : mask(capacity - 1), slots(new std::atomic<const Node*>[capacity]) {
+  for (std::size_t i = 0; i < capacity; ++i) {
+    slots[i].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
 LoggerRegistry& LoggerRegistry::instance() {
   static LoggerRegistry inst;
   return inst;
 }
 
-std::shared_ptr<Logger> LoggerRegistry::get_logger(const std::string& name) {
-  // Fast path: lookup under lock
+LoggerRegistry::LoggerRegistry() {
+  tables_.push_back(std::make_unique<Table>(kInitialCapacity));
+  table_.store(tables_.back().get(), std::memory_order_release);
+
+  if (const char* env = std::getenv("SIM_LOGGER_LEVELS")) {
+    try {
+      level_rules_ = parse_level_rules(env);
+    } catch (...) {
+      // Misconfigured environment: run with no rules rather than fail at startup.
+    }
+  }
+
+  metrics_collector_id_ = MetricsRegistry::instance().add_collector([this](MetricsSnapshot& out) {
+    for (const auto& logger : loggers()) {
+      const MetricLabels labels{{"logger", logger->name()}};
+      MetricSample dropped;
+      dropped.name = "sim_logger_logger_dropped_records_total";
+      dropped.labels = labels;
+      dropped.help = "Records a logger could not deliver";
+      dropped.value = static_cast<double>(logger->dropped_records_count());
+      out.push_back(std::move(dropped));
+
+      MetricSample failures;
+      failures.name = "sim_logger_logger_sink_failures_total";
+      failures.labels = labels;
+      failures.help = "Exceptions thrown by a logger's sinks";
+      failures.value = static_cast<double>(logger->sink_failures_count());
+      out.push_back(std::move(failures));
+
+      const LoggerStats stats = logger->stats();
+      for (std::size_t i = 0; i < kLevelCount; ++i) {
+        const std::string level(to_string(static_cast<Level>(i)));
+        for (const bool emitted : {true, false}) {
+          MetricSample records;
+          records.name = "sim_logger_logger_records_total";
+          records.labels = {{"logger", logger->name()},
+                            {"level", level},
+                            {"outcome", emitted ? "emitted" : "filtered"}};
+          records.help = "Records per logger, level and outcome (emitted or filtered by level)";
+          records.value = static_cast<double>(emitted ? stats.emitted[i] : stats.filtered[i]);
+          out.push_back(std::move(records));
+        }
+      }
+
+      MetricSample bytes;
+      bytes.name = "sim_logger_logger_bytes_total";
+      bytes.labels = labels;
+      bytes.help = "Message bytes a logger handed to its sinks";
+      bytes.value = static_cast<double>(stats.bytes);
+      out.push_back(std::move(bytes));
+    }
+  });
+}
+
+std::vector<LoggerStats> LoggerRegistry::logger_stats(std::string_view pattern) const {
+  std::vector<LoggerStats> out;
+  for (const auto& logger : loggers()) {
+    if (detail::glob_match(pattern, logger->name())) {
+      out.push_back(logger->stats());
+    }
+  }
+  return out;
+}
+
+LoggerStats LoggerRegistry::total_logger_stats(std::string_view pattern) const {
+  LoggerStats total;
+  total.name = std::string(pattern);
+  for (const auto& stats : logger_stats(pattern)) {
+    total += stats;
+  }
+  return total;
+}
+
+LoggerRegistry::~LoggerRegistry() { MetricsRegistry::instance().remove_collector(metrics_collector_id_); }
+
+const LoggerRegistry::Node* LoggerRegistry::find_in_(const Table& table,
+                                                     std::string_view name,
+                                                     std::size_t hash) noexcept {
+  for (std::size_t i = hash & table.mask;; i = (i + 1) & table.mask) {
+    const Node* node = table.slots[i].load(std::memory_order_acquire);
+    if (node == nullptr) {
+      return nullptr;
+    }
+    if (node->hash == hash && node->name == name) {
+      return node;
+    }
+  }
+}
+
+void LoggerRegistry::insert_locked_(const Node* node) {
+  Table* table = table_.load(std::memory_order_relaxed);
+
+  // Keep the load factor <= 1/2 so probes stay short and always hit an empty slot.
+  if ((nodes_.size() + 1) * 2 > table->mask + 1) {
+    auto grown = std::make_unique<Table>((table->mask + 1) * 2);
+    for (const auto& n : nodes_) {
+      for (std::size_t i = n->hash & grown->mask;; i = (i + 1) & grown->mask) {
+        if (grown->slots[i].load(std::memory_order_relaxed) == nullptr) {
+          grown->slots[i].store(n.get(), std::memory_order_relaxed);
+          break;
+        }
+      }
+    }
+    table = grown.get();
+    tables_.push_back(std::move(grown));
+  }
+
+  for (std::size_t i = node->hash & table->mask;; i = (i + 1) & table->mask) {
+    if (table->slots[i].load(std::memory_order_relaxed) == nullptr) {
+      table->slots[i].store(node, std::memory_order_release);
+      break;
+    }
+  }
+  table_.store(table, std::memory_order_release);
+}
+
+std::shared_ptr<Logger> LoggerRegistry::get_logger(std::string_view name) {
+  const std::size_t hash = std::hash<std::string_view>{}(name);
+
+  // Fast path: lock-free probe of the published table. The shard counter keeps
+  // clear() from freeing the table or node while we use them; seq_cst pairs
+  // the increment with clear()'s table store and counter scan.
   {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = loggers_.find(name);
-    if (it != loggers_.end()) return it->second;
+    auto& reader = readers_[detail::thread_shard()].active;
+    reader.fetch_add(1, std::memory_order_seq_cst);
+    struct Leave {
+      std::atomic<std::uint32_t>& r;
+      ~Leave() { r.fetch_sub(1, std::memory_order_release); }
+    } leave{reader};
+    if (const Node* node = find_in_(*table_.load(std::memory_order_seq_cst), name, hash)) {
+      return node->logger;
+    }
   }
 
-  // Compute and ensure parent exists WITHOUT holding mutex_
+  // Ensure parent exists WITHOUT holding mutex_
   std::shared_ptr<Logger> parent;
   const auto parent_name = parent_name_for(name);
   if (!parent_name.empty()) {
@@ -27,26 +183,154 @@ std::shared_ptr<Logger> LoggerRegistry::get_logger(const std::string& name) {
   }
 
   // Create candidate
-  auto created = std::make_shared<Logger>(name);
-  created->set_parent(parent);
+  auto created = std::make_shared<Logger>(std::string(name));
 
   // Insert (double-check)
   std::lock_guard<std::mutex> lock(mutex_);
-  auto [it, inserted] = loggers_.emplace(name, created);
-  return it->second;
+  if (const Node* node = find_in_(*table_.load(std::memory_order_relaxed), name, hash)) {
+    return node->logger;
+  }
+
+  // Link under mutex_ so a concurrent set_level_rules() either sees this logger
+  // or has already published the rules applied here.
+  created->set_rule_level(rule_level_for_locked_(name));
+  if (shared_table_ != nullptr) {
+    created->set_shared_slot(shared_table_->acquire_slot(name));
+  }
+  // Link into the parent before computing the inherited level: a concurrent
+  // parent set_level() then either refreshes this child through children_ or
+  // completed before the link, in which case set_parent() reads its result.
+  if (parent) {
+    parent->add_child(created);
+  }
+  created->set_parent(parent);
+  auto node = std::make_unique<Node>(Node{std::string(name), hash, std::move(created)});
+  if (nodes_.size() == nodes_.capacity()) {
+    // Grow geometrically here: push_back below must not throw once published.
+    nodes_.reserve(std::max(kInitialCapacity, nodes_.capacity() * 2));
+  }
+  insert_locked_(node.get());
+  nodes_.push_back(std::move(node));
+  return nodes_.back()->logger;
 }
 
+std::vector<std::shared_ptr<Logger>> LoggerRegistry::loggers() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<std::shared_ptr<Logger>> out;
+  out.reserve(nodes_.size());
+  for (const auto& node : nodes_) {
+    out.push_back(node->logger);
+  }
+  return out;
+}
 
 void LoggerRegistry::clear() {
   std::lock_guard<std::mutex> lock(mutex_);
-  loggers_.clear();
+  auto fresh = std::make_unique<Table>(kInitialCapacity);
+  retired_tables_.reserve(retired_tables_.size() + tables_.size());
+  retired_nodes_.reserve(retired_nodes_.size() + nodes_.size());
+  table_.store(fresh.get(), std::memory_order_seq_cst);
+
+  // Readers that loaded the old table may still hold its nodes.
+  for (auto& t : tables_) {
+    retired_tables_.push_back(std::move(t));
+  }
+  for (auto& n : nodes_) {
+    retired_nodes_.push_back(std::move(n));
+  }
+  tables_.clear();
+  tables_.push_back(std::move(fresh));
+  nodes_.clear();
+  generation_.fetch_add(1, std::memory_order_acq_rel);
+
+  reclaim_retired_locked_();
+}
+
+void LoggerRegistry::reclaim_retired_locked_() noexcept {
+  // Each reader uses one shard for its whole probe, so a shard seen idle after
+  // the retiring table store has no reader left that could see the old table.
+  // A shard that is busy now may never look idle; keep the garbage for the
+  // next clear() (or the destructor) in that case.
+  for (const auto& shard : readers_) {
+    if (shard.active.load(std::memory_order_seq_cst) != 0) {
+      return;
+    }
+  }
+  retired_nodes_.clear();
+  retired_tables_.clear();
+}
+
+std::vector<LevelRule> LoggerRegistry::parse_level_rules(std::string_view spec) {
+  std::vector<LevelRule> rules;
+
+  while (!spec.empty()) {
+    const auto comma = spec.find(',');
+    const std::string_view entry = trim(spec.substr(0, comma));
+    spec = (comma == std::string_view::npos) ? std::string_view{} : spec.substr(comma + 1);
+    if (entry.empty()) {
+      continue;
+    }
+
+    const auto eq = entry.find('=');
+    const std::string_view pattern = (eq == std::string_view::npos) ? "*" : trim(entry.substr(0, eq));
+    const std::string_view level_name =
+        (eq == std::string_view::npos) ? entry : trim(entry.substr(eq + 1));
+
+    const auto level = level_from_string(level_name);
+    if (pattern.empty() || !level) {
+      throw std::invalid_argument("invalid level rule '" + std::string(entry) + "'");
+    }
+    rules.push_back(LevelRule{std::string(pattern), *level});
+  }
+
+  return rules;
+}
+
+void LoggerRegistry::set_level_rules(std::string_view spec) {
+  set_level_rules(parse_level_rules(spec));
+}
+
+void LoggerRegistry::set_level_rules(std::vector<LevelRule> rules) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  level_rules_ = std::move(rules);
+
+  // nodes_ is in creation order, so parents refresh before their children.
+  for (const auto& node : nodes_) {
+    node->logger->set_rule_level(rule_level_for_locked_(node->name));
+  }
+}
+
+void LoggerRegistry::attach_shared_level_table(std::shared_ptr<SharedLevelTable> table) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  shared_table_ = table.get();
+  if (table) {
+    shared_tables_.push_back(std::move(table));
+  }
+  for (const auto& node : nodes_) {
+    node->logger->set_shared_slot(shared_table_ != nullptr ? shared_table_->acquire_slot(node->name)
+                                                           : nullptr);
+  }
+}
+
+std::vector<LevelRule> LoggerRegistry::level_rules() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return level_rules_;
+}
+
+std::optional<Level> LoggerRegistry::rule_level_for_locked_(std::string_view name) const noexcept {
+  for (auto it = level_rules_.rbegin(); it != level_rules_.rend(); ++it) {
+    if (detail::glob_match(it->pattern, name)) {
+      return it->level;
+    }
+  }
+  return std::nullopt;
 }
 
-std::string LoggerRegistry::parent_name_for(const std::string& name) {
+std::string_view LoggerRegistry::parent_name_for(std::string_view name) {
   if (name.empty() || name == "root") return {};
 
   const auto pos = name.find_last_of('.');
-  if (pos == std::string::npos) return "root";
+  if (pos == std::string_view::npos) return "root";
   if (pos == 0) return "root";          // ".x" -> root (defensive)
   if (pos == name.size() - 1) {         // "a." -> treat as "a"
     return parent_name_for(name.substr(0, name.size() - 1));
@@ -0,0 +1,463 @@
+#include "logger/metrics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+namespace sim_logger {
+
+namespace {
+
+bool valid_name(std::string_view name, bool allow_colon) noexcept {
+  if (name.empty()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < name.size(); ++i) {
+    const char c = name[i];
+    const bool alpha = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' ||
+                       (allow_colon && c == ':');
+    const bool digit = c >= '0' && c <= '9';
+    if (!alpha && !(digit && i > 0)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void add_double(std::atomic<double>& target, double delta) noexcept {
+  double cur = target.load(std::memory_order_relaxed);
+  while (!target.compare_exchange_weak(cur, cur + delta, std::memory_order_relaxed)) {
+  }
+}
+
+void append_escaped(std::string& out, std::string_view s, bool quote) {
+  for (const char c : s) {
+    if (c == '\\') {
+      out += "\\\\";
+    } else if (c == '\n') {
+      out += "\\n";
+    } else if (quote && c == '"') {
+      out += "\\\"";
+    } else {
+      out += c;
+    }
+  }
+}
+
+void append_number(std::string& out, double v) {
+  if (std::isnan(v)) {
+    out += "NaN";
+  } else if (std::isinf(v)) {
+    out += v > 0 ? "+Inf" : "-Inf";
+  } else {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.17g", v);
+    out += buf;
+  }
+}
+
+void append_labels(std::string& out, const MetricLabels& labels, std::string_view extra_key = {},
+                   std::string_view extra_value = {}) {
+  if (labels.empty() && extra_key.empty()) {
+    return;
+  }
+  out += '{';
+  bool first = true;
+  const auto add = [&](std::string_view k, std::string_view v) {
+    if (!first) {
+      out += ',';
+    }
+    first = false;
+    out += k;
+    out += "=\"";
+    append_escaped(out, v, true);
+    out += '"';
+  };
+  for (const auto& [k, v] : labels) {
+    add(k, v);
+  }
+  if (!extra_key.empty()) {
+    add(extra_key, extra_value);
+  }
+  out += '}';
+}
+
+}  // namespace
+
+std::string_view to_string(MetricType type) noexcept {
+  switch (type) {
+    case MetricType::Counter:
+      return "counter";
+    case MetricType::Gauge:
+      return "gauge";
+    case MetricType::Histogram:
+      return "histogram";
+  }
+  return "untyped";
+}
+
+// ---------------------------------------------------------------------------
+// ShardedCounter / Gauge / Histogram
+
+std::size_t detail::assign_thread_shard() noexcept {
+  static std::atomic<std::size_t> next{0};
+  return next.fetch_add(1, std::memory_order_relaxed) % kThreadShards;
+}
+
+std::uint64_t ShardedCounter::value() const noexcept {
+  std::uint64_t total = 0;
+  for (const auto& s : shards_) {
+    total += s.value.load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+void Gauge::add(double delta) noexcept { add_double(value_, delta); }
+
+Histogram::Histogram(std::vector<double> upper_bounds) : bounds_(std::move(upper_bounds)) {
+  if (bounds_.empty()) {
+    throw std::invalid_argument("Histogram requires at least one bucket bound");
+  }
+  for (std::size_t i = 0; i < bounds_.size(); ++i) {
+    if (!std::isfinite(bounds_[i]) || (i > 0 && bounds_[i] <= bounds_[i - 1])) {
+      throw std::invalid_argument("Histogram bounds must be finite and strictly increasing");
+    }
+  }
+  buckets_ = std::make_unique<ShardedCounter[]>(bounds_.size() + 1);
+}
+
+void Histogram::observe(double v) noexcept {
+  const auto it = std::lower_bound(bounds_.begin(), bounds_.end(), v);
+  buckets_[static_cast<std::size_t>(it - bounds_.begin())].add();
+  add_double(sum_, v);
+}
+
+std::vector<std::uint64_t> Histogram::bucket_counts() const {
+  std::vector<std::uint64_t> out(bounds_.size() + 1);
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    out[i] = buckets_[i].value();
+  }
+  return out;
+}
+
+void Histogram::fill_sample(MetricSample& out) const {
+  const auto counts = bucket_counts();
+  out.type = MetricType::Histogram;
+  out.bucket_bounds = bounds_;
+  out.bucket_counts.clear();
+  std::uint64_t cumulative = 0;
+  for (std::size_t i = 0; i + 1 < counts.size(); ++i) {
+    cumulative += counts[i];
+    out.bucket_counts.push_back(cumulative);
+  }
+  out.count = cumulative + counts.back();
+  out.value = sum();
+}
+
+std::uint64_t Histogram::count() const noexcept {
+  std::uint64_t total = 0;
+  for (std::size_t i = 0; i <= bounds_.size(); ++i) {
+    total += buckets_[i].value();
+  }
+  return total;
+}
+
+// ---------------------------------------------------------------------------
+// MetricsRegistry
+
+MetricsRegistry& MetricsRegistry::instance() {
+  static auto* r = new MetricsRegistry();
+  return *r;
+}
+
+MetricsRegistry::Entry& MetricsRegistry::find_or_add_(const std::string& name,
+                                                      const MetricLabels& labels,
+                                                      MetricType type,
+                                                      const std::string& help) {
+  if (!valid_name(name, true)) {
+    throw std::invalid_argument("invalid metric name '" + name + "'");
+  }
+  for (const auto& [k, v] : labels) {
+    if (!valid_name(k, false)) {
+      throw std::invalid_argument("invalid label name '" + k + "' on metric '" + name + "'");
+    }
+  }
+
+  // Caller holds metrics_mutex_.
+  for (auto& e : entries_) {
+    if (e.name != name) {
+      continue;
+    }
+    if (e.type != type) {
+      throw std::invalid_argument("metric '" + name + "' is already registered as a " +
+                                  std::string(to_string(e.type)));
+    }
+    if (e.labels == labels) {
+      return e;
+    }
+  }
+  entries_.push_back(Entry{name, labels, type, help, nullptr, nullptr, nullptr});
+  return entries_.back();
+}
+
+std::shared_ptr<ShardedCounter> MetricsRegistry::counter(const std::string& name,
+                                                         const MetricLabels& labels,
+                                                         const std::string& help) {
+  std::lock_guard<std::mutex> lk(metrics_mutex_);
+  Entry& e = find_or_add_(name, labels, MetricType::Counter, help);
+  if (!e.counter) {
+    e.counter = std::make_shared<ShardedCounter>();
+  }
+  return e.counter;
+}
+
+std::shared_ptr<Gauge> MetricsRegistry::gauge(const std::string& name,
+                                              const MetricLabels& labels,
+                                              const std::string& help) {
+  std::lock_guard<std::mutex> lk(metrics_mutex_);
+  Entry& e = find_or_add_(name, labels, MetricType::Gauge, help);
+  if (!e.gauge) {
+    e.gauge = std::make_shared<Gauge>();
+  }
+  return e.gauge;
+}
+
+std::shared_ptr<Histogram> MetricsRegistry::histogram(const std::string& name,
+                                                      std::vector<double> upper_bounds,
+                                                      const MetricLabels& labels,
+                                                      const std::string& help) {
+  auto created = std::make_shared<Histogram>(std::move(upper_bounds));  // validates bounds
+  std::lock_guard<std::mutex> lk(metrics_mutex_);
+  Entry& e = find_or_add_(name, labels, MetricType::Histogram, help);
+  if (!e.histogram) {
+    e.histogram = std::move(created);
+  }
+  return e.histogram;
+}
+
+std::uint64_t MetricsRegistry::add_collector(MetricsCollector collector) {
+  if (!collector) {
+    throw std::invalid_argument("MetricsRegistry::add_collector requires a callback");
+  }
+  auto slot = std::make_shared<CollectorSlot>();
+  slot->fn = std::move(collector);
+  std::lock_guard<std::mutex> lk(collectors_mutex_);
+  const std::uint64_t id = next_collector_id_++;
+  collectors_.emplace(id, std::move(slot));
+  return id;
+}
+
+void MetricsRegistry::remove_collector(std::uint64_t id) noexcept {
+  std::shared_ptr<CollectorSlot> slot;
+  {
+    std::lock_guard<std::mutex> lk(collectors_mutex_);
+    const auto it = collectors_.find(id);
+    if (it == collectors_.end()) {
+      return;
+    }
+    slot = std::move(it->second);
+    collectors_.erase(it);
+  }
+  // Wait for a snapshot that is running this collector, then retire it.
+  std::lock_guard<std::mutex> lk(slot->m);
+  slot->alive = false;
+}
+
+MetricsSnapshot MetricsRegistry::snapshot() const {
+  MetricsSnapshot out;
+  {
+    std::lock_guard<std::mutex> lk(metrics_mutex_);
+    out.reserve(entries_.size());
+    for (const auto& e : entries_) {
+      MetricSample s;
+      s.name = e.name;
+      s.labels = e.labels;
+      s.type = e.type;
+      s.help = e.help;
+      if (e.counter) {
+        s.value = static_cast<double>(e.counter->value());
+      } else if (e.gauge) {
+        s.value = e.gauge->value();
+      } else if (e.histogram) {
+        e.histogram->fill_sample(s);
+      }
+      out.push_back(std::move(s));
+    }
+  }
+
+  std::vector<std::shared_ptr<CollectorSlot>> slots;
+  {
+    std::lock_guard<std::mutex> lk(collectors_mutex_);
+    slots.reserve(collectors_.size());
+    for (const auto& [id, slot] : collectors_) {
+      slots.push_back(slot);
+    }
+  }
+  for (const auto& slot : slots) {
+    std::lock_guard<std::mutex> lk(slot->m);
+    if (!slot->alive) {
+      continue;
+    }
+    try {
+      slot->fn(out);
+    } catch (...) {
+      // A failing collector loses its samples for this snapshot only.
+    }
+  }
+  return out;
+}
+
+// ---------------------------------------------------------------------------
+// Prometheus text format
+
+std::string to_prometheus(const MetricsSnapshot& snapshot) {
+  // Group by name, keeping first-seen order.
+  std::vector<std::string> order;
+  std::set<std::string> seen;
+  for (const auto& s : snapshot) {
+    if (seen.insert(s.name).second) {
+      order.push_back(s.name);
+    }
+  }
+
+  std::string out;
+  for (const auto& name : order) {
+    bool header = false;
+    for (const auto& s : snapshot) {
+      if (s.name != name) {
+        continue;
+      }
+      if (!header) {
+        if (!s.help.empty()) {
+          out += "# HELP " + name + " ";
+          append_escaped(out, s.help, false);
+          out += '\n';
+        }
+        out += "# TYPE " + name + " " + std::string(to_string(s.type)) + "\n";
+        header = true;
+      }
+
+      if (s.type != MetricType::Histogram) {
+        out += name;
+        append_labels(out, s.labels);
+        out += ' ';
+        append_number(out, s.value);
+        out += '\n';
+        continue;
+      }
+
+      for (std::size_t i = 0; i < s.bucket_bounds.size() && i < s.bucket_counts.size(); ++i) {
+        std::string le;
+        append_number(le, s.bucket_bounds[i]);
+        out += name + "_bucket";
+        append_labels(out, s.labels, "le", le);
+        out += ' ' + std::to_string(s.bucket_counts[i]) + '\n';
+      }
+      out += name + "_bucket";
+      append_labels(out, s.labels, "le", "+Inf");
+      out += ' ' + std::to_string(s.count) + '\n';
+      out += name + "_sum";
+      append_labels(out, s.labels);
+      out += ' ';
+      append_number(out, s.value);
+      out += '\n';
+      out += name + "_count";
+      append_labels(out, s.labels);
+      out += ' ' + std::to_string(s.count) + '\n';
+    }
+  }
+  return out;
+}
+
+// ---------------------------------------------------------------------------
+// MetricsFileExporter
+
+MetricsFileExporter::MetricsFileExporter(std::string path,
+                                         std::chrono::milliseconds interval,
+                                         MetricsRegistry& registry)
+    : path_(std::move(path)), interval_(interval), registry_(registry) {
+  if (path_.empty()) {
+    throw std::invalid_argument("MetricsFileExporter requires a path");
+  }
+  if (interval_.count() <= 0) {
+    throw std::invalid_argument("MetricsFileExporter interval must be > 0");
+  }
+}
+
+MetricsFileExporter::~MetricsFileExporter() { stop(); }
+
+void MetricsFileExporter::start() {
+  std::lock_guard<std::mutex> lk(m_);
+  if (thread_.joinable()) {
+    throw std::runtime_error("MetricsFileExporter already running");
+  }
+  stop_ = false;
+  thread_ = std::thread([this] { run_(); });
+}
+
+void MetricsFileExporter::stop() noexcept {
+  std::thread t;
+  {
+    std::lock_guard<std::mutex> lk(m_);
+    if (!thread_.joinable()) {
+      return;
+    }
+    stop_ = true;
+    t = std::move(thread_);
+  }
+  cv_.notify_all();
+  t.join();
+}
+
+void MetricsFileExporter::export_now() {
+  const std::string text = to_prometheus(registry_.snapshot());
+  const std::string tmp = path_ + ".tmp";
+  {
+    std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      throw std::runtime_error("MetricsFileExporter cannot open '" + tmp + "'");
+    }
+    out << text;
+    out.flush();
+    if (!out) {
+      throw std::runtime_error("MetricsFileExporter write to '" + tmp + "' failed");
+    }
+  }
+#if defined(_WIN32)
+  std::remove(path_.c_str());  // rename() does not replace an existing file there
+#endif
+  if (std::rename(tmp.c_str(), path_.c_str()) != 0) {
+    std::remove(tmp.c_str());
+    throw std::runtime_error("MetricsFileExporter cannot rename '" + tmp + "' to '" + path_ + "'");
+  }
+  exports_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MetricsFileExporter::export_noexcept_() noexcept {
+  try {
+    export_now();
+  } catch (...) {
+    failures_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void MetricsFileExporter::run_() noexcept {
+  std::unique_lock<std::mutex> lk(m_);
+  for (;;) {
+    lk.unlock();
+    export_noexcept_();
+    lk.lock();
+    if (cv_.wait_for(lk, interval_, [this] { return stop_; })) {
+      break;
+    }
+  }
+  lk.unlock();
+  export_noexcept_();  // final state on shutdown
+}
+
+}  // namespace sim_logger
@@ -116,7 +116,11 @@ PatternFormatter::extract_tokens(std::string_view pattern) {
 std::string PatternFormatter::format(const LogRecord& record) const {
   std::string out;
   out.reserve(pattern_.size() + record.message().size() + 32);
+  format_to(record, out);
+  return out;
+}
 
+void PatternFormatter::format_to(const LogRecord& record, std::string& out) const {
   std::string_view pat = pattern_;
   size_t i = 0;
 
@@ -159,6 +163,17 @@ std::string PatternFormatter::format(const LogRecord& record) const {
       out.append(record.logger_name());
     } else if (token == "msg") {
       out.append(record.message());
+    } else if (token == "tags") {
+      bool first = true;
+      for (const auto& tag : record.tags()) {
+        if (!first) {
+          out.push_back(' ');
+        }
+        first = false;
+        out.append(tag.key);
+        out.push_back('=');
+        out.append(tag.value);
+      }
     } else {
       // Unknown token: preserve verbatim
       out.push_back('{');
@@ -168,8 +183,6 @@ std::string PatternFormatter::format(const LogRecord& record) const {
 
     i = j + 1;
   }
-
-  return out;
 }
 
 }  // namespace sim_logger
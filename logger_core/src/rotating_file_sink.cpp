@@ -1,5 +1,7 @@
 #include "logger/rotating_file_sink.hpp"
 
+#include "logger/metrics.hpp"
+
 #include <cerrno>
 #include <algorithm>
 #include <chrono>
@@ -50,18 +52,41 @@ RotatingFileSink::RotatingFileSink(std::string path,
   if (max_bytes_ == 0) {
     throw std::invalid_argument("RotatingFileSink max_bytes must be > 0");
   }
+
+  rotation_collector_id_ = MetricsRegistry::instance().add_collector([this](MetricsSnapshot& out) {
+    const auto counter = [&](const char* name, const char* help, std::uint64_t v) {
+      MetricSample s;
+      s.name = name;
+      s.labels = {{"path", base_path_}};
+      s.type = MetricType::Counter;
+      s.help = help;
+      s.value = static_cast<double>(v);
+      out.push_back(std::move(s));
+    };
+    counter("sim_logger_file_rotations_total", "Completed RotatingFileSink rotations",
+            rotations_performed());
+    counter("sim_logger_file_rotation_failures_total", "RotatingFileSink rotations that threw",
+            rotation_failures());
+  });
 }
 
-void RotatingFileSink::write(const LogRecord& record) {
-  const std::string line = format_record(record);
+RotatingFileSink::~RotatingFileSink() {
+  MetricsRegistry::instance().remove_collector(rotation_collector_id_);
+}
 
+void RotatingFileSink::write_formatted(const LogRecord& /*record*/, std::string_view line) {
   std::lock_guard<std::mutex> lock(mutex());
 
   const std::uint64_t projected = bytes_written() + static_cast<std::uint64_t>(line.size()) +
                                   ((line.empty() || line.back() != '\n') ? 1U : 0U);
 
   if (projected >= max_bytes_) {
-    rotate_locked();
+    try {
+      rotate_locked();
+    } catch (...) {
+      rotation_failures_.fetch_add(1, std::memory_order_relaxed);
+      throw;
+    }
   }
 
   write_line_locked(line);
@@ -94,7 +119,7 @@ void RotatingFileSink::rotate_locked() {
 
   // Reopen the base file for continued logging.
   reopen_locked(base_path_);
-  ++rotations_performed_;
+  rotations_performed_.fetch_add(1, std::memory_order_relaxed);
 
   prune_old_rotations_locked();
 }
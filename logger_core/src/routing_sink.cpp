@@ -0,0 +1,180 @@
+#include "logger/routing_sink.hpp"
+
+#include "logger/detail/name_glob.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace sim_logger {
+
+RoutingSink::RoutingSink(std::vector<RoutingRule> rules, std::shared_ptr<ISink> fallback)
+    : rules_(std::move(rules)), fallback_(std::move(fallback)) {
+  for (const auto& rule : rules_) {
+    if (!rule.sink) {
+      throw std::invalid_argument("RoutingSink rule requires a sink");
+    }
+    if (rule.min_level > rule.max_level) {
+      throw std::invalid_argument("RoutingSink rule min_level must not exceed max_level");
+    }
+    if (std::find(flush_targets_.begin(), flush_targets_.end(), rule.sink) ==
+        flush_targets_.end()) {
+      flush_targets_.push_back(rule.sink);
+    }
+  }
+  if (fallback_ && std::find(flush_targets_.begin(), flush_targets_.end(), fallback_) ==
+                       flush_targets_.end()) {
+    flush_targets_.push_back(fallback_);
+  }
+
+  compile_();
+}
+
+void RoutingSink::compile_() {
+  trie_.clear();
+  trie_.emplace_back();
+
+  for (std::uint32_t i = 0; i < rules_.size(); ++i) {
+    const std::string_view prefix = detail::glob_literal_prefix(rules_[i].logger_glob);
+
+    std::uint32_t node = 0;
+    for (const char c : prefix) {
+      auto& children = trie_[node].children;
+      auto it = std::lower_bound(children.begin(), children.end(), c,
+                                 [](const auto& child, char ch) { return child.first < ch; });
+      if (it != children.end() && it->first == c) {
+        node = it->second;
+        continue;
+      }
+      const auto next = static_cast<std::uint32_t>(trie_.size());
+      children.insert(it, {c, next});
+      trie_.emplace_back();  // may invalidate `children`; not used afterwards
+      node = next;
+    }
+    trie_[node].rules.push_back(i);
+  }
+}
+
+std::vector<std::uint32_t> RoutingSink::match_name_(std::string_view name) const {
+  std::vector<std::uint32_t> out;
+
+  // Every node visited along the name is a literal prefix of the name; only the
+  // rules anchored at those nodes can match.
+  auto collect = [&](const TrieNode& node, std::size_t depth) {
+    for (const std::uint32_t idx : node.rules) {
+      const std::string_view glob = rules_[idx].logger_glob;
+      if (detail::glob_is_literal(glob)) {
+        if (depth == name.size()) {
+          out.push_back(idx);
+        }
+      } else if (detail::glob_match(glob.substr(depth), name.substr(depth))) {
+        out.push_back(idx);
+      }
+    }
+  };
+
+  std::uint32_t node = 0;
+  collect(trie_[node], 0);
+  for (std::size_t depth = 0; depth < name.size(); ++depth) {
+    const auto& children = trie_[node].children;
+    const char c = name[depth];
+    auto it = std::lower_bound(children.begin(), children.end(), c,
+                               [](const auto& child, char ch) { return child.first < ch; });
+    if (it == children.end() || it->first != c) {
+      break;
+    }
+    node = it->second;
+    collect(trie_[node], depth + 1);
+  }
+
+  std::sort(out.begin(), out.end());
+  return out;
+}
+
+const std::vector<std::uint32_t>& RoutingSink::rules_for_(std::string_view name) {
+  {
+    std::shared_lock<std::shared_mutex> lock(cache_mutex_);
+    auto it = cache_.find(name);
+    if (it != cache_.end()) {
+      return it->second;
+    }
+  }
+
+  auto matched = match_name_(name);
+
+  std::unique_lock<std::shared_mutex> lock(cache_mutex_);
+  auto it = cache_.find(name);
+  if (it != cache_.end()) {
+    return it->second;
+  }
+  // Cached entries are never erased, so references handed out remain valid.
+  const std::string_view key = names_.emplace_back(name);
+  return cache_.emplace(key, std::move(matched)).first->second;
+}
+
+bool RoutingSink::tags_match_(const RoutingRule& rule, const LogRecord& record) noexcept {
+  for (const auto& want : rule.tags) {
+    const auto& tags = record.tags();
+    const bool found = std::any_of(tags.begin(), tags.end(), [&](const Tag& tag) {
+      return tag.key == want.key && (!want.value || tag.value == *want.value);
+    });
+    if (!found) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void RoutingSink::write(const LogRecord& record) {
+  bool written = false;
+
+  for (const std::uint32_t idx : rules_for_(record.logger_name())) {
+    const RoutingRule& rule = rules_[idx];
+    if (record.level() < rule.min_level || record.level() > rule.max_level) {
+      continue;
+    }
+    if (!rule.tags.empty() && !tags_match_(rule, record)) {
+      continue;
+    }
+    if (!rule.sink->should_log(record)) {
+      continue;
+    }
+
+    try {
+      rule.sink->write(record);
+    } catch (...) {
+      sink_failures_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+    written = true;
+
+    if (rule.stop) {
+      break;
+    }
+  }
+
+  if (!written && fallback_ && fallback_->should_log(record)) {
+    try {
+      fallback_->write(record);
+    } catch (...) {
+      sink_failures_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+}
+
+void RoutingSink::flush() {
+  for (const auto& sink : flush_targets_) {
+    try {
+      sink->flush();
+    } catch (...) {
+      sink_failures_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+}
+
+std::size_t RoutingSink::cached_names_count() const {
+  std::shared_lock<std::shared_mutex> lock(cache_mutex_);
+  return cache_.size();
+}
+
+}  // namespace sim_logger
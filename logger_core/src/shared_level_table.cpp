@@ -0,0 +1,232 @@
+#include "logger/shared_level_table.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace sim_logger {
+
+using detail::SharedLevelHeader;
+using detail::SharedLevelSlot;
+
+namespace {
+
+std::size_t table_bytes(std::size_t capacity) noexcept {
+  return sizeof(SharedLevelHeader) + capacity * sizeof(SharedLevelSlot);
+}
+
+[[noreturn]] void throw_errno(const std::string& what) {
+  const int err = errno;
+  throw std::runtime_error("SharedLevelTable " + what + ": " + std::strerror(err));
+}
+
+}  // namespace
+
+SharedLevelTable::SharedLevelTable(std::string shm_name, void* base, std::size_t bytes, bool owner) noexcept
+    : shm_name_(std::move(shm_name)), base_(base), bytes_(bytes), owner_(owner) {}
+
+SharedLevelHeader* SharedLevelTable::header_() const noexcept {
+  return static_cast<SharedLevelHeader*>(base_);
+}
+
+SharedLevelSlot* SharedLevelTable::slots_() const noexcept {
+  return reinterpret_cast<SharedLevelSlot*>(static_cast<char*>(base_) + sizeof(SharedLevelHeader));
+}
+
+#if defined(_WIN32)
+
+std::shared_ptr<SharedLevelTable> SharedLevelTable::create(const std::string&, std::size_t, bool) {
+  throw std::runtime_error("SharedLevelTable requires POSIX shared memory");
+}
+
+std::shared_ptr<SharedLevelTable> SharedLevelTable::open(const std::string&) {
+  throw std::runtime_error("SharedLevelTable requires POSIX shared memory");
+}
+
+SharedLevelTable::~SharedLevelTable() = default;
+
+#else
+
+std::shared_ptr<SharedLevelTable> SharedLevelTable::create(const std::string& shm_name,
+                                                           std::size_t capacity,
+                                                           bool replace_existing) {
+  if (capacity == 0) {
+    throw std::invalid_argument("SharedLevelTable capacity must be > 0");
+  }
+  const std::size_t bytes = table_bytes(capacity);
+
+  if (replace_existing) {
+    ::shm_unlink(shm_name.c_str());
+  }
+  const int fd = ::shm_open(shm_name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+  if (fd < 0) {
+    if (errno == EEXIST) {
+      throw std::runtime_error("SharedLevelTable segment '" + shm_name + "' already exists");
+    }
+    throw_errno("shm_open('" + shm_name + "') failed");
+  }
+  struct stat st {};
+  if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0 || ::fstat(fd, &st) != 0) {
+    const int err = errno;
+    ::close(fd);
+    ::shm_unlink(shm_name.c_str());
+    errno = err;
+    throw_errno("ftruncate failed");
+  }
+  void* base = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (base == MAP_FAILED) {
+    ::shm_unlink(shm_name.c_str());
+    throw_errno("mmap failed");
+  }
+
+  // The segment is zero-filled; construct the atomics in place.
+  auto* header = new (base) SharedLevelHeader{kMagic, kVersion, static_cast<std::uint32_t>(capacity), {0}};
+  (void)header;
+  auto* slots = reinterpret_cast<SharedLevelSlot*>(static_cast<char*>(base) + sizeof(SharedLevelHeader));
+  for (std::size_t i = 0; i < capacity; ++i) {
+    auto* s = new (&slots[i]) SharedLevelSlot{};
+    s->override_level.store(kNoOverride, std::memory_order_relaxed);
+  }
+
+  std::shared_ptr<SharedLevelTable> table(new SharedLevelTable(shm_name, base, bytes, true));
+  table->owned_dev_ = static_cast<std::uint64_t>(st.st_dev);
+  table->owned_ino_ = static_cast<std::uint64_t>(st.st_ino);
+  return table;
+}
+
+std::shared_ptr<SharedLevelTable> SharedLevelTable::open(const std::string& shm_name) {
+  const int fd = ::shm_open(shm_name.c_str(), O_RDWR, 0);
+  if (fd < 0) {
+    throw_errno("shm_open('" + shm_name + "') failed");
+  }
+  struct stat st {};
+  if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(SharedLevelHeader)) {
+    ::close(fd);
+    throw std::runtime_error("SharedLevelTable segment '" + shm_name + "' is too small");
+  }
+  const auto bytes = static_cast<std::size_t>(st.st_size);
+  void* base = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (base == MAP_FAILED) {
+    throw_errno("mmap failed");
+  }
+
+  const auto* header = static_cast<const SharedLevelHeader*>(base);
+  if (header->magic != kMagic || header->version != kVersion ||
+      table_bytes(header->capacity) > bytes) {
+    ::munmap(base, bytes);
+    throw std::runtime_error("SharedLevelTable segment '" + shm_name + "' has an unexpected layout");
+  }
+
+  return std::shared_ptr<SharedLevelTable>(new SharedLevelTable(shm_name, base, bytes, false));
+}
+
+SharedLevelTable::~SharedLevelTable() {
+  ::munmap(base_, bytes_);
+  if (!owner_) {
+    return;
+  }
+  // Only unlink the name if it still refers to our segment (see create()).
+  const int fd = ::shm_open(shm_name_.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    return;
+  }
+  struct stat st {};
+  const bool ours = ::fstat(fd, &st) == 0 && static_cast<std::uint64_t>(st.st_dev) == owned_dev_ &&
+                    static_cast<std::uint64_t>(st.st_ino) == owned_ino_;
+  ::close(fd);
+  if (ours) {
+    ::shm_unlink(shm_name_.c_str());
+  }
+}
+
+#endif
+
+std::size_t SharedLevelTable::capacity() const noexcept { return header_()->capacity; }
+
+std::size_t SharedLevelTable::size() const noexcept {
+  const std::size_t n = header_()->count.load(std::memory_order_acquire);
+  return n < capacity() ? n : capacity();
+}
+
+std::optional<std::size_t> SharedLevelTable::find(std::string_view logger_name) const noexcept {
+  const std::size_t n = size();
+  for (std::size_t i = 0; i < n; ++i) {
+    if (name(i) == logger_name) {
+      return i;
+    }
+  }
+  return std::nullopt;
+}
+
+SharedLevelSlot* SharedLevelTable::acquire_slot(std::string_view logger_name) {
+  if (logger_name.size() >= SharedLevelSlot::kNameCapacity) {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lk(alloc_mutex_);
+  if (const auto id = find(logger_name)) {
+    return &slots_()[*id];
+  }
+
+  const std::uint32_t id = header_()->count.load(std::memory_order_relaxed);
+  if (id >= capacity()) {
+    return nullptr;
+  }
+  SharedLevelSlot& s = slots_()[id];
+  std::memcpy(s.name, logger_name.data(), logger_name.size());
+  s.name[logger_name.size()] = '\0';
+  s.used.store(1, std::memory_order_release);
+  header_()->count.store(id + 1, std::memory_order_release);
+  return &s;
+}
+
+std::string_view SharedLevelTable::name(std::size_t id) const noexcept {
+  if (id >= size()) {
+    return {};
+  }
+  const SharedLevelSlot& s = slots_()[id];
+  if (s.used.load(std::memory_order_acquire) == 0) {
+    return {};
+  }
+  return std::string_view(s.name, ::strnlen(s.name, SharedLevelSlot::kNameCapacity));
+}
+
+std::optional<Level> SharedLevelTable::effective_level(std::size_t id) const noexcept {
+  if (id >= size()) {
+    return std::nullopt;
+  }
+  const auto v = slots_()[id].effective.load(std::memory_order_relaxed);
+  return v <= static_cast<std::uint8_t>(Level::Fatal) ? std::optional<Level>(static_cast<Level>(v))
+                                                       : std::nullopt;
+}
+
+std::optional<Level> SharedLevelTable::override_level(std::size_t id) const noexcept {
+  if (id >= size()) {
+    return std::nullopt;
+  }
+  const auto v = slots_()[id].override_level.load(std::memory_order_relaxed);
+  return v <= static_cast<std::uint8_t>(Level::Fatal) ? std::optional<Level>(static_cast<Level>(v))
+                                                       : std::nullopt;
+}
+
+bool SharedLevelTable::set_override(std::size_t id, std::optional<Level> level) noexcept {
+  if (id >= size()) {
+    return false;
+  }
+  slots_()[id].override_level.store(level ? static_cast<std::uint8_t>(*level) : kNoOverride,
+                                    std::memory_order_relaxed);
+  return true;
+}
+
+}  // namespace sim_logger
@@ -0,0 +1,41 @@
+#include "logger/sink.hpp"
+
+#include <utility>
+
+namespace sim_logger {
+
+void ISink::set_filter(SinkFilter filter) {
+  if (!filter) {
+    clear_filter();
+    return;
+  }
+  std::atomic_store(&filter_, std::shared_ptr<const SinkFilter>(
+                                  std::make_shared<SinkFilter>(std::move(filter))));
+  has_filter_.store(true, std::memory_order_release);
+}
+
+void ISink::clear_filter() noexcept {
+  has_filter_.store(false, std::memory_order_release);
+  std::atomic_store(&filter_, std::shared_ptr<const SinkFilter>{});
+}
+
+bool ISink::should_log(const LogRecord& record) const noexcept {
+  if (record.level() < level()) {
+    return false;
+  }
+  if (!has_filter_.load(std::memory_order_acquire)) {
+    return true;
+  }
+
+  const auto filter = std::atomic_load(&filter_);
+  if (!filter) {
+    return true;
+  }
+  try {
+    return (*filter)(record);
+  } catch (...) {
+    return false;
+  }
+}
+
+}  // namespace sim_logger
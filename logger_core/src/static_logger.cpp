@@ -0,0 +1,69 @@
+#include "logger/static_logger.hpp"
+
+#include "logger/logger.hpp"
+#include "logger/logger_registry.hpp"
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace sim_logger {
+
+namespace {
+
+/**
+ * @brief Loggers handed out through each StaticLogger.
+ *
+ * Per handle, the current Logger and the one it replaced are kept, so a Logger&
+ * obtained just before a LoggerRegistry::clear() outlives that clear, while a
+ * handle never pins more than two Loggers (and their sinks). Intentionally
+ * leaked so handles used during static destruction stay valid.
+ */
+struct Retained {
+  struct Slot {
+    std::shared_ptr<Logger> current;
+    std::shared_ptr<Logger> previous;
+  };
+
+  std::mutex m;
+  std::unordered_map<const StaticLogger*, Slot> slots;
+};
+
+Retained& retained() {
+  static auto* r = new Retained();
+  return *r;
+}
+
+}  // namespace
+
+Logger& StaticLogger::get() {
+  const std::uint64_t gen = LoggerRegistry::instance().generation();
+  if (generation_.load(std::memory_order_acquire) == gen) {
+    if (Logger* logger = logger_.load(std::memory_order_acquire)) {
+      return *logger;
+    }
+  }
+  return resolve_(gen);
+}
+
+Logger& StaticLogger::resolve_(std::uint64_t generation) {
+  auto logger = LoggerRegistry::instance().get_logger(name_ != nullptr ? name_ : "");
+  Logger* raw = logger.get();
+
+  auto& r = retained();
+  std::lock_guard<std::mutex> lk(r.m);
+  auto& slot = r.slots[this];
+  if (slot.current != logger) {
+    slot.previous = std::move(slot.current);
+    slot.current = std::move(logger);
+  }
+
+  // Published under the lock so the cached pointer is always slot.current.
+  // Pointer first, then the generation that validates it; a reader that pairs
+  // a stale pointer with a newer generation still gets a retained Logger.
+  logger_.store(raw, std::memory_order_release);
+  generation_.store(generation, std::memory_order_release);
+  return *raw;
+}
+
+}  // namespace sim_logger
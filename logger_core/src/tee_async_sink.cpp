@@ -0,0 +1,351 @@
+#include "logger/tee_async_sink.hpp"
+
+#include "logger/metrics.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace sim_logger {
+
+namespace {
+
+struct Slot {
+  std::optional<LogRecord> record;
+  /// Number of target backlogs (or in-flight batches) still referencing this slot.
+  std::uint32_t refs = 0;
+};
+
+std::atomic<std::uint64_t> g_tee_sink_seq{0};
+
+}  // namespace
+
+struct TeeAsyncSink::Impl {
+  struct Lane {
+    TeeTarget cfg;
+
+    /// Ring of slot indices (this target's backlog).
+    std::vector<std::uint32_t> ring;
+    std::size_t head = 0;
+    std::size_t count = 0;
+
+    std::condition_variable cv_work;
+    std::thread worker;
+
+    /// Last flush generation this lane has completed.
+    std::uint64_t flushed_gen = 0;
+
+    std::atomic<std::uint64_t> dropped{0};
+    std::atomic<std::uint64_t> failures{0};
+
+    void push(std::uint32_t slot) {
+      ring[(head + count) % ring.size()] = slot;
+      ++count;
+    }
+
+    std::uint32_t pop() {
+      const std::uint32_t slot = ring[head];
+      head = (head + 1) % ring.size();
+      --count;
+      return slot;
+    }
+  };
+
+  std::size_t max_batch;
+  std::string metrics_name;
+  std::uint64_t collector_id = 0;
+
+  mutable std::mutex m;
+  std::condition_variable cv_space;
+  std::condition_variable cv_flushed;
+
+  std::vector<Slot> slots;
+  std::vector<std::uint32_t> free_slots;
+  std::vector<std::unique_ptr<Lane>> lanes;
+
+  std::uint64_t flush_gen = 0;
+  bool stop = false;
+
+  void release_locked(std::uint32_t slot) {
+    if (--slots[slot].refs == 0) {
+      free_slots.push_back(slot);
+    }
+  }
+
+  bool has_room_locked(std::uint64_t block_mask) const {
+    for (std::size_t i = 0; i < lanes.size(); ++i) {
+      if ((block_mask >> i & 1U) != 0 && lanes[i]->count >= lanes[i]->cfg.capacity) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void stop_and_join() noexcept;
+  void worker_loop(Lane& lane) noexcept;
+};
+
+void TeeAsyncSink::Impl::stop_and_join() noexcept {
+  {
+    std::lock_guard<std::mutex> lk(m);
+    stop = true;
+  }
+  cv_space.notify_all();
+  for (auto& lane : lanes) {
+    lane->cv_work.notify_all();
+  }
+  for (auto& lane : lanes) {
+    if (lane->worker.joinable()) {
+      lane->worker.join();
+    }
+  }
+}
+
+void TeeAsyncSink::Impl::worker_loop(Lane& lane) noexcept {
+  std::vector<std::uint32_t> batch;
+  batch.reserve(max_batch);
+
+  std::unique_lock<std::mutex> lk(m);
+  for (;;) {
+    lane.cv_work.wait(lk, [&] { return stop || lane.count > 0 || lane.flushed_gen < flush_gen; });
+
+    while (lane.count > 0) {
+      while (lane.count > 0 && batch.size() < max_batch) {
+        batch.push_back(lane.pop());
+      }
+      lk.unlock();
+      cv_space.notify_all();
+
+      // Slots referenced by this batch are immutable until released below.
+      for (const std::uint32_t idx : batch) {
+        try {
+          lane.cfg.sink->write(*slots[idx].record);
+        } catch (...) {
+          lane.failures.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+
+      lk.lock();
+      for (const std::uint32_t idx : batch) {
+        release_locked(idx);
+      }
+      batch.clear();
+    }
+
+    if (lane.flushed_gen < flush_gen || stop) {
+      const std::uint64_t gen = flush_gen;
+      lk.unlock();
+      try {
+        lane.cfg.sink->flush();
+      } catch (...) {
+        lane.failures.fetch_add(1, std::memory_order_relaxed);
+      }
+      lk.lock();
+      lane.flushed_gen = gen;
+      cv_flushed.notify_all();
+    }
+
+    if (stop && lane.count == 0) {
+      break;
+    }
+  }
+}
+
+TeeAsyncSink::TeeAsyncSink(std::vector<TeeTarget> targets,
+                           std::size_t max_batch,
+                           std::string metrics_name)
+    : impl_(std::make_unique<Impl>()) {
+  if (targets.empty() || targets.size() > kMaxTargets) {
+    throw std::invalid_argument("TeeAsyncSink requires between 1 and 64 targets");
+  }
+
+  impl_->max_batch = (max_batch == 0) ? 1 : max_batch;
+
+  // Worst case, every backlog is full, every worker holds a full batch, and a
+  // producer claims one more slot before DropOldest releases an old one.
+  std::size_t pool = 1;
+  for (auto& t : targets) {
+    if (!t.sink) {
+      throw std::invalid_argument("TeeAsyncSink target requires a sink");
+    }
+    if (t.capacity == 0) {
+      t.capacity = 1;
+    }
+    pool += t.capacity + impl_->max_batch;
+
+    auto lane = std::make_unique<Impl::Lane>();
+    lane->cfg = std::move(t);
+    lane->ring.resize(lane->cfg.capacity);
+    impl_->lanes.push_back(std::move(lane));
+  }
+
+  impl_->slots.resize(pool);
+  impl_->free_slots.reserve(pool);
+  for (std::size_t i = pool; i > 0; --i) {
+    impl_->free_slots.push_back(static_cast<std::uint32_t>(i - 1));
+  }
+
+  impl_->metrics_name = metrics_name.empty()
+                            ? "tee-" + std::to_string(g_tee_sink_seq.fetch_add(1) + 1)
+                            : std::move(metrics_name);
+
+  // Registered before any worker starts, so a throw here leaves no thread behind.
+  impl_->collector_id = MetricsRegistry::instance().add_collector([this](MetricsSnapshot& out) {
+    const auto sample = [&](const char* name, MetricType type, const char* help, std::size_t lane,
+                            double v) {
+      MetricSample s;
+      s.name = name;
+      s.labels = {{"sink", impl_->metrics_name}, {"target", std::to_string(lane)}};
+      s.type = type;
+      s.help = help;
+      s.value = v;
+      out.push_back(std::move(s));
+    };
+    for (std::size_t i = 0; i < impl_->lanes.size(); ++i) {
+      sample("sim_logger_tee_queue_depth", MetricType::Gauge,
+             "Records queued for a TeeAsyncSink target", i, static_cast<double>(queue_depth(i)));
+      sample("sim_logger_tee_dropped_records_total", MetricType::Counter,
+             "Records dropped by a TeeAsyncSink target's overflow policy", i,
+             static_cast<double>(dropped_records_count(i)));
+      sample("sim_logger_tee_sink_failures_total", MetricType::Counter,
+             "Exceptions from a TeeAsyncSink target sink", i,
+             static_cast<double>(sink_failures_count(i)));
+    }
+  });
+
+  try {
+    for (auto& lane : impl_->lanes) {
+      Impl::Lane* l = lane.get();
+      l->worker = std::thread([this, l] { impl_->worker_loop(*l); });
+    }
+  } catch (...) {
+    impl_->stop_and_join();
+    MetricsRegistry::instance().remove_collector(impl_->collector_id);
+    throw;
+  }
+}
+
+TeeAsyncSink::~TeeAsyncSink() {
+  MetricsRegistry::instance().remove_collector(impl_->collector_id);
+  impl_->stop_and_join();
+}
+
+void TeeAsyncSink::write(const LogRecord& record) {
+  auto& im = *impl_;
+
+  // Decide targets before copying anything.
+  std::uint64_t want_mask = 0;
+  std::uint64_t block_mask = 0;
+  for (std::size_t i = 0; i < im.lanes.size(); ++i) {
+    const auto& cfg = im.lanes[i]->cfg;
+    if (cfg.sink->should_log(record)) {
+      want_mask |= std::uint64_t{1} << i;
+      if (cfg.overflow_policy == OverflowPolicy::Block) {
+        block_mask |= std::uint64_t{1} << i;
+      }
+    }
+  }
+  if (want_mask == 0) {
+    return;
+  }
+
+  // The single copy of the record, made outside the lock.
+  LogRecord copy = record;
+
+  std::unique_lock<std::mutex> lk(im.m);
+  im.cv_space.wait(lk, [&] { return im.stop || im.has_room_locked(block_mask); });
+  if (im.stop) {
+    return;
+  }
+
+  const std::uint32_t slot = im.free_slots.back();
+  im.free_slots.pop_back();
+  im.slots[slot].record = std::move(copy);
+  im.slots[slot].refs = 1;  // held by this call until every lane is handled
+
+  for (std::size_t i = 0; i < im.lanes.size(); ++i) {
+    if ((want_mask >> i & 1U) == 0) {
+      continue;
+    }
+    auto& lane = *im.lanes[i];
+    if (lane.count >= lane.cfg.capacity) {
+      lane.dropped.fetch_add(1, std::memory_order_relaxed);
+      if (lane.cfg.overflow_policy == OverflowPolicy::DropNewest) {
+        continue;
+      }
+      im.release_locked(lane.pop());  // DropOldest
+    }
+    ++im.slots[slot].refs;
+    lane.push(slot);
+    lane.cv_work.notify_one();
+  }
+
+  im.release_locked(slot);
+}
+
+void TeeAsyncSink::flush() {
+  auto& im = *impl_;
+  std::unique_lock<std::mutex> lk(im.m);
+  if (im.stop) {
+    return;
+  }
+  const std::uint64_t gen = ++im.flush_gen;
+  for (auto& lane : im.lanes) {
+    lane->cv_work.notify_one();
+  }
+  im.cv_flushed.wait(lk, [&] {
+    for (const auto& lane : im.lanes) {
+      if (lane->flushed_gen < gen) {
+        return false;
+      }
+    }
+    return true;
+  });
+}
+
+bool TeeAsyncSink::should_log(const LogRecord& record) const noexcept {
+  if (!ISink::should_log(record)) {
+    return false;
+  }
+  for (const auto& lane : impl_->lanes) {
+    if (lane->cfg.sink->should_log(record)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::size_t TeeAsyncSink::targets_count() const noexcept {
+  return impl_->lanes.size();
+}
+
+std::uint64_t TeeAsyncSink::dropped_records_count(std::size_t target) const noexcept {
+  return (target < impl_->lanes.size())
+             ? impl_->lanes[target]->dropped.load(std::memory_order_relaxed)
+             : 0;
+}
+
+std::uint64_t TeeAsyncSink::sink_failures_count(std::size_t target) const noexcept {
+  return (target < impl_->lanes.size())
+             ? impl_->lanes[target]->failures.load(std::memory_order_relaxed)
+             : 0;
+}
+
+std::size_t TeeAsyncSink::queue_depth(std::size_t target) const {
+  if (target >= impl_->lanes.size()) {
+    return 0;
+  }
+  std::lock_guard<std::mutex> lk(impl_->m);
+  return impl_->lanes[target]->count;
+}
+
+const std::string& TeeAsyncSink::metrics_name() const noexcept {
+  return impl_->metrics_name;
+}
+
+}  // namespace sim_logger
@@ -0,0 +1,95 @@
+#include "alloc_counter.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+namespace sim_logger::test {
+namespace {
+
+// Trivially initialized so it is safe to touch from any allocation, including
+// ones made while a thread is starting up.
+thread_local std::uint64_t tls_allocs = 0;
+
+void* counted_alloc(std::size_t size) noexcept {
+  ++tls_allocs;
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+void* counted_aligned_alloc(std::size_t size, std::size_t alignment) noexcept {
+  ++tls_allocs;
+  if (size == 0) {
+    size = 1;
+  }
+#if defined(_WIN32)
+  return ::_aligned_malloc(size, alignment);
+#else
+  void* p = nullptr;
+  if (alignment < sizeof(void*)) {
+    alignment = sizeof(void*);
+  }
+  return ::posix_memalign(&p, alignment, size) == 0 ? p : nullptr;
+#endif
+}
+
+void aligned_free(void* p) noexcept {
+#if defined(_WIN32)
+  ::_aligned_free(p);
+#else
+  std::free(p);
+#endif
+}
+
+void* throwing(void* p) {
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+}  // namespace
+
+std::uint64_t alloc_count() noexcept { return tls_allocs; }
+
+}  // namespace sim_logger::test
+
+using sim_logger::test::aligned_free;
+using sim_logger::test::counted_aligned_alloc;
+using sim_logger::test::counted_alloc;
+using sim_logger::test::throwing;
+
+void* operator new(std::size_t size) { return throwing(counted_alloc(size)); }
+void* operator new[](std::size_t size) { return throwing(counted_alloc(size)); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return counted_alloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return counted_alloc(size); }
+
+void* operator new(std::size_t size, std::align_val_t al) {
+  return throwing(counted_aligned_alloc(size, static_cast<std::size_t>(al)));
+}
+void* operator new[](std::size_t size, std::align_val_t al) {
+  return throwing(counted_aligned_alloc(size, static_cast<std::size_t>(al)));
+}
+void* operator new(std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept {
+  return counted_aligned_alloc(size, static_cast<std::size_t>(al));
+}
+void* operator new[](std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept {
+  return counted_aligned_alloc(size, static_cast<std::size_t>(al));
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+void operator delete(void* p, std::align_val_t) noexcept { aligned_free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { aligned_free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { aligned_free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { aligned_free(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { aligned_free(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { aligned_free(p); }
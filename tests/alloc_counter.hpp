@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+
+namespace sim_logger::test {
+
+/**
+ * @file alloc_counter.hpp
+ * @brief Per-thread count of global operator new calls, for zero-allocation tests.
+ *
+ * @details
+ * alloc_counter.cpp replaces every global operator new / new[] overload in the
+ * test executable and forwards to malloc. Allocations made directly through
+ * malloc (e.g. inside the C library) are not seen.
+ *
+ * Usage: take alloc_count() before and after the code under test on the same
+ * thread and compare.
+ */
+
+/**
+ * @brief Number of operator new calls made by the calling thread so far.
+ */
+std::uint64_t alloc_count() noexcept;
+
+}  // namespace sim_logger::test
@@ -1,13 +1,18 @@
 #include "logger/async_sink.hpp"
 #include "logger/detail/mutex_ring_buffer_queue.hpp"
+#include "logger/pattern_formatter.hpp"
 #include "logger/test_sink.hpp"
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <atomic>
 #include <chrono>
 #include <future>
+#include <mutex>
 #include <stdexcept>
+#include <string>
 #include <thread>
+#include <vector>
 
 using namespace sim_logger;
 
@@ -32,6 +37,44 @@ struct ThrowingSink final : ISink {
   void flush() override { throw std::runtime_error("boom"); }
 };
 
+// Records the message sequence and how many writes had landed at each flush.
+struct FlushTrackingSink final : ISink {
+  void write(const LogRecord& r) override {
+    std::lock_guard<std::mutex> lk(m);
+    messages.emplace_back(r.message());
+  }
+  void flush() override {
+    std::lock_guard<std::mutex> lk(m);
+    flushed_at.push_back(messages.size());
+    flushes.fetch_add(1);
+  }
+
+  std::mutex m;
+  std::vector<std::string> messages;
+  std::vector<std::size_t> flushed_at;
+  std::atomic<int> flushes{0};
+};
+
+// Text-style sink: exposes a formatter and records pre-rendered lines.
+struct LineSink final : ISink {
+  void write(const LogRecord& r) override {
+    std::lock_guard<std::mutex> lk(m);
+    lines.push_back(fmt.format(r));
+    ++unformatted_writes;
+  }
+  void write_formatted(const LogRecord&, std::string_view line) override {
+    std::lock_guard<std::mutex> lk(m);
+    lines.emplace_back(line);
+  }
+  void flush() override {}
+  const PatternFormatter* formatter() const noexcept override { return &fmt; }
+
+  PatternFormatter fmt{"{level} {msg}"};
+  std::mutex m;
+  std::vector<std::string> lines;
+  int unformatted_writes = 0;
+};
+
 }  // namespace
 
 TEST_CASE("MutexRingBufferQueue DropNewest drops deterministically", "[async][queue]") {
@@ -74,6 +117,50 @@ TEST_CASE("MutexRingBufferQueue DropOldest drops oldest deterministically", "[as
   REQUIRE(out[0].message() == "b");
 }
 
+TEST_CASE("MutexRingBufferQueue keeps priority records out of overflow drops", "[async][queue][priority]") {
+  const auto drain = [](detail::MutexRingBufferQueue& q) {
+    std::vector<LogRecord> out;
+    q.dequeue_batch(out, 10);
+    std::vector<std::string> messages;
+    for (const auto& r : out) {
+      messages.emplace_back(r.message());
+    }
+    return messages;
+  };
+
+  SECTION("DropNewest: an incoming priority record evicts the oldest") {
+    detail::MutexRingBufferQueue q(2, OverflowPolicy::DropNewest, Level::Error);
+    q.enqueue(make_record(Level::Info, "n1"));
+    q.enqueue(make_record(Level::Info, "n2"));
+
+    const auto p = q.enqueue(make_record(Level::Error, "p"));
+    REQUIRE(p.enqueued);
+    REQUIRE(p.dropped == 1);
+    REQUIRE(p.priority_dropped == 0);
+
+    const auto n3 = q.enqueue(make_record(Level::Info, "n3"));
+    REQUIRE_FALSE(n3.enqueued);
+    REQUIRE(drain(q) == std::vector<std::string>{"n2", "p"});
+  }
+
+  SECTION("DropOldest: normal records never evict a priority record") {
+    detail::MutexRingBufferQueue q(2, OverflowPolicy::DropOldest, Level::Error);
+    q.enqueue(make_record(Level::Error, "p1"));
+    q.enqueue(make_record(Level::Info, "n1"));
+
+    const auto n2 = q.enqueue(make_record(Level::Info, "n2"));
+    REQUIRE_FALSE(n2.enqueued);
+    REQUIRE(n2.dropped == 1);
+    REQUIRE(n2.priority_dropped == 0);
+
+    // Only a priority record can push out a priority record, and that is reported.
+    const auto p2 = q.enqueue(make_record(Level::Fatal, "p2"));
+    REQUIRE(p2.enqueued);
+    REQUIRE(p2.priority_dropped == 1);
+    REQUIRE(drain(q) == std::vector<std::string>{"n1", "p2"});
+  }
+}
+
 TEST_CASE("MutexRingBufferQueue Block blocks until space is available", "[async][queue]") {
   detail::MutexRingBufferQueue q(/*capacity*/ 1, OverflowPolicy::Block);
 
@@ -99,6 +186,46 @@ TEST_CASE("MutexRingBufferQueue Block blocks until space is available", "[async]
   REQUIRE(fut.get() == true);
 }
 
+TEST_CASE("MutexRingBufferQueue exchange_batch swaps records in FIFO order", "[async][queue]") {
+  detail::MutexRingBufferQueue q(/*capacity*/ 4, OverflowPolicy::DropOldest);
+
+  for (const char* m : {"a", "b", "c", "d", "e"}) {
+    REQUIRE(q.enqueue_copy(make_record(Level::Info, m)).enqueued);
+  }
+
+  std::vector<LogRecord> batch(3);
+  REQUIRE(q.exchange_batch(batch) == 3);
+  REQUIRE(batch[0].message() == "b");  // "a" was evicted
+  REQUIRE(batch[1].message() == "c");
+  REQUIRE(batch[2].message() == "d");
+
+  REQUIRE(q.exchange_batch(batch) == 1);
+  REQUIRE(batch[0].message() == "e");
+  REQUIRE(q.exchange_batch(batch) == 0);
+  REQUIRE(q.empty());
+}
+
+TEST_CASE("MutexRingBufferQueue enqueue_copy stages the copy when the lock is held",
+          "[async][queue]") {
+  detail::MutexRingBufferQueue q(/*capacity*/ 4, OverflowPolicy::Block);
+  const LogRecord first = make_record(Level::Info, std::string(64, 'x'));
+  const LogRecord second = make_record(Level::Warn, "second");
+
+  std::unique_lock<std::mutex> held(q.mutex());
+  auto fut = std::async(std::launch::async, [&] {
+    return q.enqueue_copy(first).enqueued && q.enqueue_copy(second).enqueued;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  held.unlock();
+  REQUIRE(fut.get());
+
+  std::vector<LogRecord> batch(4);
+  REQUIRE(q.exchange_batch(batch) == 2);
+  REQUIRE(batch[0].message() == first.message());
+  REQUIRE(batch[1].level() == Level::Warn);
+  REQUIRE(batch[1].message() == "second");
+}
+
 TEST_CASE("AsyncSink flush drains and delivers to wrapped sink", "[async][sink]") {
   auto wrapped = std::make_shared<TestSink>();
   AsyncOptions opt;
@@ -132,3 +259,202 @@ TEST_CASE("AsyncSink contains wrapped sink exceptions and increments failure cou
 
   REQUIRE(async.sink_failures_count() > 0);
 }
+
+TEST_CASE("AsyncSink priority records flush the wrapped sink without an explicit flush",
+          "[async][sink][priority]") {
+  auto wrapped = std::make_shared<FlushTrackingSink>();
+  AsyncOptions opt;
+  opt.capacity = 64;
+  opt.overflow_policy = OverflowPolicy::Block;
+  opt.priority_level = Level::Warn;
+
+  AsyncSink async(wrapped, opt);
+
+  async.write(make_record(Level::Info, "a"));
+  async.write(make_record(Level::Debug, "b"));
+  async.write(make_record(Level::Error, "c"));
+
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (wrapped->flushes.load() == 0 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  REQUIRE(wrapped->flushes.load() >= 1);
+  REQUIRE(async.priority_flushes_count() >= 1);
+
+  std::lock_guard<std::mutex> lk(wrapped->m);
+  // Normal-lane records queued before the priority record are written first.
+  REQUIRE(wrapped->messages == std::vector<std::string>{"a", "b", "c"});
+  REQUIRE(wrapped->flushed_at.front() == 3);
+}
+
+TEST_CASE("AsyncSink flushes right after a priority record, mid-batch", "[async][sink][priority]") {
+  // Holds the worker in its first write so the next records form one batch.
+  struct GatedSink final : ISink {
+    void write(const LogRecord& r) override {
+      if (r.message() == "gate") {
+        entered.set_value();
+        release.wait();
+      }
+      tracker.write(r);
+    }
+    void flush() override { tracker.flush(); }
+
+    FlushTrackingSink tracker;
+    std::promise<void> entered;
+    std::shared_future<void> release;
+  };
+
+  auto wrapped = std::make_shared<GatedSink>();
+  std::promise<void> release;
+  wrapped->release = release.get_future().share();
+  auto entered = wrapped->entered.get_future();
+
+  AsyncOptions opt;
+  opt.capacity = 64;
+  opt.priority_level = Level::Error;
+  AsyncSink async(wrapped, opt);
+
+  async.write(make_record(Level::Info, "gate"));
+  entered.wait();
+  async.write(make_record(Level::Info, "a"));
+  async.write(make_record(Level::Error, "b"));
+  async.write(make_record(Level::Info, "c"));
+  async.write(make_record(Level::Info, "d"));
+  release.set_value();
+  async.flush();
+
+  std::lock_guard<std::mutex> lk(wrapped->tracker.m);
+  REQUIRE(wrapped->tracker.messages == std::vector<std::string>{"gate", "a", "b", "c", "d"});
+  // Flushed after "b", before the rest of its batch, then by the explicit flush().
+  REQUIRE(wrapped->tracker.flushed_at == std::vector<std::size_t>{3, 5});
+  REQUIRE(async.priority_flushes_count() == 1);
+}
+
+TEST_CASE("AsyncSink without a priority level never flushes on its own", "[async][sink][priority]") {
+  auto wrapped = std::make_shared<FlushTrackingSink>();
+  AsyncOptions opt;
+  opt.capacity = 16;
+
+  AsyncSink async(wrapped, opt);
+  async.write(make_record(Level::Fatal, "x"));
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  REQUIRE(wrapped->flushes.load() == 0);
+  REQUIRE(async.priority_flushes_count() == 0);
+
+  async.flush();
+  REQUIRE(wrapped->flushes.load() == 1);
+}
+
+TEST_CASE("AsyncSink linger holds small batches until min_batch is reached", "[async][sink][linger]") {
+  auto wrapped = std::make_shared<TestSink>();
+  AsyncOptions opt;
+  opt.capacity = 64;
+  opt.linger = std::chrono::seconds(10);
+  opt.min_batch = 4;
+
+  AsyncSink async(wrapped, opt);
+
+  async.write(make_record(Level::Info, "a"));
+  async.write(make_record(Level::Info, "b"));
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  REQUIRE(wrapped->size() == 0);
+
+  async.write(make_record(Level::Info, "c"));
+  async.write(make_record(Level::Info, "d"));
+
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (wrapped->size() < 4 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  REQUIRE(wrapped->size() == 4);
+}
+
+TEST_CASE("AsyncSink linger alone waits for a full batch", "[async][sink][linger]") {
+  auto wrapped = std::make_shared<TestSink>();
+  AsyncOptions opt;
+  opt.capacity = 64;
+  opt.max_batch = 4;
+  opt.linger = std::chrono::seconds(10);  // min_batch left at its default
+
+  AsyncSink async(wrapped, opt);
+
+  for (const char* m : {"a", "b", "c"}) {
+    async.write(make_record(Level::Info, m));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  REQUIRE(wrapped->size() == 0);
+
+  async.write(make_record(Level::Info, "d"));
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (wrapped->size() < 4 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  REQUIRE(wrapped->size() == 4);
+}
+
+TEST_CASE("AsyncSink flush and priority records preempt the linger", "[async][sink][linger]") {
+  auto wrapped = std::make_shared<FlushTrackingSink>();
+  AsyncOptions opt;
+  opt.capacity = 64;
+  opt.linger = std::chrono::seconds(10);
+  opt.min_batch = 32;
+  opt.priority_level = Level::Error;
+
+  AsyncSink async(wrapped, opt);
+
+  const auto start = std::chrono::steady_clock::now();
+  async.write(make_record(Level::Info, "a"));
+  async.flush();
+  REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::seconds(5));
+  REQUIRE(wrapped->flushes.load() == 1);
+
+  async.write(make_record(Level::Info, "b"));
+  async.write(make_record(Level::Error, "c"));
+
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (wrapped->flushes.load() < 2 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  std::lock_guard<std::mutex> lk(wrapped->m);
+  REQUIRE(wrapped->messages == std::vector<std::string>{"a", "b", "c"});
+  REQUIRE(wrapped->flushed_at.back() == 3);
+}
+
+TEST_CASE("AsyncSink parallel formatting preserves queue order", "[async][sink][format]") {
+  auto wrapped = std::make_shared<LineSink>();
+  AsyncOptions opt;
+  opt.capacity = 256;
+  opt.max_batch = 64;
+  opt.format_threads = 3;
+
+  AsyncSink async(wrapped, opt);
+
+  constexpr int kCount = 2000;
+  for (int i = 0; i < kCount; ++i) {
+    async.write(make_record(Level::Info, std::to_string(i)));
+  }
+  async.flush();
+
+  std::lock_guard<std::mutex> lk(wrapped->m);
+  REQUIRE(wrapped->lines.size() == static_cast<std::size_t>(kCount));
+  for (int i = 0; i < kCount; ++i) {
+    REQUIRE(wrapped->lines[static_cast<std::size_t>(i)] == "INFO " + std::to_string(i));
+  }
+  REQUIRE(wrapped->unformatted_writes == 0);
+}
+
+TEST_CASE("AsyncSink format_threads falls back to write() for non-text sinks",
+          "[async][sink][format]") {
+  auto wrapped = std::make_shared<TestSink>();
+  AsyncOptions opt;
+  opt.format_threads = 2;
+
+  AsyncSink async(wrapped, opt);
+  async.write(make_record(Level::Info, "x"));
+  async.flush();
+
+  REQUIRE(wrapped->size() == 1);
+}
@@ -0,0 +1,104 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "logger/backtrace.hpp"
+#include "logger/logger.hpp"
+#include "logger/test_sink.hpp"
+
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace sim_logger {
+namespace {
+
+LogRecord make_record(Level level, std::string message, std::int64_t wall_time_ns) {
+  return LogRecord(level,
+                   /*sim_time=*/1.0,
+                   /*mission_elapsed=*/2.0,
+                   wall_time_ns,
+                   /*thread_id=*/std::this_thread::get_id(),
+                   /*file=*/"f.cpp",
+                   /*line=*/7U,
+                   /*function=*/"func",
+                   /*logger_name=*/"bt",
+                   /*tags=*/{},
+                   std::move(message));
+}
+
+}  // namespace
+
+TEST_CASE("Backtrace captures filtered records and dumps them before an error", "[backtrace]") {
+  auto logger = std::make_shared<Logger>("bt");
+  auto sink = std::make_shared<TestSink>();
+  logger->set_sinks({sink});
+  logger->set_level(Level::Info);
+
+  enable_backtrace(sink, BacktraceOptions{2, Level::Error});
+
+  logger->log(make_record(Level::Debug, "d1", 1));
+  logger->log(make_record(Level::Debug, "d2", 2));
+  logger->log(make_record(Level::Debug, "d3", 3));
+  logger->log(make_record(Level::Info, "i4", 4));
+  REQUIRE(sink->size() == 1);
+
+  logger->log(make_record(Level::Error, "e5", 5));
+
+  const auto records = sink->snapshot();
+  REQUIRE(records.size() == 4);
+  REQUIRE(records[0].message() == "i4");
+  REQUIRE(records[1].message() == "d2");
+  REQUIRE(records[2].message() == "d3");
+  REQUIRE(records[3].message() == "e5");
+
+  disable_backtrace();
+}
+
+TEST_CASE("dump_backtrace merges all thread rings by timestamp", "[backtrace]") {
+  auto logger = std::make_shared<Logger>("bt");
+  auto real = std::make_shared<TestSink>();
+  auto traces = std::make_shared<TestSink>();
+  logger->set_sinks({real});
+  logger->set_level(Level::Warn);
+
+  enable_backtrace(traces, BacktraceOptions{8, Level::Fatal});
+
+  std::thread a([&] {
+    logger->log(make_record(Level::Debug, "a1", 10));
+    logger->log(make_record(Level::Debug, "a3", 30));
+  });
+  std::thread b([&] {
+    logger->log(make_record(Level::Info, "b2", 20));
+    logger->log(make_record(Level::Info, "b4", 40));
+  });
+  a.join();
+  b.join();
+
+  REQUIRE(real->size() == 0);
+  REQUIRE(traces->size() == 0);
+
+  dump_backtrace();
+
+  const auto records = traces->snapshot();
+  REQUIRE(records.size() == 4);
+  REQUIRE(records[0].message() == "a1");
+  REQUIRE(records[1].message() == "b2");
+  REQUIRE(records[2].message() == "a3");
+  REQUIRE(records[3].message() == "b4");
+
+  disable_backtrace();
+}
+
+TEST_CASE("Disabled backtrace captures nothing", "[backtrace]") {
+  auto logger = std::make_shared<Logger>("bt");
+  auto sink = std::make_shared<TestSink>();
+  logger->set_sinks({sink});
+  logger->set_level(Level::Info);
+
+  disable_backtrace();
+  logger->log(make_record(Level::Debug, "d", 1));
+  logger->log(make_record(Level::Error, "e", 2));
+
+  REQUIRE(sink->size() == 1);
+}
+
+}  // namespace sim_logger
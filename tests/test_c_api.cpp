@@ -1,7 +1,113 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include "logger/logger.hpp"
+#include "logger/logger_registry.hpp"
+#include "logger/test_sink.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+
 extern "C" int sim_logger_c_api_smoke(void);
+extern "C" int sim_logger_c_api_is_enabled(const char* name, int level);
+extern "C" void sim_logger_c_api_macros(int step);
+extern "C" void sim_logger_c_api_structured(void);
+extern "C" int sim_logger_c_api_sinks(const char* path);
 
 TEST_CASE("C API compiles and links", "[c_api]") {
   REQUIRE(sim_logger_c_api_smoke() == 0);
 }
+
+TEST_CASE("sim_logger_is_enabled follows the logger level", "[c_api]") {
+  using namespace sim_logger;
+  LoggerRegistry::instance().clear();
+  LoggerRegistry::instance().get_logger("c.enabled")->set_level(Level::Warn);
+
+  REQUIRE(sim_logger_c_api_is_enabled("c.enabled", 1) == 0);  // INFO
+  REQUIRE(sim_logger_c_api_is_enabled("c.enabled", 2) == 1);  // WARN
+  REQUIRE(sim_logger_c_api_is_enabled("c.enabled", 4) == 1);  // FATAL
+}
+
+TEST_CASE("SIM_LOG_* macros cache handles and survive registry resets", "[c_api]") {
+  using namespace sim_logger;
+  auto& reg = LoggerRegistry::instance();
+  reg.clear();
+
+  auto sink = std::make_shared<TestSink>();
+  reg.get_logger("c.macros")->set_sinks({sink});
+
+  sim_logger_c_api_macros(1);
+  auto records = sink->snapshot();
+  REQUIRE(records.size() == 2);  // DEBUG filtered by the default INFO level
+  REQUIRE(records[0].message() == "info step=1");
+  REQUIRE(records[0].logger_name() == "c.macros");
+  REQUIRE(records[1].message() == "no args");
+  REQUIRE(records[1].level() == Level::Warn);
+
+  reg.get_logger("c.macros")->set_level(Level::Debug);
+  sink->clear();
+  sim_logger_c_api_macros(2);
+  REQUIRE(sink->size() == 3);
+
+  // After clear() the cached handles re-resolve to the new logger.
+  reg.clear();
+  auto fresh = std::make_shared<TestSink>();
+  reg.get_logger("c.macros")->set_sinks({fresh});
+  sim_logger_c_api_macros(3);
+  REQUIRE(fresh->size() == 2);
+  REQUIRE(sink->size() == 3);
+
+  // The macros' early level check still shows up in the logger's stats.
+  const auto stats = reg.get_logger("c.macros")->stats();
+  REQUIRE(stats.filtered[static_cast<std::size_t>(Level::Debug)] == 1);
+  REQUIRE(stats.emitted[static_cast<std::size_t>(Level::Info)] == 1);
+  REQUIRE(stats.emitted[static_cast<std::size_t>(Level::Warn)] == 1);
+}
+
+TEST_CASE("sim_logger_log_n and sim_logger_log_kv", "[c_api]") {
+  using namespace sim_logger;
+  auto& reg = LoggerRegistry::instance();
+  reg.clear();
+
+  auto sink = std::make_shared<TestSink>();
+  reg.get_logger("c.structured")->set_sinks({sink});
+
+  sim_logger_c_api_structured();
+
+  const auto records = sink->snapshot();
+  REQUIRE(records.size() == 2);
+  REQUIRE(records[0].message() == "telemetry-frame");
+  REQUIRE(records[0].tags().empty());
+
+  REQUIRE(records[1].message() == "state");
+  const auto& tags = records[1].tags();
+  REQUIRE(tags.size() == 5);
+  REQUIRE((tags[0].key == "mode" && tags[0].value == "cruise"));
+  REQUIRE((tags[1].key == "step" && tags[1].value == "-3"));
+  REQUIRE((tags[2].key == "frame" && tags[2].value == "42"));
+  REQUIRE((tags[3].key == "dt" && tags[3].value == "0.25"));
+  REQUIRE((tags[4].key == "ok" && tags[4].value == "true"));
+}
+
+TEST_CASE("C API builds file and async sinks and attaches them", "[c_api]") {
+  using namespace sim_logger;
+  LoggerRegistry::instance().clear();
+
+  const auto path = std::filesystem::temp_directory_path() / "sim_logger_c_api_sinks.log";
+  std::filesystem::remove(path);
+
+  REQUIRE(sim_logger_c_api_sinks(path.string().c_str()) == 0);
+
+  // Detach so the async sink (and its worker) is destroyed before reading.
+  LoggerRegistry::instance().clear();
+
+  std::ifstream in(path);
+  std::stringstream content;
+  content << in.rdbuf();
+  REQUIRE(content.str() == "DEBUG from C\nERROR priority\n");
+
+  in.close();
+  std::filesystem::remove(path);
+}
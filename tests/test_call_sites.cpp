@@ -0,0 +1,212 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "logger/call_site.hpp"
+#include "logger/log_macros.hpp"
+#include "logger/logger_registry.hpp"
+#include "logger/test_sink.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace sim_logger {
+namespace {
+
+// Both sites live on known lines so tests can address them by range.
+constexpr unsigned kDebugLine = __LINE__ + 3;
+constexpr unsigned kInfoLine = __LINE__ + 3;
+void emit_pair(const std::shared_ptr<Logger>& logger, int i) {
+  LOG_DEBUGF(logger, "debug %d", i);
+  LOG_INFOF(logger, "info %d", i);
+}
+
+const CallSiteInfo* find_site(const std::vector<CallSiteInfo>& sites, unsigned line) {
+  const auto it = std::find_if(sites.begin(), sites.end(), [&](const CallSiteInfo& s) {
+    return s.line == line && s.file.find("test_call_sites.cpp") != std::string::npos;
+  });
+  return it == sites.end() ? nullptr : &*it;
+}
+
+// A chatty short statement and a rare long one, for the profiler.
+constexpr unsigned kChattyLine = __LINE__ + 4;
+constexpr unsigned kBulkyLine = __LINE__ + 5;
+void emit_profiled(const std::shared_ptr<Logger>& logger, int i) {
+  for (int k = 0; k < 9; ++k) {
+    LOG_INFOF(logger, "tick %d", k);
+  }
+  LOG_INFO(logger, std::string(200, static_cast<char>('a' + i % 26)));
+  LOG_DEBUGF(logger, "filtered %d", i);
+}
+
+std::string range(unsigned first, unsigned last) {
+  return "test_call_sites.cpp:" + std::to_string(first) + "-" + std::to_string(last);
+}
+
+}  // namespace
+
+TEST_CASE("Call sites register lazily and count hits while profiling", "[call_sites]") {
+  LoggerRegistry::instance().clear();
+  clear_call_site_rules();
+
+  auto logger = LoggerRegistry::instance().get_logger("sites");
+  auto sink = std::make_shared<TestSink>();
+  logger->set_sinks({sink});
+  logger->set_level(Level::Info);
+
+  const auto initial = call_sites();
+  const auto* before = find_site(initial, kInfoLine);
+  const std::uint64_t base_hits = before != nullptr ? before->hits : 0;
+  const auto* debug_before = find_site(initial, kDebugLine);
+  const std::uint64_t base_debug_hits = debug_before != nullptr ? debug_before->hits : 0;
+
+  emit_pair(logger, 1);  // registers, but hits are not counted
+  set_call_site_profiling(true);
+  emit_pair(logger, 2);
+  emit_pair(logger, 3);
+  set_call_site_profiling(false);
+
+  const auto sites = call_sites();
+  const auto* info = find_site(sites, kInfoLine);
+  const auto* debug = find_site(sites, kDebugLine);
+  REQUIRE(info != nullptr);
+  REQUIRE(debug != nullptr);
+  REQUIRE(info->hits == base_hits + 2);
+  REQUIRE(debug->hits == base_debug_hits + 2);  // filtered calls are hits too
+  REQUIRE(info->level == Level::Info);
+  REQUIRE(info->function == "emit_pair");
+  REQUIRE(info->state == CallSiteState::Default);
+
+  REQUIRE(sink->size() == 3U);  // DEBUG filtered by the logger level
+}
+
+TEST_CASE("set_call_sites forces sites on or off by file and line range", "[call_sites]") {
+  LoggerRegistry::instance().clear();
+  clear_call_site_rules();
+
+  auto logger = LoggerRegistry::instance().get_logger("sites");
+  auto sink = std::make_shared<TestSink>();
+  logger->set_sinks({sink});
+  logger->set_level(Level::Info);
+  emit_pair(logger, 0);  // make sure both sites are registered
+  sink->clear();
+
+  SECTION("Enabled bypasses the logger level") {
+    REQUIRE(set_call_sites(range(kDebugLine, kDebugLine), CallSiteState::Enabled) == 1U);
+    emit_pair(logger, 1);
+    const auto records = sink->snapshot();
+    REQUIRE(records.size() == 2U);
+    REQUIRE(records[0].level() == Level::Debug);
+    REQUIRE(records[0].message() == "debug 1");
+  }
+
+  SECTION("Disabled skips the site and its arguments") {
+    REQUIRE(set_call_sites(range(kDebugLine, kInfoLine), CallSiteState::Disabled) == 2U);
+    emit_pair(logger, 1);
+    REQUIRE(sink->size() == 0U);
+
+    int evaluated = 0;
+    auto side_effect = [&]() {
+      ++evaluated;
+      return std::string("x");
+    };
+    const unsigned line = __LINE__ + 3;
+    set_call_sites("test_call_sites.cpp:" + std::to_string(line), CallSiteState::Disabled);
+    for (int i = 0; i < 3; ++i) {
+      LOG_ERROR(logger, side_effect());
+    }
+    // The site registers and picks up the rule before its arguments are
+    // evaluated, so even the first pass skips the message expression.
+    REQUIRE(sink->size() == 0U);
+    REQUIRE(evaluated == 0);
+    const auto sites = call_sites();
+    const auto* site = find_site(sites, line);
+    REQUIRE(site != nullptr);
+    REQUIRE(site->state == CallSiteState::Disabled);
+  }
+
+  SECTION("Later rules win and Default resets") {
+    set_call_sites("*call_sites.cpp", CallSiteState::Disabled);
+    set_call_sites(range(kInfoLine, kInfoLine), CallSiteState::Default);
+    emit_pair(logger, 1);
+    REQUIRE(sink->size() == 1U);
+    REQUIRE(sink->snapshot()[0].message() == "info 1");
+
+    clear_call_site_rules();
+    const auto sites = call_sites();
+    REQUIRE(find_site(sites, kDebugLine)->state == CallSiteState::Default);
+  }
+
+  clear_call_site_rules();
+}
+
+TEST_CASE("Call-site profiling ranks sites by records, bytes and time", "[call_sites]") {
+  LoggerRegistry::instance().clear();
+  clear_call_site_rules();
+
+  auto logger = LoggerRegistry::instance().get_logger("profiled");
+  auto sink = std::make_shared<TestSink>();
+  logger->set_sinks({sink});
+  logger->set_level(Level::Info);
+
+  emit_profiled(logger, 0);  // registers the sites; profiling is still off
+  reset_call_site_profiles();
+  {
+    const auto sites = call_sites();
+    REQUIRE(find_site(sites, kChattyLine)->records == 0U);
+    REQUIRE(find_site(sites, kChattyLine)->hits == 0U);
+  }
+
+  set_call_site_profiling(true);
+  REQUIRE(call_site_profiling());
+  for (int i = 0; i < 10; ++i) {
+    emit_profiled(logger, i);
+  }
+  set_call_site_profiling(false);
+  emit_profiled(logger, 99);  // not counted
+
+  const auto sites = call_sites();
+  const auto* chatty = find_site(sites, kChattyLine);
+  const auto* bulky = find_site(sites, kBulkyLine);
+  REQUIRE(chatty != nullptr);
+  REQUIRE(bulky != nullptr);
+  REQUIRE(chatty->records == 90U);
+  REQUIRE(chatty->bytes == 90U * std::string("tick 0").size());
+  REQUIRE(bulky->records == 10U);
+  REQUIRE(bulky->bytes == 2000U);
+  REQUIRE(chatty->frontend_ns > 0U);
+  // The filtered DEBUG statement builds no records.
+  REQUIRE(find_site(sites, kBulkyLine + 1)->records == 0U);
+
+  const auto by_records = top_call_sites(1, CallSiteOrder::Records);
+  REQUIRE(by_records.size() == 1U);
+  REQUIRE(by_records[0].line == kChattyLine);
+  const auto by_bytes = top_call_sites(5, CallSiteOrder::Bytes);
+  REQUIRE(by_bytes.size() == 2U);  // sites without profiled records are skipped
+  REQUIRE(by_bytes[0].line == kBulkyLine);
+  REQUIRE(top_call_sites(5, CallSiteOrder::Time).size() == 2U);
+
+  const std::string report = call_site_report(2, CallSiteOrder::Records);
+  REQUIRE(report.find("top 2 call sites by records (100 records profiled)") == 0U);
+  REQUIRE(report.find("test_call_sites.cpp:" + std::to_string(kChattyLine)) <
+          report.find("test_call_sites.cpp:" + std::to_string(kBulkyLine)));
+  REQUIRE(report.find("90.0%") != std::string::npos);
+  REQUIRE(report.find("100.0%") != std::string::npos);
+
+  REQUIRE(call_site_order_from_string("bytes") == CallSiteOrder::Bytes);
+  REQUIRE_FALSE(call_site_order_from_string("calls").has_value());
+
+  reset_call_site_profiles();
+  REQUIRE(top_call_sites(10).empty());
+}
+
+TEST_CASE("set_call_sites rejects malformed specs", "[call_sites]") {
+  REQUIRE_THROWS_AS(set_call_sites("", CallSiteState::Enabled), std::invalid_argument);
+  REQUIRE_THROWS_AS(set_call_sites(":10", CallSiteState::Enabled), std::invalid_argument);
+  REQUIRE_THROWS_AS(set_call_sites("a.cpp:30-10", CallSiteState::Enabled), std::invalid_argument);
+  REQUIRE_THROWS_AS(set_call_sites("a.cpp:-", CallSiteState::Enabled), std::invalid_argument);
+  REQUIRE(set_call_sites("no_such_file.cpp:1-2", CallSiteState::Enabled) == 0U);
+  clear_call_site_rules();
+}
+
+}  // namespace sim_logger
@@ -0,0 +1,128 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "logger/async_sink.hpp"
+#include "logger/config.hpp"
+#include "logger/log_macros.hpp"
+#include "logger/logger.hpp"
+#include "logger/logger_registry.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+namespace sim_logger {
+namespace {
+
+std::string read_all_text(const std::filesystem::path& p) {
+  std::ifstream ifs(p, std::ios::in | std::ios::binary);
+  REQUIRE(ifs.good());
+  return std::string((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+}
+
+}  // namespace
+
+TEST_CASE("Config parses sinks, loggers and registry rules", "[config]") {
+  const auto spec = parse_config(R"(
+# topology
+[registry]
+level_rules = vehicle*.gnc=debug
+
+[sink.console]
+type    = console
+pattern = {level};{msg}   ; trailing comment
+color   = never
+
+[sink.file_async]
+type           = async
+target         = console
+capacity       = 64
+overflow       = drop_newest
+linger_us      = 500
+min_batch      = 8
+
+[logger.vehicle1]
+level = warn
+sinks = console, file_async
+)");
+
+  REQUIRE(spec.sinks.size() == 2);
+  REQUIRE(spec.sinks[0].options.at("pattern") == "{level};{msg}");
+  REQUIRE(spec.sinks[1].type == "async");
+  REQUIRE(spec.loggers.size() == 1);
+  REQUIRE(spec.loggers[0].level == Level::Warn);
+  REQUIRE(spec.loggers[0].sinks == std::vector<std::string>{"console", "file_async"});
+  REQUIRE(spec.level_rules == std::string("vehicle*.gnc=debug"));
+}
+
+TEST_CASE("Config rejects invalid input with line numbers", "[config]") {
+  const auto error_of = [](const char* text) -> std::string {
+    try {
+      parse_config(text);
+    } catch (const ConfigError& e) {
+      return e.what();
+    }
+    return {};
+  };
+
+  REQUIRE(error_of("[sink.a]\ntype = bogus\n") == "2: unknown sink type 'bogus'");
+  REQUIRE(error_of("[sink.a]\ntype = console\nmax_bytes = 3\n").rfind("1: ", 0) == 0);
+  REQUIRE(error_of("[sink.a]\ntype = async\ntarget = missing\n").find("unknown sink") !=
+          std::string::npos);
+  REQUIRE(error_of("[sink.a]\ntype = async\ntarget = b\n[sink.b]\ntype = async\ntarget = a\n")
+              .find("cycle") != std::string::npos);
+  REQUIRE(error_of("[logger.x]\nsinks = nope\n").find("unknown sink 'nope'") != std::string::npos);
+  REQUIRE(error_of("[logger.x]\nlevel = loud\n") == "2: 'level' expects a level, got 'loud'");
+  REQUIRE(error_of("[sink.a]\ntype = async\ntarget = a2\ncapacity = -1\n[sink.a2]\ntype = console\n")
+              .find("non-negative integer") != std::string::npos);
+  REQUIRE(error_of("level = info\n").rfind("1: ", 0) == 0);
+  REQUIRE(error_of("[oops]\n") == "1: unknown section 'oops'");
+}
+
+TEST_CASE("Config applies a file + async topology to the registry", "[config]") {
+  auto& reg = LoggerRegistry::instance();
+  reg.clear();
+  reg.clear_level_rules();
+
+  const auto path = std::filesystem::temp_directory_path() / "sim_logger_config_test.log";
+  std::filesystem::remove(path);
+
+  const auto spec = parse_config("[sink.file]\ntype = file\npattern = {logger} {msg}\npath = " +
+                                 path.string() +
+                                 "\n[sink.async]\ntype = async\ntarget = file\nlevel = info\n"
+                                 "[logger.vehicle1]\nlevel = debug\nsinks = async\n");
+  const auto applied = apply_config(spec, reg);
+
+  REQUIRE(applied.sinks.size() == 2);
+  auto async = std::dynamic_pointer_cast<AsyncSink>(applied.sinks.at("async"));
+  REQUIRE(async);
+  REQUIRE(async->level() == Level::Info);
+
+  auto gnc = reg.get_logger("vehicle1.gnc");
+  REQUIRE(gnc->effective_level() == Level::Debug);
+  LOG_INFO(gnc, "hello");
+  LOG_DEBUG(gnc, "filtered by sink level");
+  async->flush();
+
+  REQUIRE(read_all_text(path) == "vehicle1.gnc hello\n");
+
+  reg.clear();
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("describe_config resolves inherited levels and sinks", "[config]") {
+  const auto spec = parse_config(
+      "[registry]\nlevel_rules = *.gnc=debug\n"
+      "[sink.c]\ntype = console\n"
+      "[logger.root]\nsinks = c\n"
+      "[logger.v1.gnc]\n"
+      "[logger.v1.sensors]\nlevel = error\n");
+
+  const std::string tree = describe_config(spec);
+  REQUIRE(tree.find("  root level=INFO (default) sinks=[c] (set)") != std::string::npos);
+  REQUIRE(tree.find("    v1 level=INFO (inherited) sinks=[c] (inherited)") != std::string::npos);
+  REQUIRE(tree.find("      v1.gnc level=DEBUG (rule)") != std::string::npos);
+  REQUIRE(tree.find("      v1.sensors level=ERROR (set)") != std::string::npos);
+}
+
+}  // namespace sim_logger
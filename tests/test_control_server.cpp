@@ -0,0 +1,276 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "logger/call_site.hpp"
+#include "logger/control_server.hpp"
+#include "logger/flight_recorder_sink.hpp"
+#include "logger/log_macros.hpp"
+#include "logger/logger.hpp"
+#include "logger/logger_registry.hpp"
+#include "logger/test_sink.hpp"
+
+#if !defined(_WIN32)
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace sim_logger {
+namespace {
+
+LogRecord make_record(Level level, std::string message) {
+  return LogRecord(level,
+                   /*sim_time=*/1.0,
+                   /*mission_elapsed=*/2.0,
+                   /*wall_time_ns=*/3,
+                   /*thread_id=*/std::this_thread::get_id(),
+                   /*file=*/"f.cpp",
+                   /*line=*/7U,
+                   /*function=*/"func",
+                   /*logger_name=*/"a.b",
+                   /*tags=*/{},
+                   std::move(message));
+}
+
+std::string send_command(const std::string& path, const std::string& command) {
+  const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  REQUIRE(fd >= 0);
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+  REQUIRE(::connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == 0);
+
+  const std::string line = command + "\n";
+  REQUIRE(::write(fd, line.data(), line.size()) == static_cast<ssize_t>(line.size()));
+
+  std::string reply;
+  char buf[512];
+  ssize_t n = 0;
+  while ((n = ::read(fd, buf, sizeof(buf))) > 0) {
+    reply.append(buf, static_cast<std::size_t>(n));
+  }
+  ::close(fd);
+  return reply;
+}
+
+}  // namespace
+
+TEST_CASE("ControlServer level command adjusts levels by glob", "[control]") {
+  auto& reg = LoggerRegistry::instance();
+  reg.clear();
+  reg.clear_level_rules();
+
+  auto gnc = reg.get_logger("vehicle1.gnc");
+  ControlServer server("/unused.sock");
+
+  REQUIRE(server.execute("level vehicle*.gnc debug") == "ok changed 1 loggers");
+  REQUIRE(gnc->effective_level() == Level::Debug);
+  REQUIRE(server.execute("levels") == "ok\nvehicle*.gnc=DEBUG");
+
+  REQUIRE(server.execute("level vehicle*.gnc reset") == "ok changed 1 loggers");
+  REQUIRE(gnc->effective_level() == Level::Info);
+
+  // A level set in code or config ranks above rules; the command suspends it.
+  gnc->set_level(Level::Error);
+  REQUIRE(server.execute("level vehicle1.* debug") ==
+          "ok changed 1 loggers, suspended 1 explicit levels");
+  REQUIRE(gnc->effective_level() == Level::Debug);
+  REQUIRE_FALSE(gnc->level_override());
+  REQUIRE(server.execute("level vehicle1.* debug") == "ok changed 0 loggers");
+  REQUIRE(server.execute("level vehicle1.* reset") ==
+          "ok changed 1 loggers, restored 1 explicit levels");
+  reg.clear_level_rules();
+  gnc->clear_level_override();
+
+  REQUIRE(server.execute("level x loud").rfind("error:", 0) == 0);
+  REQUIRE(server.execute("bogus").rfind("error:", 0) == 0);
+  REQUIRE(server.execute("help").rfind("ok", 0) == 0);
+}
+
+TEST_CASE("ControlServer site command toggles LOG_* call sites", "[control]") {
+  auto& reg = LoggerRegistry::instance();
+  reg.clear();
+  clear_call_site_rules();
+
+  auto logger = reg.get_logger("sites");
+  auto sink = std::make_shared<TestSink>();
+  logger->set_sinks({sink});
+
+  ControlServer server("/unused.sock");
+  const unsigned line = __LINE__ + 2;
+  for (int i = 0; i < 2; ++i) {
+    LOG_DEBUG(logger, std::string("quiet"));
+    if (i == 0) {
+      REQUIRE(server.execute("site test_control_server.cpp:" + std::to_string(line) + " on") ==
+              "ok matched 1 sites");
+    }
+  }
+  REQUIRE(sink->size() == 1);
+  REQUIRE(server.execute("sites").find("test_control_server.cpp:" + std::to_string(line)) !=
+          std::string::npos);
+  REQUIRE(server.execute("site x.cpp maybe").rfind("error:", 0) == 0);
+  REQUIRE(server.execute("site x.cpp:9-1 on").rfind("error:", 0) == 0);
+  clear_call_site_rules();
+}
+
+TEST_CASE("ControlServer profile and hot commands report chatty call sites", "[control]") {
+  auto& reg = LoggerRegistry::instance();
+  reg.clear();
+  reset_call_site_profiles();
+
+  auto logger = reg.get_logger("hot");
+  logger->set_sinks({std::make_shared<TestSink>()});
+
+  ControlServer server("/unused.sock");
+  REQUIRE(server.execute("profile on") == "ok");
+  const unsigned line = __LINE__ + 2;
+  for (int i = 0; i < 5; ++i) {
+    LOG_INFOF(logger, "hot %d", i);
+  }
+  REQUIRE(server.execute("profile off") == "ok");
+
+  const std::string reply = server.execute("hot 3 bytes");
+  REQUIRE(reply.rfind("ok\ntop 1 call sites by bytes", 0) == 0);
+  REQUIRE(reply.find("test_control_server.cpp:" + std::to_string(line)) != std::string::npos);
+  REQUIRE(server.execute("hot").rfind("ok\ntop 1 call sites by records", 0) == 0);
+  REQUIRE(server.execute("hot lots").rfind("error:", 0) == 0);
+  REQUIRE(server.execute("profile maybe").rfind("error:", 0) == 0);
+
+  REQUIRE(server.execute("profile reset") == "ok");
+  REQUIRE(server.execute("hot").rfind("ok\ntop 0 call sites", 0) == 0);
+}
+
+TEST_CASE("ControlServer flush, metrics and dump commands", "[control]") {
+  auto& reg = LoggerRegistry::instance();
+  reg.clear();
+
+  auto sink = std::make_shared<TestSink>();
+  reg.get_logger("vehicle1")->set_sinks({sink});
+
+  auto dump_target = std::make_shared<TestSink>();
+  auto recorder = std::make_shared<FlightRecorderSink>(dump_target);
+  recorder->write(make_record(Level::Info, "kept"));
+
+  ControlServer server("/unused.sock");
+  server.register_sink("recorder", recorder);
+
+  REQUIRE(server.execute("flush") == "ok flushed 2 sinks");
+
+  const std::string metrics = server.execute("metrics");
+  REQUIRE(metrics.find("logger vehicle1 level=INFO dropped=0") != std::string::npos);
+  REQUIRE(metrics.find("sink recorder retained=1 dumps=0") != std::string::npos);
+
+  const std::string prom = server.execute("metrics prometheus");
+  REQUIRE(prom.rfind("ok\n", 0) == 0);
+  REQUIRE(prom.find("sim_logger_logger_dropped_records_total{logger=\"vehicle1\"} 0") !=
+          std::string::npos);
+  REQUIRE(server.execute("metrics json").rfind("error:", 0) == 0);
+
+  const std::string stats = server.execute("stats vehicle1*");
+  REQUIRE(stats.find("logger vehicle1 emitted=0 filtered=0 bytes=0 DEBUG=0/0") != std::string::npos);
+  REQUIRE(stats.find("total vehicle1* emitted=0") != std::string::npos);
+
+  REQUIRE(server.execute("dump recorder") == "ok dumped 1 flight recorders");
+  REQUIRE(dump_target->size() == 1);
+  REQUIRE(server.execute("dump nope").rfind("error:", 0) == 0);
+}
+
+TEST_CASE("ControlServer level reset restores explicit levels", "[control]") {
+  auto& reg = LoggerRegistry::instance();
+  reg.clear();
+  reg.clear_level_rules();
+
+  auto gnc = reg.get_logger("vehicle1.gnc");
+  auto nav = reg.get_logger("vehicle1.nav");
+  gnc->set_level(Level::Warn);  // as set in code or by [logger.X] level= in a config file
+  ControlServer server("/unused.sock");
+
+  REQUIRE(server.execute("level vehicle1.gnc debug") ==
+          "ok changed 1 loggers, suspended 1 explicit levels");
+  REQUIRE(gnc->effective_level() == Level::Debug);
+
+  REQUIRE(server.execute("level vehicle1.gnc reset") ==
+          "ok changed 1 loggers, restored 1 explicit levels");
+  REQUIRE(gnc->effective_level() == Level::Warn);
+  REQUIRE(gnc->level_override() == Level::Warn);
+  REQUIRE(server.execute("levels") == "ok");
+
+  // A level set explicitly while the rule was active is kept on reset.
+  nav->set_level(Level::Error);
+  REQUIRE(server.execute("level vehicle1.nav debug") ==
+          "ok changed 1 loggers, suspended 1 explicit levels");
+  nav->set_level(Level::Info);
+  REQUIRE(server.execute("level vehicle1.nav reset") == "ok changed 0 loggers");
+  REQUIRE(nav->effective_level() == Level::Info);
+
+  gnc->clear_level_override();
+  nav->clear_level_override();
+}
+
+TEST_CASE("ControlServer start refuses to replace a file that is not a socket", "[control]") {
+  const auto path = (std::filesystem::temp_directory_path() /
+                     ("sim_logger_ctl_file_" + std::to_string(::getpid())))
+                        .string();
+  {
+    std::ofstream out(path);
+    out << "not a socket\n";
+  }
+
+  ControlServer server(path);
+  REQUIRE_THROWS_AS(server.start(), std::runtime_error);
+  REQUIRE_FALSE(server.running());
+  REQUIRE(std::filesystem::is_regular_file(path));
+  REQUIRE(std::filesystem::file_size(path) > 0);
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("ControlServer serves commands over a Unix domain socket", "[control]") {
+  auto& reg = LoggerRegistry::instance();
+  reg.clear();
+  reg.clear_level_rules();
+  auto sensors = reg.get_logger("vehicle1.sensors");
+
+  const auto path =
+      (std::filesystem::temp_directory_path() / ("sim_logger_ctl_" + std::to_string(::getpid())))
+          .string();
+
+  // A stale socket left by a previous run is replaced.
+  {
+    const int stale = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    REQUIRE(::bind(stale, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == 0);
+    ::close(stale);
+  }
+  REQUIRE(std::filesystem::is_socket(path));
+
+  ControlServer server(path);
+  server.start();
+  REQUIRE(server.running());
+  REQUIRE_THROWS(server.start());
+
+  REQUIRE(send_command(path, "level *.sensors error") == "ok changed 1 loggers\n");
+  REQUIRE((std::filesystem::status(path).permissions() &
+           (std::filesystem::perms::group_all | std::filesystem::perms::others_all)) ==
+          std::filesystem::perms::none);
+  REQUIRE(sensors->effective_level() == Level::Error);
+  REQUIRE(send_command(path, "levels") == "ok\n*.sensors=ERROR\n");
+
+  server.stop();
+  REQUIRE_FALSE(server.running());
+  REQUIRE_FALSE(std::filesystem::exists(path));
+
+  reg.clear_level_rules();
+}
+
+}  // namespace sim_logger
+
+#endif  // !defined(_WIN32)
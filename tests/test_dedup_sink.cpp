@@ -0,0 +1,125 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "logger/dedup_sink.hpp"
+#include "logger/metrics.hpp"
+#include "logger/test_sink.hpp"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace sim_logger {
+namespace {
+
+LogRecord make_record(std::string message, std::int64_t wall_time_ns, std::uint32_t line = 7U) {
+  return LogRecord(Level::Warn,
+                   /*sim_time=*/1.0,
+                   /*mission_elapsed=*/2.0,
+                   wall_time_ns,
+                   /*thread_id=*/std::this_thread::get_id(),
+                   /*file=*/"f.cpp",
+                   line,
+                   /*function=*/"func",
+                   /*logger_name=*/"sensors",
+                   /*tags=*/{},
+                   std::move(message));
+}
+
+}  // namespace
+
+TEST_CASE("DedupSink suppresses consecutive duplicates and summarizes the run", "[dedup]") {
+  auto wrapped = std::make_shared<TestSink>();
+  DedupSink dedup(wrapped, DedupOptions{std::chrono::seconds(10), {}});
+
+  dedup.write(make_record("sensor timeout", 1));
+  dedup.write(make_record("sensor timeout", 2));
+  dedup.write(make_record("sensor timeout", 3));
+  dedup.write(make_record("sensor recovered", 4));
+
+  const auto records = wrapped->snapshot();
+  REQUIRE(records.size() == 3);
+  REQUIRE(records[0].message() == "sensor timeout");
+  REQUIRE(records[1].message() == "last message repeated 2 times");
+  REQUIRE(records[1].wall_time_ns() == 3);
+  REQUIRE(records[2].message() == "sensor recovered");
+  REQUIRE(dedup.suppressed_records_count() == 2);
+}
+
+TEST_CASE("DedupSink restarts the run when the window expires", "[dedup]") {
+  auto wrapped = std::make_shared<TestSink>();
+  DedupSink dedup(wrapped, DedupOptions{std::chrono::nanoseconds(100), {}});
+
+  dedup.write(make_record("tick", 0));
+  dedup.write(make_record("tick", 50));
+  dedup.write(make_record("tick", 150));
+
+  const auto records = wrapped->snapshot();
+  REQUIRE(records.size() == 3);
+  REQUIRE(records[1].message() == "last message repeated 1 times");
+  REQUIRE(records[2].message() == "tick");
+}
+
+TEST_CASE("DedupSink tracks call sites independently and flush emits summaries", "[dedup]") {
+  auto wrapped = std::make_shared<TestSink>();
+  DedupSink dedup(wrapped);
+
+  dedup.write(make_record("same", 1, /*line=*/10U));
+  dedup.write(make_record("same", 2, /*line=*/20U));
+  dedup.write(make_record("same", 3, /*line=*/10U));
+  REQUIRE(wrapped->size() == 2);
+
+  dedup.flush();
+
+  const auto records = wrapped->snapshot();
+  REQUIRE(records.size() == 3);
+  REQUIRE(records[2].message() == "last message repeated 1 times");
+  REQUIRE(records[2].line() == 10U);
+}
+
+TEST_CASE("DedupSink forwards a pending summary when destroyed", "[dedup]") {
+  auto wrapped = std::make_shared<TestSink>();
+  auto dedup = std::make_unique<DedupSink>(wrapped, DedupOptions{std::chrono::seconds(10), {}});
+
+  dedup->write(make_record("sensor timeout", 1));
+  dedup->write(make_record("sensor timeout", 2));
+  dedup->write(make_record("sensor timeout", 3));
+  REQUIRE(wrapped->size() == 1);
+
+  dedup.reset();
+
+  const auto records = wrapped->snapshot();
+  REQUIRE(records.size() == 2);
+  REQUIRE(records[1].message() == "last message repeated 2 times");
+  REQUIRE(records[1].wall_time_ns() == 3);
+}
+
+TEST_CASE("DedupSink publishes suppressed records and tracked sites as metrics", "[dedup]") {
+  auto wrapped = std::make_shared<TestSink>();
+  DedupOptions opt;
+  opt.window = std::chrono::seconds(10);
+  opt.metrics_name = "test-dedup";
+  auto dedup = std::make_unique<DedupSink>(wrapped, opt);
+
+  dedup->write(make_record("sensor timeout", 1));
+  dedup->write(make_record("sensor timeout", 2));
+  dedup->write(make_record("sensor timeout", 3));
+  dedup->write(make_record("other site", 4, /*line=*/9U));
+
+  const auto value = [](const std::string& name) {
+    for (const auto& s : MetricsRegistry::instance().snapshot()) {
+      if (s.name == name && s.labels == MetricLabels{{"sink", "test-dedup"}}) {
+        return s.value;
+      }
+    }
+    return -1.0;
+  };
+
+  REQUIRE(value("sim_logger_dedup_suppressed_records_total") == 2.0);
+  REQUIRE(value("sim_logger_dedup_tracked_sites") == 2.0);
+
+  dedup.reset();
+  REQUIRE(value("sim_logger_dedup_tracked_sites") == -1.0);
+}
+
+}  // namespace sim_logger
@@ -0,0 +1,204 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "logger/failover_sink.hpp"
+#include "logger/metrics.hpp"
+#include "logger/test_sink.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sim_logger {
+namespace {
+
+LogRecord make_record(std::string message) {
+  return LogRecord(Level::Info,
+                   /*sim_time=*/1.0,
+                   /*mission_elapsed=*/2.0,
+                   /*wall_time_ns=*/3,
+                   /*thread_id=*/std::this_thread::get_id(),
+                   /*file=*/"f.cpp",
+                   /*line=*/7U,
+                   /*function=*/"func",
+                   /*logger_name=*/"a.b",
+                   /*tags=*/{},
+                   std::move(message));
+}
+
+class FlakySink final : public ISink {
+ public:
+  void write(const LogRecord&) override {
+    if (fail.load()) {
+      throw std::runtime_error("primary down");
+    }
+    if (delay.count() > 0) {
+      std::this_thread::sleep_for(delay);
+    }
+    writes.fetch_add(1);
+  }
+  void flush() override {}
+
+  std::atomic<bool> fail{false};
+  std::chrono::milliseconds delay{0};
+  std::atomic<int> writes{0};
+};
+
+}  // namespace
+
+TEST_CASE("FailoverSink switches after consecutive errors without losing records", "[failover]") {
+  auto primary = std::make_shared<FlakySink>();
+  auto secondary = std::make_shared<TestSink>();
+
+  FailoverOptions opt;
+  opt.max_consecutive_failures = 2;
+  opt.probe_interval = std::chrono::hours(1);
+  FailoverSink sink(primary, secondary, opt);
+
+  sink.write(make_record("ok"));
+  REQUIRE(primary->writes == 1);
+
+  primary->fail = true;
+  sink.write(make_record("e1"));
+  REQUIRE_FALSE(sink.on_secondary());
+  sink.write(make_record("e2"));
+  REQUIRE(sink.on_secondary());
+  sink.write(make_record("s3"));
+
+  REQUIRE(secondary->size() == 3);
+  REQUIRE(sink.failovers_count() == 1);
+  REQUIRE(sink.primary_errors_count() == 2);
+}
+
+TEST_CASE("FailoverSink probes the primary and switches back when it recovers", "[failover]") {
+  auto primary = std::make_shared<FlakySink>();
+  auto secondary = std::make_shared<TestSink>();
+
+  FailoverOptions opt;
+  opt.max_consecutive_failures = 1;
+  opt.probe_interval = std::chrono::milliseconds(0);
+  FailoverSink sink(primary, secondary, opt);
+
+  primary->fail = true;
+  sink.write(make_record("e1"));
+  REQUIRE(sink.on_secondary());
+
+  // Probe fails: record still lands on the secondary.
+  sink.write(make_record("e2"));
+  REQUIRE(sink.on_secondary());
+  REQUIRE(secondary->size() == 2);
+
+  primary->fail = false;
+  sink.write(make_record("probe"));
+  REQUIRE_FALSE(sink.on_secondary());
+  REQUIRE(primary->writes == 1);
+  REQUIRE(sink.failbacks_count() == 1);
+}
+
+TEST_CASE("FailoverSink treats slow primary writes as failures", "[failover]") {
+  auto primary = std::make_shared<FlakySink>();
+  auto secondary = std::make_shared<TestSink>();
+  primary->delay = std::chrono::milliseconds(20);
+
+  FailoverOptions opt;
+  opt.max_write_latency = std::chrono::milliseconds(1);
+  opt.max_consecutive_failures = 2;
+  opt.probe_interval = std::chrono::hours(1);
+  FailoverSink sink(primary, secondary, opt);
+
+  sink.write(make_record("slow1"));
+  sink.write(make_record("slow2"));
+  REQUIRE(sink.on_secondary());
+  REQUIRE(sink.primary_slow_writes_count() == 2);
+
+  // Slow writes succeeded, so they are not duplicated on the secondary.
+  REQUIRE(primary->writes == 2);
+  REQUIRE(secondary->size() == 0);
+
+  sink.write(make_record("fast"));
+  REQUIRE(secondary->size() == 1);
+}
+
+TEST_CASE("FailoverSink watchdog ignores a steady stream of overlapping fast writes", "[failover]") {
+  auto primary = std::make_shared<FlakySink>();
+  auto secondary = std::make_shared<TestSink>();
+  primary->delay = std::chrono::milliseconds(2);
+
+  FailoverOptions opt;
+  opt.max_write_latency = std::chrono::milliseconds(100);
+  opt.probe_interval = std::chrono::hours(1);
+  FailoverSink sink(primary, secondary, opt);
+
+  // Four writers keep at least one primary write in flight for well over
+  // max_write_latency, but no single write is slow.
+  const auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(400);
+  std::vector<std::thread> writers;
+  for (int t = 0; t < 4; ++t) {
+    writers.emplace_back([&] {
+      while (std::chrono::steady_clock::now() < until) {
+        sink.write(make_record("w"));
+      }
+    });
+  }
+  for (auto& w : writers) {
+    w.join();
+  }
+
+  REQUIRE_FALSE(sink.on_secondary());
+  REQUIRE(sink.failovers_count() == 0);
+  REQUIRE(secondary->size() == 0);
+}
+
+TEST_CASE("FailoverSink publishes switch events as metrics", "[failover]") {
+  auto primary = std::make_shared<FlakySink>();
+  auto secondary = std::make_shared<TestSink>();
+
+  FailoverOptions opt;
+  opt.max_consecutive_failures = 1;
+  opt.probe_interval = std::chrono::hours(1);
+  opt.metrics_name = "test-failover";
+  auto sink = std::make_unique<FailoverSink>(primary, secondary, opt);
+
+  primary->fail = true;
+  sink->write(make_record("e"));
+  REQUIRE(sink->on_secondary());
+
+  const auto find = [](const MetricsSnapshot& snap, const std::string& name,
+                       const std::string& direction) -> const MetricSample* {
+    for (const auto& s : snap) {
+      if (s.name != name) {
+        continue;
+      }
+      bool sink_ok = false;
+      bool dir_ok = direction.empty();
+      for (const auto& [k, v] : s.labels) {
+        sink_ok |= (k == "sink" && v == "test-failover");
+        dir_ok |= (k == "direction" && v == direction);
+      }
+      if (sink_ok && dir_ok) {
+        return &s;
+      }
+    }
+    return nullptr;
+  };
+
+  const auto snap = MetricsRegistry::instance().snapshot();
+  const auto* failovers = find(snap, "sim_logger_failover_switches_total", "failover");
+  const auto* failbacks = find(snap, "sim_logger_failover_switches_total", "failback");
+  const auto* on_secondary = find(snap, "sim_logger_failover_on_secondary", "");
+  REQUIRE(failovers != nullptr);
+  REQUIRE(failovers->value == 1.0);
+  REQUIRE(failbacks != nullptr);
+  REQUIRE(failbacks->value == 0.0);
+  REQUIRE(on_secondary != nullptr);
+  REQUIRE(on_secondary->value == 1.0);
+
+  sink.reset();
+  REQUIRE(find(MetricsRegistry::instance().snapshot(), "sim_logger_failover_on_secondary", "") ==
+          nullptr);
+}
+
+}  // namespace sim_logger
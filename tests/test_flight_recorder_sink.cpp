@@ -0,0 +1,107 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "logger/flight_recorder_sink.hpp"
+#include "logger/metrics.hpp"
+#include "logger/test_sink.hpp"
+
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace sim_logger {
+namespace {
+
+LogRecord make_record(Level level, std::string message) {
+  return LogRecord(level,
+                   /*sim_time=*/1.0,
+                   /*mission_elapsed=*/2.0,
+                   /*wall_time_ns=*/3,
+                   /*thread_id=*/std::this_thread::get_id(),
+                   /*file=*/"f.cpp",
+                   /*line=*/7U,
+                   /*function=*/"func",
+                   /*logger_name=*/"a.b",
+                   /*tags=*/{},
+                   std::move(message));
+}
+
+}  // namespace
+
+TEST_CASE("FlightRecorderSink writes nothing until triggered", "[flight_recorder]") {
+  auto target = std::make_shared<TestSink>();
+  FlightRecorderSink recorder(target, FlightRecorderOptions{4, Level::Error, {}});
+
+  for (int i = 0; i < 10; ++i) {
+    recorder.write(make_record(Level::Debug, "d" + std::to_string(i)));
+  }
+  recorder.flush();
+
+  REQUIRE(target->size() == 0);
+  REQUIRE(recorder.size() == 4);
+}
+
+TEST_CASE("FlightRecorderSink dumps the last N records on trigger level", "[flight_recorder]") {
+  auto target = std::make_shared<TestSink>();
+  FlightRecorderSink recorder(target, FlightRecorderOptions{3, Level::Error, {}});
+
+  for (int i = 0; i < 5; ++i) {
+    recorder.write(make_record(Level::Debug, "d" + std::to_string(i)));
+  }
+  recorder.write(make_record(Level::Error, "boom"));
+
+  const auto records = target->snapshot();
+  REQUIRE(records.size() == 3);
+  REQUIRE(records[0].message() == "d3");
+  REQUIRE(records[1].message() == "d4");
+  REQUIRE(records[2].message() == "boom");
+
+  REQUIRE(recorder.size() == 0);
+  REQUIRE(recorder.dumps_count() == 1);
+}
+
+TEST_CASE("FlightRecorderSink explicit dump drains the ring", "[flight_recorder]") {
+  auto target = std::make_shared<TestSink>();
+  FlightRecorderSink recorder(target);
+
+  recorder.write(make_record(Level::Info, "a"));
+  recorder.write(make_record(Level::Warn, "b"));
+  recorder.dump();
+  recorder.dump();  // empty ring: no-op
+
+  REQUIRE(target->size() == 2);
+  REQUIRE(recorder.dumps_count() == 1);
+}
+
+TEST_CASE("FlightRecorderSink publishes dumps and retained records as metrics",
+          "[flight_recorder]") {
+  auto target = std::make_shared<TestSink>();
+  FlightRecorderOptions opt;
+  opt.capacity = 8;
+  opt.metrics_name = "test-recorder";
+  auto recorder = std::make_unique<FlightRecorderSink>(target, opt);
+
+  const auto value = [](const std::string& name) {
+    for (const auto& s : MetricsRegistry::instance().snapshot()) {
+      if (s.name == name && s.labels == MetricLabels{{"sink", "test-recorder"}}) {
+        return s.value;
+      }
+    }
+    return -1.0;
+  };
+
+  for (int i = 0; i < 3; ++i) {
+    recorder->write(make_record(Level::Debug, "d" + std::to_string(i)));
+  }
+  REQUIRE(value("sim_logger_flight_recorder_records") == 3.0);
+  REQUIRE(value("sim_logger_flight_recorder_dumps_total") == 0.0);
+
+  recorder->write(make_record(Level::Error, "boom"));
+  REQUIRE(value("sim_logger_flight_recorder_records") == 0.0);
+  REQUIRE(value("sim_logger_flight_recorder_dumps_total") == 1.0);
+  REQUIRE(value("sim_logger_flight_recorder_sink_failures_total") == 0.0);
+
+  recorder.reset();
+  REQUIRE(value("sim_logger_flight_recorder_dumps_total") == -1.0);
+}
+
+}  // namespace sim_logger
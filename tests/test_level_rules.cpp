@@ -0,0 +1,87 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "logger/logger.hpp"
+#include "logger/logger_registry.hpp"
+
+#include <stdexcept>
+
+namespace sim_logger {
+
+TEST_CASE("Level rules parse globs, bare levels and whitespace", "[level_rules]") {
+  const auto rules = LoggerRegistry::parse_level_rules(" vehicle*.gnc = debug ,*.sensors=warn,error");
+  REQUIRE(rules.size() == 3);
+  REQUIRE(rules[0].pattern == "vehicle*.gnc");
+  REQUIRE(rules[0].level == Level::Debug);
+  REQUIRE(rules[1].pattern == "*.sensors");
+  REQUIRE(rules[1].level == Level::Warn);
+  REQUIRE(rules[2].pattern == "*");
+  REQUIRE(rules[2].level == Level::Error);
+
+  REQUIRE(LoggerRegistry::parse_level_rules("").empty());
+  REQUIRE_THROWS_AS(LoggerRegistry::parse_level_rules("a=loud"), std::invalid_argument);
+  REQUIRE_THROWS_AS(LoggerRegistry::parse_level_rules("=debug"), std::invalid_argument);
+}
+
+TEST_CASE("Level rules apply to existing and future loggers", "[level_rules]") {
+  auto& reg = LoggerRegistry::instance();
+  reg.clear();
+  reg.clear_level_rules();
+
+  auto gnc1 = reg.get_logger("vehicle1.gnc");
+  auto sensors1 = reg.get_logger("vehicle1.sensors");
+  REQUIRE(gnc1->effective_level() == Level::Info);
+
+  reg.set_level_rules("vehicle*.gnc=debug,*.sensors=warn");
+  REQUIRE(gnc1->effective_level() == Level::Debug);
+  REQUIRE(sensors1->effective_level() == Level::Warn);
+  REQUIRE(reg.get_logger("vehicle1")->effective_level() == Level::Info);
+
+  auto gnc2 = reg.get_logger("vehicle2.gnc");
+  REQUIRE(gnc2->effective_level() == Level::Debug);
+
+  reg.clear_level_rules();
+  REQUIRE(gnc1->effective_level() == Level::Info);
+  REQUIRE(gnc2->effective_level() == Level::Info);
+}
+
+TEST_CASE("Level rules: last match wins and explicit levels take precedence", "[level_rules]") {
+  auto& reg = LoggerRegistry::instance();
+  reg.clear();
+
+  reg.set_level_rules("*=error,vehicle1.*=debug");
+  auto gnc = reg.get_logger("vehicle1.gnc");
+  auto other = reg.get_logger("vehicle2.gnc");
+  REQUIRE(gnc->effective_level() == Level::Debug);
+  REQUIRE(other->effective_level() == Level::Error);
+
+  gnc->set_level(Level::Fatal);
+  REQUIRE(gnc->effective_level() == Level::Fatal);
+  gnc->clear_level_override();
+  REQUIRE(gnc->effective_level() == Level::Debug);
+
+  reg.clear_level_rules();
+}
+
+TEST_CASE("Cached effective level follows parent changes", "[level_rules]") {
+  auto& reg = LoggerRegistry::instance();
+  reg.clear();
+  reg.clear_level_rules();
+
+  auto root = reg.get_logger("root");
+  auto leaf = reg.get_logger("a.b.c");
+  REQUIRE(leaf->effective_level() == Level::Info);
+
+  root->set_level(Level::Warn);
+  REQUIRE(leaf->effective_level() == Level::Warn);
+
+  reg.get_logger("a")->set_level(Level::Debug);
+  REQUIRE(leaf->effective_level() == Level::Debug);
+
+  reg.set_level_rules("a.b=error");
+  REQUIRE(leaf->effective_level() == Level::Error);
+
+  reg.clear_level_rules();
+  REQUIRE(leaf->effective_level() == Level::Debug);
+}
+
+}  // namespace sim_logger
@@ -0,0 +1,118 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "logger/log_macros.hpp"
+#include "logger/logger_registry.hpp"
+#include "logger/metrics.hpp"
+#include "logger/test_sink.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sim_logger {
+namespace {
+
+std::size_t idx(Level level) { return static_cast<std::size_t>(level); }
+
+}  // namespace
+
+TEST_CASE("Logger counts emitted and filtered records per level", "[stats]") {
+  auto& reg = LoggerRegistry::instance();
+  reg.clear();
+  auto logger = reg.get_logger("stats.basic");
+  logger->set_level(Level::Info);
+  auto a = std::make_shared<TestSink>();
+  auto b = std::make_shared<TestSink>();
+  b->set_level(Level::Warn);
+  logger->set_sinks({a, b});
+
+  LOG_DEBUGF(logger, "debug %d", 1);
+  LOG_DEBUG(logger, "debug");
+  LOG_INFO(logger, "12345");    // a only
+  LOG_WARNF(logger, "%s", "abc");  // a and b
+  logger->log(LogRecord(Level::Debug, 0, 0, 0, std::this_thread::get_id(), "f", 1, "fn",
+                        "stats.basic", {}, "direct"));
+
+  const LoggerStats s = logger->stats();
+  REQUIRE(s.name == "stats.basic");
+  REQUIRE(s.filtered[idx(Level::Debug)] == 3);
+  REQUIRE(s.emitted[idx(Level::Info)] == 1);
+  REQUIRE(s.emitted[idx(Level::Warn)] == 1);
+  REQUIRE(s.emitted_total() == 2);
+  REQUIRE(s.filtered_total() == 3);
+  REQUIRE(s.bytes == 5 + 3 + 3);  // per sink write
+
+  reg.clear();
+}
+
+TEST_CASE("Logger stats are exact under concurrent logging", "[stats]") {
+  auto& reg = LoggerRegistry::instance();
+  reg.clear();
+  auto logger = reg.get_logger("stats.threads");
+  logger->set_sinks({});
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; ++t) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < 1000; ++i) {
+        LOG_INFO(logger, "x");
+        LOG_DEBUG(logger, "y");
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  const LoggerStats s = logger->stats();
+  REQUIRE(s.emitted[idx(Level::Info)] == 8000);
+  REQUIRE(s.filtered[idx(Level::Debug)] == 8000);
+  REQUIRE(s.bytes == 0);  // no sinks
+  reg.clear();
+}
+
+TEST_CASE("LoggerRegistry aggregates stats by name pattern", "[stats]") {
+  auto& reg = LoggerRegistry::instance();
+  reg.clear();
+  auto sink = std::make_shared<TestSink>();
+  reg.get_logger("root")->set_sinks({sink});
+
+  auto gnc = reg.get_logger("vehicle1.gnc");
+  auto prop = reg.get_logger("vehicle1.prop");
+  auto other = reg.get_logger("vehicle2.gnc");
+  LOG_INFO(gnc, "a");
+  LOG_INFO(gnc, "b");
+  LOG_ERROR(prop, "c");
+  LOG_DEBUG(prop, "d");
+  LOG_INFO(other, "e");
+
+  const auto per_logger = reg.logger_stats("vehicle1.*");
+  REQUIRE(per_logger.size() == 2);
+  REQUIRE(per_logger[0].name == "vehicle1.gnc");
+  REQUIRE(per_logger[1].name == "vehicle1.prop");
+
+  const LoggerStats total = reg.total_logger_stats("vehicle1.*");
+  REQUIRE(total.name == "vehicle1.*");
+  REQUIRE(total.emitted[idx(Level::Info)] == 2);
+  REQUIRE(total.emitted[idx(Level::Error)] == 1);
+  REQUIRE(total.filtered[idx(Level::Debug)] == 1);
+  REQUIRE(total.bytes == 3);
+
+  REQUIRE(reg.total_logger_stats().emitted_total() == 4);
+
+  // Also published through the metrics registry.
+  const auto snap = MetricsRegistry::instance().snapshot();
+  const auto it = std::find_if(snap.begin(), snap.end(), [](const MetricSample& m) {
+    return m.name == "sim_logger_logger_records_total" &&
+           m.labels == MetricLabels{{"logger", "vehicle1.gnc"}, {"level", "INFO"}, {"outcome", "emitted"}};
+  });
+  REQUIRE(it != snap.end());
+  REQUIRE(it->value == 2);
+
+  reg.clear();
+}
+
+}  // namespace sim_logger
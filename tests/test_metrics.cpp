@@ -0,0 +1,211 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "logger/async_sink.hpp"
+#include "logger/file_sink.hpp"
+#include "logger/log_macros.hpp"
+#include "logger/logger_registry.hpp"
+#include "logger/metrics.hpp"
+#include "logger/test_sink.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sim_logger {
+namespace {
+
+const MetricSample* find_sample(const MetricsSnapshot& snap, const std::string& name,
+                                const MetricLabels& labels) {
+  const auto it = std::find_if(snap.begin(), snap.end(), [&](const MetricSample& s) {
+    return s.name == name && s.labels == labels;
+  });
+  return it == snap.end() ? nullptr : &*it;
+}
+
+std::string read_file(const std::filesystem::path& path) {
+  std::ifstream in(path);
+  std::stringstream ss;
+  ss << in.rdbuf();
+  return ss.str();
+}
+
+}  // namespace
+
+TEST_CASE("ShardedCounter sums increments from many threads", "[metrics]") {
+  ShardedCounter counter;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; ++t) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < 10000; ++i) {
+        counter.add();
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  counter.add(5);
+  REQUIRE(counter.value() == 80005);
+}
+
+TEST_CASE("Gauge and Histogram track values", "[metrics]") {
+  Gauge g;
+  g.set(2.5);
+  g.add(-1.0);
+  REQUIRE(g.value() == 1.5);
+
+  Histogram h({1.0, 10.0});
+  h.observe(0.5);
+  h.observe(1.0);  // inclusive upper bound
+  h.observe(7.0);
+  h.observe(100.0);
+  REQUIRE(h.bucket_counts() == std::vector<std::uint64_t>{2, 1, 1});
+  REQUIRE(h.count() == 4);
+  REQUIRE(h.sum() == 108.5);
+
+  REQUIRE_THROWS_AS(Histogram({}), std::invalid_argument);
+  REQUIRE_THROWS_AS(Histogram({2.0, 1.0}), std::invalid_argument);
+}
+
+TEST_CASE("MetricsRegistry returns one metric per name and label set", "[metrics]") {
+  MetricsRegistry reg;
+  auto a = reg.counter("test_requests_total", {{"route", "a"}}, "Requests");
+  auto a2 = reg.counter("test_requests_total", {{"route", "a"}});
+  auto b = reg.counter("test_requests_total", {{"route", "b"}});
+  REQUIRE(a == a2);
+  REQUIRE(a != b);
+
+  a->add(3);
+  b->add();
+  reg.gauge("test_depth")->set(7);
+  reg.histogram("test_latency_seconds", {0.1, 1.0})->observe(0.5);
+
+  const auto snap = reg.snapshot();
+  REQUIRE(snap.size() == 4);
+  REQUIRE(find_sample(snap, "test_requests_total", {{"route", "a"}})->value == 3);
+  REQUIRE(find_sample(snap, "test_requests_total", {{"route", "b"}})->value == 1);
+  REQUIRE(find_sample(snap, "test_depth", {})->value == 7);
+  const auto* hist = find_sample(snap, "test_latency_seconds", {});
+  REQUIRE(hist->type == MetricType::Histogram);
+  REQUIRE(hist->bucket_counts == std::vector<std::uint64_t>{0, 1});
+  REQUIRE(hist->count == 1);
+
+  REQUIRE_THROWS_AS(reg.gauge("test_requests_total"), std::invalid_argument);
+  REQUIRE_THROWS_AS(reg.counter("bad name"), std::invalid_argument);
+  REQUIRE_THROWS_AS(reg.counter("ok_name", {{"bad-label", "x"}}), std::invalid_argument);
+}
+
+TEST_CASE("MetricsRegistry collectors run on snapshot until removed", "[metrics]") {
+  MetricsRegistry reg;
+  int calls = 0;
+  const auto id = reg.add_collector([&](MetricsSnapshot& out) {
+    ++calls;
+    MetricSample s;
+    s.name = "test_collected";
+    s.type = MetricType::Gauge;
+    s.value = 42;
+    out.push_back(s);
+  });
+
+  REQUIRE(find_sample(reg.snapshot(), "test_collected", {})->value == 42);
+  reg.remove_collector(id);
+  REQUIRE(reg.snapshot().empty());
+  REQUIRE(calls == 1);
+}
+
+TEST_CASE("to_prometheus renders the text exposition format", "[metrics]") {
+  MetricsRegistry reg;
+  reg.counter("test_records_total", {{"logger", "a\"b"}}, "Records seen")->add(2);
+  reg.counter("test_records_total", {{"logger", "c"}})->add(1);
+  reg.histogram("test_batch", {1, 4})->observe(3);
+
+  const std::string text = to_prometheus(reg.snapshot());
+  REQUIRE(text ==
+          "# HELP test_records_total Records seen\n"
+          "# TYPE test_records_total counter\n"
+          "test_records_total{logger=\"a\\\"b\"} 2\n"
+          "test_records_total{logger=\"c\"} 1\n"
+          "# TYPE test_batch histogram\n"
+          "test_batch_bucket{le=\"1\"} 0\n"
+          "test_batch_bucket{le=\"4\"} 1\n"
+          "test_batch_bucket{le=\"+Inf\"} 1\n"
+          "test_batch_sum 3\n"
+          "test_batch_count 1\n");
+}
+
+TEST_CASE("AsyncSink, FileSink and loggers publish metrics while alive", "[metrics][async]") {
+  auto& loggers = LoggerRegistry::instance();
+  loggers.clear();
+  auto logger = loggers.get_logger("metrics_test");
+
+  const auto path = std::filesystem::temp_directory_path() / "sim_logger_metrics_test.log";
+  std::filesystem::remove(path);
+  auto file = std::make_shared<FileSink>(path.string(), PatternFormatter("{msg}"));
+
+  AsyncOptions opts;
+  opts.metrics_name = "metrics_test_async";
+  auto async = std::make_shared<AsyncSink>(file, opts);
+  logger->set_sinks({async});
+
+  for (int i = 0; i < 10; ++i) {
+    LOG_INFOF(logger, "record %d", i);
+  }
+  async->flush();
+
+  const MetricLabels sink_labels{{"sink", "metrics_test_async"}};
+  auto snap = MetricsRegistry::instance().snapshot();
+  REQUIRE(find_sample(snap, "sim_logger_async_enqueued_records_total", sink_labels)->value == 10);
+  REQUIRE(find_sample(snap, "sim_logger_async_dropped_records_total", sink_labels)->value == 0);
+  REQUIRE(find_sample(snap, "sim_logger_async_queue_depth", sink_labels)->value == 0);
+  const auto* batches = find_sample(snap, "sim_logger_async_batch_size", sink_labels);
+  REQUIRE(batches->value == 10);  // sum of batch sizes
+  REQUIRE(find_sample(snap, "sim_logger_file_bytes", {{"path", path.string()}})->value > 0);
+  REQUIRE(find_sample(snap, "sim_logger_logger_sink_failures_total", {{"logger", "metrics_test"}}) !=
+          nullptr);
+
+  logger->set_sinks({});
+  async.reset();
+  file.reset();
+  snap = MetricsRegistry::instance().snapshot();
+  REQUIRE(find_sample(snap, "sim_logger_async_enqueued_records_total", sink_labels) == nullptr);
+  REQUIRE(find_sample(snap, "sim_logger_file_bytes", {{"path", path.string()}}) == nullptr);
+
+  loggers.clear();
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("MetricsFileExporter writes Prometheus text atomically", "[metrics]") {
+  MetricsRegistry reg;
+  reg.gauge("test_exported")->set(9);
+
+  const auto path = std::filesystem::temp_directory_path() / "sim_logger_metrics_export.prom";
+  std::filesystem::remove(path);
+
+  REQUIRE_THROWS_AS(MetricsFileExporter("", std::chrono::milliseconds(10), reg), std::invalid_argument);
+  REQUIRE_THROWS_AS(MetricsFileExporter(path.string(), std::chrono::milliseconds(0), reg),
+                    std::invalid_argument);
+
+  MetricsFileExporter exporter(path.string(), std::chrono::milliseconds(10), reg);
+  exporter.export_now();
+  REQUIRE(read_file(path) == "# TYPE test_exported gauge\ntest_exported 9\n");
+
+  reg.gauge("test_exported")->set(10);
+  exporter.start();
+  REQUIRE_THROWS_AS(exporter.start(), std::runtime_error);
+  exporter.stop();  // performs a final export
+  REQUIRE(read_file(path) == "# TYPE test_exported gauge\ntest_exported 10\n");
+  REQUIRE(exporter.exports_count() >= 3);
+  REQUIRE(exporter.failures_count() == 0);
+  REQUIRE_FALSE(std::filesystem::exists(path.string() + ".tmp"));
+
+  std::filesystem::remove(path);
+}
+
+}  // namespace sim_logger
@@ -73,6 +73,14 @@ TEST_CASE("PatternFormatter leaves unmatched '{' as literal remainder", "[format
   REQUIRE(out == "abc hello {broken");
 }
 
+TEST_CASE("PatternFormatter renders {tags} as key=value pairs", "[formatter][pattern]") {
+  const auto rec = make_record();
+
+  PatternFormatter fmt("{msg} [{tags}]");
+
+  REQUIRE(fmt.format(rec) == "hello [k1=v1 k2=v2]");
+}
+
 TEST_CASE("PatternFormatter token extraction identifies tokens", "[formatter][pattern]") {
   PatternFormatter fmt("{level} {sim} {met} {logger} {msg} {unknown}");
 
@@ -3,11 +3,13 @@
 #include "logger/rotating_file_sink.hpp"
 
 #include "logger/log_record.hpp"
+#include "logger/metrics.hpp"
 #include "logger/pattern_formatter.hpp"
 
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
+#include <memory>
 #include <regex>
 #include <string>
 #include <thread>
@@ -232,3 +234,52 @@ TEST_CASE("RotatingFileSink prunes only after a successful rotation") {
 
   REQUIRE(list_rotated_files(base).size() == 1);
 }
+
+TEST_CASE("RotatingFileSink publishes rotations and failed rotations as metrics") {
+  const fs::path tmp = fs::temp_directory_path() / fs::path("sim_logger_rotation_metrics_test");
+  fs::remove_all(tmp);
+  fs::create_directories(tmp);
+  const fs::path base = tmp / fs::path("metrics.log");
+
+  auto make_record = [](std::string msg) {
+    return sim_logger::LogRecord(sim_logger::Level::Info,
+                                 /*sim_time=*/0.0,
+                                 /*met=*/0.0,
+                                 /*wall_time_ns=*/0,
+                                 std::this_thread::get_id(),
+                                 "file.cpp",
+                                 123,
+                                 "func",
+                                 "logger",
+                                 {},
+                                 std::move(msg));
+  };
+  const auto value = [&](const std::string& name) {
+    for (const auto& s : sim_logger::MetricsRegistry::instance().snapshot()) {
+      if (s.name == name && s.labels == sim_logger::MetricLabels{{"path", base.string()}}) {
+        return s.value;
+      }
+    }
+    return -1.0;
+  };
+
+  auto sink = std::make_unique<sim_logger::RotatingFileSink>(
+      base.string(), sim_logger::PatternFormatter("{msg}"), /*max_bytes=*/32);
+  for (int i = 0; i < 4; ++i) {
+    sink->write(make_record("rotate-" + std::to_string(i) + " xxxxxxxxxxxxxxxx"));
+  }
+  REQUIRE(sink->rotations_performed() > 0);
+  REQUIRE(value("sim_logger_file_rotations_total") ==
+          static_cast<double>(sink->rotations_performed()));
+  REQUIRE(value("sim_logger_file_rotation_failures_total") == 0.0);
+
+  // With the base file gone, the rename in the next rotation fails.
+  fs::remove(base);
+  REQUIRE_THROWS(sink->write(make_record("fails-to-rotate xxxxxxxxxxxxxxxxxxxxxxxx")));
+  REQUIRE(sink->rotation_failures() == 1);
+  REQUIRE(value("sim_logger_file_rotation_failures_total") == 1.0);
+
+  sink.reset();
+  REQUIRE(value("sim_logger_file_rotations_total") == -1.0);
+  fs::remove_all(tmp);
+}
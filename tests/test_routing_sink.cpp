@@ -0,0 +1,125 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "logger/detail/name_glob.hpp"
+#include "logger/routing_sink.hpp"
+#include "logger/test_sink.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sim_logger {
+namespace {
+
+LogRecord make_record(Level level, std::string logger_name, std::vector<Tag> tags = {}) {
+  return LogRecord(level,
+                   /*sim_time=*/1.0,
+                   /*mission_elapsed=*/2.0,
+                   /*wall_time_ns=*/3,
+                   /*thread_id=*/std::this_thread::get_id(),
+                   /*file=*/"f.cpp",
+                   /*line=*/7U,
+                   /*function=*/"func",
+                   std::move(logger_name),
+                   std::move(tags),
+                   /*message=*/"m");
+}
+
+}  // namespace
+
+TEST_CASE("glob_match handles '*' and '?' across dotted names", "[routing][glob]") {
+  using detail::glob_match;
+
+  REQUIRE(glob_match("*", "anything.at.all"));
+  REQUIRE(glob_match("vehicle*.gnc.*", "vehicle1.gnc.nav"));
+  REQUIRE(glob_match("*.sensors", "a.b.sensors"));
+  REQUIRE(glob_match("vehicle?", "vehicle7"));
+  REQUIRE(glob_match("root", "root"));
+
+  REQUIRE_FALSE(glob_match("vehicle*.gnc.*", "vehicle1.gnc"));
+  REQUIRE_FALSE(glob_match("vehicle?", "vehicle12"));
+  REQUIRE_FALSE(glob_match("root", "root.child"));
+}
+
+TEST_CASE("RoutingSink routes by logger glob and level range", "[routing]") {
+  auto gnc = std::make_shared<TestSink>();
+  auto alerts = std::make_shared<TestSink>();
+
+  RoutingRule gnc_rule;
+  gnc_rule.logger_glob = "vehicle*.gnc.*";
+  gnc_rule.sink = gnc;
+
+  RoutingRule alert_rule;
+  alert_rule.min_level = Level::Error;
+  alert_rule.sink = alerts;
+
+  RoutingSink router({gnc_rule, alert_rule});
+
+  router.write(make_record(Level::Info, "vehicle1.gnc.nav"));
+  router.write(make_record(Level::Error, "vehicle2.gnc.guidance"));
+  router.write(make_record(Level::Error, "vehicle1.power"));
+  router.write(make_record(Level::Info, "vehicle1.power"));
+
+  REQUIRE(gnc->size() == 2);
+  REQUIRE(alerts->size() == 2);
+  REQUIRE(router.cached_names_count() == 3);
+}
+
+TEST_CASE("RoutingSink stop rules and fallback", "[routing]") {
+  auto first = std::make_shared<TestSink>();
+  auto second = std::make_shared<TestSink>();
+  auto fallback = std::make_shared<TestSink>();
+
+  RoutingRule a;
+  a.logger_glob = "sim.*";
+  a.sink = first;
+  a.stop = true;
+
+  RoutingRule b;
+  b.logger_glob = "*";
+  b.min_level = Level::Warn;
+  b.sink = second;
+
+  RoutingSink router({a, b}, fallback);
+
+  router.write(make_record(Level::Error, "sim.gnc"));
+  router.write(make_record(Level::Error, "other"));
+  router.write(make_record(Level::Info, "other"));
+
+  REQUIRE(first->size() == 1);
+  REQUIRE(second->size() == 1);
+  REQUIRE(fallback->size() == 1);
+  REQUIRE(fallback->snapshot()[0].level() == Level::Info);
+}
+
+TEST_CASE("RoutingSink tag predicates require key and optional value", "[routing]") {
+  auto telemetry = std::make_shared<TestSink>();
+
+  RoutingRule rule;
+  rule.tags.push_back(TagMatch{"channel", std::string("telemetry")});
+  rule.tags.push_back(TagMatch{"vehicle", std::nullopt});
+  rule.sink = telemetry;
+
+  RoutingSink router({rule});
+
+  router.write(make_record(Level::Info, "x", {Tag{"channel", "telemetry"}, Tag{"vehicle", "1"}}));
+  router.write(make_record(Level::Info, "x", {Tag{"channel", "telemetry"}}));
+  router.write(make_record(Level::Info, "x", {Tag{"channel", "events"}, Tag{"vehicle", "1"}}));
+
+  REQUIRE(telemetry->size() == 1);
+}
+
+TEST_CASE("RoutingSink rejects invalid rules", "[routing]") {
+  RoutingRule missing_sink;
+  REQUIRE_THROWS_AS(RoutingSink({missing_sink}), std::invalid_argument);
+
+  RoutingRule inverted;
+  inverted.sink = std::make_shared<TestSink>();
+  inverted.min_level = Level::Error;
+  inverted.max_level = Level::Info;
+  REQUIRE_THROWS_AS(RoutingSink({inverted}), std::invalid_argument);
+}
+
+}  // namespace sim_logger
@@ -0,0 +1,127 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "logger/logger.hpp"
+#include "logger/logger_registry.hpp"
+#include "logger/shared_level_table.hpp"
+
+#if !defined(_WIN32)
+
+#include <unistd.h>
+
+#include <memory>
+#include <string>
+
+namespace sim_logger {
+namespace {
+
+std::string unique_shm_name(const char* tag) {
+  return "/sim_logger_test_" + std::string(tag) + "_" + std::to_string(::getpid());
+}
+
+}  // namespace
+
+TEST_CASE("SharedLevelTable allocates stable slots by name", "[shared_levels]") {
+  auto table = SharedLevelTable::create(unique_shm_name("slots"), 4);
+  REQUIRE(table->capacity() == 4U);
+  REQUIRE(table->size() == 0U);
+
+  auto* a = table->acquire_slot("a");
+  auto* b = table->acquire_slot("a.b");
+  REQUIRE(a != nullptr);
+  REQUIRE(b != nullptr);
+  REQUIRE(table->acquire_slot("a") == a);
+  REQUIRE(table->size() == 2U);
+  REQUIRE(table->find("a.b") == std::optional<std::size_t>(1));
+  REQUIRE(table->name(0) == "a");
+  REQUIRE_FALSE(table->find("missing").has_value());
+
+  REQUIRE(table->acquire_slot(std::string(200, 'x')) == nullptr);
+  REQUIRE(table->acquire_slot("c") != nullptr);
+  REQUIRE(table->acquire_slot("d") != nullptr);
+  REQUIRE(table->acquire_slot("e") == nullptr);  // full
+
+  REQUIRE_FALSE(table->override_level(0).has_value());
+  REQUIRE(table->set_override(0, Level::Error));
+  REQUIRE(table->override_level(0) == std::optional<Level>(Level::Error));
+  REQUIRE_FALSE(table->set_override(10, Level::Error));
+}
+
+TEST_CASE("SharedLevelTable segments are visible to other mappings", "[shared_levels]") {
+  const auto name = unique_shm_name("open");
+  auto owner = SharedLevelTable::create(name, 8);
+  owner->acquire_slot("sim.gnc");
+
+  auto tool = SharedLevelTable::open(name);
+  REQUIRE(tool->capacity() == 8U);
+  REQUIRE(tool->size() == 1U);
+  REQUIRE(tool->name(0) == "sim.gnc");
+  REQUIRE(tool->set_override(0, Level::Debug));
+  REQUIRE(owner->override_level(0) == std::optional<Level>(Level::Debug));
+
+  REQUIRE_THROWS_AS(SharedLevelTable::open(unique_shm_name("missing")), std::runtime_error);
+  REQUIRE_THROWS_AS(SharedLevelTable::create(name, 0), std::invalid_argument);
+}
+
+TEST_CASE("SharedLevelTable create leaves an existing segment alone", "[shared_levels]") {
+  const auto name = unique_shm_name("exists");
+  auto first = SharedLevelTable::create(name, 8);
+  first->acquire_slot("sim.gnc");
+  auto tool = SharedLevelTable::open(name);
+
+  REQUIRE_THROWS_AS(SharedLevelTable::create(name, 8), std::runtime_error);
+  REQUIRE(SharedLevelTable::open(name)->name(0) == "sim.gnc");
+
+  // Explicit replacement starts a fresh segment; old mappings are detached.
+  auto second = SharedLevelTable::create(name, 4, /*replace_existing=*/true);
+  REQUIRE(SharedLevelTable::open(name)->capacity() == 4U);
+  REQUIRE(tool->capacity() == 8U);
+  first.reset();  // does not unlink the segment that replaced it
+  REQUIRE(SharedLevelTable::open(name)->capacity() == 4U);
+  second.reset();
+  REQUIRE_THROWS_AS(SharedLevelTable::open(name), std::runtime_error);
+}
+
+TEST_CASE("Registry publishes effective levels and honours shared overrides", "[shared_levels]") {
+  auto& reg = LoggerRegistry::instance();
+  reg.clear();
+
+  auto existing = reg.get_logger("shm");
+  existing->set_level(Level::Warn);
+
+  auto table = SharedLevelTable::create(unique_shm_name("registry"), 16);
+  reg.attach_shared_level_table(table);
+
+  auto child = reg.get_logger("shm.child");
+  const auto parent_id = table->find("shm");
+  const auto child_id = table->find("shm.child");
+  REQUIRE(parent_id.has_value());
+  REQUIRE(child_id.has_value());
+  REQUIRE(table->effective_level(*parent_id) == std::optional<Level>(Level::Warn));
+  REQUIRE(table->effective_level(*child_id) == std::optional<Level>(Level::Warn));
+
+  existing->set_level(Level::Debug);
+  REQUIRE(table->effective_level(*child_id) == std::optional<Level>(Level::Debug));
+
+  // An external override applies to that logger only and wins over everything.
+  table->set_override(*child_id, Level::Error);
+  REQUIRE(child->effective_level() == Level::Error);
+  REQUIRE(existing->effective_level() == Level::Debug);
+
+  table->set_override(*child_id, std::nullopt);
+  REQUIRE(child->effective_level() == Level::Debug);
+
+  // Ids survive clear(): the same name maps back to the same slot.
+  reg.clear();
+  auto again = reg.get_logger("shm.child");
+  REQUIRE(table->find("shm.child") == child_id);
+  table->set_override(*child_id, Level::Fatal);
+  REQUIRE(again->effective_level() == Level::Fatal);
+
+  reg.attach_shared_level_table(nullptr);
+  REQUIRE(again->effective_level() != Level::Fatal);
+  reg.clear();
+}
+
+}  // namespace sim_logger
+
+#endif
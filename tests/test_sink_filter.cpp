@@ -0,0 +1,99 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "logger/async_sink.hpp"
+#include "logger/logger.hpp"
+#include "logger/test_sink.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace sim_logger {
+namespace {
+
+LogRecord make_record(Level level, std::string message = "m") {
+  return LogRecord(level,
+                   /*sim_time=*/1.0,
+                   /*mission_elapsed=*/2.0,
+                   /*wall_time_ns=*/3,
+                   /*thread_id=*/std::this_thread::get_id(),
+                   /*file=*/"f.cpp",
+                   /*line=*/7U,
+                   /*function=*/"func",
+                   /*logger_name=*/"a.b",
+                   /*tags=*/{},
+                   std::move(message));
+}
+
+}  // namespace
+
+TEST_CASE("Sink level is checked by Logger::log before write", "[sink_filter]") {
+  auto logger = std::make_shared<Logger>("a.b");
+  logger->set_level(Level::Debug);
+
+  auto all = std::make_shared<TestSink>();
+  auto alerts = std::make_shared<TestSink>();
+  alerts->set_level(Level::Warn);
+  logger->set_sinks({all, alerts});
+
+  logger->log(make_record(Level::Info));
+  logger->log(make_record(Level::Error));
+
+  REQUIRE(all->size() == 2);
+  REQUIRE(alerts->size() == 1);
+  REQUIRE(alerts->level() == Level::Warn);
+}
+
+TEST_CASE("Sink filter predicate rejects records and can be cleared", "[sink_filter]") {
+  auto logger = std::make_shared<Logger>("a.b");
+  auto sink = std::make_shared<TestSink>();
+  logger->set_sinks({sink});
+
+  sink->set_filter([](const LogRecord& r) { return r.message() != "noisy"; });
+  logger->log(make_record(Level::Info, "noisy"));
+  logger->log(make_record(Level::Info, "useful"));
+  REQUIRE(sink->size() == 1);
+
+  sink->clear_filter();
+  logger->log(make_record(Level::Info, "noisy"));
+  REQUIRE(sink->size() == 2);
+}
+
+TEST_CASE("Throwing sink filter rejects the record without propagating", "[sink_filter]") {
+  auto logger = std::make_shared<Logger>("a.b");
+  auto sink = std::make_shared<TestSink>();
+  logger->set_sinks({sink});
+
+  sink->set_filter([](const LogRecord&) -> bool { throw std::runtime_error("boom"); });
+  REQUIRE_NOTHROW(logger->log(make_record(Level::Info)));
+  REQUIRE(sink->size() == 0);
+}
+
+TEST_CASE("AsyncSink never enqueues records its wrapped sink rejects", "[sink_filter][async]") {
+  auto logger = std::make_shared<Logger>("a.b");
+  logger->set_level(Level::Debug);
+
+  auto alerts = std::make_shared<TestSink>();
+  alerts->set_level(Level::Warn);
+
+  AsyncOptions opt;
+  opt.capacity = 4;
+  opt.overflow_policy = OverflowPolicy::DropNewest;
+  auto async = std::make_shared<AsyncSink>(alerts, opt);
+  logger->set_sinks({async});
+
+  for (int i = 0; i < 100; ++i) {
+    logger->log(make_record(Level::Info));
+  }
+  logger->log(make_record(Level::Error, "alert"));
+  async->flush();
+
+  // TestSink::write does not filter, so any queued INFO record would show up here.
+  const auto records = alerts->snapshot();
+  REQUIRE(records.size() == 1);
+  REQUIRE(records[0].message() == "alert");
+  REQUIRE(async->dropped_records_count() == 0);
+}
+
+}  // namespace sim_logger
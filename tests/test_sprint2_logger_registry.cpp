@@ -4,9 +4,13 @@
 #include "logger/test_sink.hpp"
 #include "logger/logger.hpp"
 
+#include <atomic>
+#include <memory>
 #include <thread>
 #include <vector>
 #include <stdexcept>
+#include <string>
+#include <string_view>
 
 namespace {
 
@@ -143,3 +147,124 @@ TEST_CASE("Logger::log swallows sink exceptions and continues") {
 }
 
 
+
+TEST_CASE("Registry lookups are consistent under concurrent creation", "[sprint2][registry]") {
+  auto& reg = sim_logger::LoggerRegistry::instance();
+  reg.clear();
+
+  constexpr int kThreads = 8;
+  constexpr int kNames = 300;  // forces several table growths
+
+  std::vector<std::vector<std::shared_ptr<sim_logger::Logger>>> seen(kThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&reg, &seen, t]() {
+      for (int i = 0; i < kNames; ++i) {
+        const int k = (i * 7 + t * 13) % kNames;
+        seen[static_cast<std::size_t>(t)].push_back(
+            reg.get_logger("sys.n" + std::to_string(k % 10) + ".l" + std::to_string(k)));
+      }
+    });
+  }
+  for (auto& th : threads) {
+    th.join();
+  }
+
+  for (int i = 0; i < kNames; ++i) {
+    const std::string name = "sys.n" + std::to_string(i % 10) + ".l" + std::to_string(i);
+    const auto logger = reg.get_logger(name);
+    REQUIRE(logger->name() == name);
+    REQUIRE(logger->parent() == reg.get_logger("sys.n" + std::to_string(i % 10)));
+  }
+  for (const auto& per_thread : seen) {
+    for (const auto& logger : per_thread) {
+      REQUIRE(reg.get_logger(logger->name()) == logger);
+    }
+  }
+}
+
+TEST_CASE("A child created while its parent's level changes inherits the new level",
+          "[sprint2][registry]") {
+  auto& reg = sim_logger::LoggerRegistry::instance();
+  reg.clear();
+
+  constexpr int kRounds = 2000;
+  std::vector<std::shared_ptr<sim_logger::Logger>> parents;
+  for (int i = 0; i < kRounds; ++i) {
+    parents.push_back(reg.get_logger("lvlrace.p" + std::to_string(i)));
+    parents.back()->set_level(sim_logger::Level::Info);
+  }
+
+  // Each round, one thread raises the parent's level while the other creates
+  // its child; whichever order they land in, the child must end up at Error.
+  std::atomic<int> round{-1};
+  std::atomic<int> setter_done{-1};
+  std::thread setter([&] {
+    for (int i = 0; i < kRounds; ++i) {
+      while (round.load() < i) {
+        std::this_thread::yield();
+      }
+      parents[static_cast<std::size_t>(i)]->set_level(sim_logger::Level::Error);
+      setter_done.store(i);
+    }
+  });
+
+  int stale = 0;
+  for (int i = 0; i < kRounds; ++i) {
+    round.store(i);
+    auto child = reg.get_logger("lvlrace.p" + std::to_string(i) + ".c");
+    while (setter_done.load() < i) {
+      std::this_thread::yield();
+    }
+    if (child->effective_level() != sim_logger::Level::Error) {
+      ++stale;
+    }
+  }
+  setter.join();
+  REQUIRE(stale == 0);
+}
+
+TEST_CASE("Registry clear bumps the generation and forgets loggers", "[sprint2][registry]") {
+  auto& reg = sim_logger::LoggerRegistry::instance();
+  const auto before = reg.generation();
+  auto a = reg.get_logger(std::string_view("gen.a"));
+
+  reg.clear();
+
+  REQUIRE(reg.generation() == before + 1);
+  REQUIRE(reg.get_logger("gen.a") != a);
+}
+
+TEST_CASE("Registry clear is safe while other threads look up loggers", "[sprint2][registry]") {
+  auto& reg = sim_logger::LoggerRegistry::instance();
+  reg.clear();
+
+  std::atomic<bool> stop{false};
+  std::atomic<int> mismatches{0};
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.emplace_back([&reg, &stop, &mismatches, t]() {
+      int i = 0;
+      while (!stop.load()) {
+        const std::string name = "race.t" + std::to_string(t) + ".l" + std::to_string(i++ % 50);
+        if (reg.get_logger(name)->name() != name) {
+          mismatches.fetch_add(1);
+        }
+      }
+    });
+  }
+  for (int i = 0; i < 200; ++i) {
+    reg.clear();
+    std::this_thread::yield();
+  }
+  stop = true;
+  for (auto& th : readers) {
+    th.join();
+  }
+  REQUIRE(mismatches.load() == 0);
+
+  // A logger released by clear() is destroyed once no caller holds it.
+  std::weak_ptr<sim_logger::Logger> weak = reg.get_logger("race.gone");
+  reg.clear();
+  REQUIRE(weak.expired());
+}
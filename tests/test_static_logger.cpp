@@ -0,0 +1,102 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "logger/log_macros.hpp"
+#include "logger/logger_registry.hpp"
+#include "logger/static_logger.hpp"
+#include "logger/test_sink.hpp"
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sim_logger {
+namespace {
+
+SIM_LOGGER_DEFINE(gnc_log, "static.gnc");
+
+Logger& hot_path_logger() {
+  return SIM_LOGGER_GET_STATIC("static.hot");
+}
+
+}  // namespace
+
+TEST_CASE("StaticLogger resolves once to the registry logger", "[static_logger]") {
+  auto& reg = LoggerRegistry::instance();
+  reg.clear();
+
+  auto logger = reg.get_logger("static.gnc");
+  REQUIRE(&gnc_log.get() == logger.get());
+  REQUIRE(&*gnc_log == logger.get());
+  REQUIRE(&hot_path_logger() == &hot_path_logger());
+  REQUIRE(hot_path_logger().name() == "static.hot");
+}
+
+TEST_CASE("StaticLogger works with the logging macros", "[static_logger]") {
+  auto& reg = LoggerRegistry::instance();
+  reg.clear();
+
+  auto sink = std::make_shared<TestSink>();
+  reg.get_logger("static")->set_sinks({sink});
+
+  LOG_INFO(gnc_log, "from define");
+  LOG_INFOF(SIM_LOGGER_GET_STATIC("static.inline"), "x=%d", 3);
+
+  const auto records = sink->snapshot();
+  REQUIRE(records.size() == 2);
+  REQUIRE(records[0].logger_name() == "static.gnc");
+  REQUIRE(records[1].logger_name() == "static.inline");
+  REQUIRE(records[1].message() == "x=3");
+}
+
+TEST_CASE("StaticLogger re-resolves after registry clear and keeps old loggers alive",
+          "[static_logger]") {
+  auto& reg = LoggerRegistry::instance();
+  reg.clear();
+
+  Logger& before = gnc_log.get();
+  reg.clear();
+
+  // The old reference is still usable (retained), just detached from the registry.
+  REQUIRE(before.name() == "static.gnc");
+
+  Logger& after = gnc_log.get();
+  REQUIRE(&after != &before);
+  REQUIRE(&after == reg.get_logger("static.gnc").get());
+}
+
+TEST_CASE("StaticLogger releases loggers two registry resets old", "[static_logger]") {
+  auto& reg = LoggerRegistry::instance();
+  reg.clear();
+
+  gnc_log.get();
+  std::weak_ptr<Logger> first = reg.get_logger("static.gnc");
+
+  reg.clear();
+  gnc_log.get();
+  REQUIRE_FALSE(first.expired());  // still the handle's previous logger
+
+  reg.clear();
+  gnc_log.get();
+  REQUIRE(first.expired());
+}
+
+TEST_CASE("StaticLogger first use is thread-safe", "[static_logger]") {
+  LoggerRegistry::instance().clear();
+
+  static StaticLogger shared{"static.race"};
+  std::vector<Logger*> seen(8, nullptr);
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < seen.size(); ++i) {
+    threads.emplace_back([&seen, i] { seen[i] = &shared.get(); });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  for (Logger* l : seen) {
+    REQUIRE(l == LoggerRegistry::instance().get_logger("static.race").get());
+  }
+}
+
+}  // namespace sim_logger
@@ -0,0 +1,174 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "logger/metrics.hpp"
+#include "logger/tee_async_sink.hpp"
+#include "logger/test_sink.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sim_logger {
+namespace {
+
+LogRecord make_record(Level level, std::string message) {
+  return LogRecord(level,
+                   /*sim_time=*/1.0,
+                   /*mission_elapsed=*/2.0,
+                   /*wall_time_ns=*/3,
+                   /*thread_id=*/std::this_thread::get_id(),
+                   /*file=*/"f.cpp",
+                   /*line=*/7U,
+                   /*function=*/"func",
+                   /*logger_name=*/"a.b",
+                   /*tags=*/{},
+                   std::move(message));
+}
+
+class SlowSink final : public ISink {
+ public:
+  void write(const LogRecord&) override {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    writes.fetch_add(1);
+  }
+  void flush() override {}
+
+  std::atomic<int> writes{0};
+};
+
+const MetricSample* find_metric(const MetricsSnapshot& snap,
+                                const std::string& name,
+                                const std::string& target) {
+  for (const auto& s : snap) {
+    if (s.name == name && s.labels == MetricLabels{{"sink", "test-tee"}, {"target", target}}) {
+      return &s;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+TEST_CASE("TeeAsyncSink delivers to every target in order", "[tee][async]") {
+  auto a = std::make_shared<TestSink>();
+  auto b = std::make_shared<TestSink>();
+
+  TeeAsyncSink tee({TeeTarget{a, OverflowPolicy::Block, 8}, TeeTarget{b, OverflowPolicy::Block, 4}},
+                   /*max_batch=*/2);
+
+  for (int i = 0; i < 50; ++i) {
+    tee.write(make_record(Level::Info, std::to_string(i)));
+  }
+  tee.flush();
+
+  const auto ra = a->snapshot();
+  const auto rb = b->snapshot();
+  REQUIRE(ra.size() == 50);
+  REQUIRE(rb.size() == 50);
+  for (int i = 0; i < 50; ++i) {
+    REQUIRE(ra[static_cast<std::size_t>(i)].message() == std::to_string(i));
+    REQUIRE(rb[static_cast<std::size_t>(i)].message() == std::to_string(i));
+  }
+}
+
+TEST_CASE("TeeAsyncSink slow dropping target does not throttle a fast target", "[tee][async]") {
+  auto fast = std::make_shared<TestSink>();
+  auto slow = std::make_shared<SlowSink>();
+
+  TeeAsyncSink tee({TeeTarget{fast, OverflowPolicy::Block, 256},
+                    TeeTarget{slow, OverflowPolicy::DropNewest, 4}});
+
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < 200; ++i) {
+    tee.write(make_record(Level::Info, std::to_string(i)));
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  // Writing 200 records through the slow sink would take >= 400 ms.
+  REQUIRE(elapsed < std::chrono::milliseconds(200));
+
+  tee.flush();
+  REQUIRE(fast->size() == 200);
+  REQUIRE(static_cast<std::uint64_t>(slow->writes.load()) + tee.dropped_records_count(1) == 200);
+  REQUIRE(tee.dropped_records_count(0) == 0);
+}
+
+TEST_CASE("TeeAsyncSink DropOldest keeps the newest records for that target", "[tee][async]") {
+  auto slow = std::make_shared<SlowSink>();
+  auto keep = std::make_shared<TestSink>();
+
+  TeeAsyncSink tee({TeeTarget{slow, OverflowPolicy::DropOldest, 2},
+                    TeeTarget{keep, OverflowPolicy::Block, 64}});
+
+  for (int i = 0; i < 20; ++i) {
+    tee.write(make_record(Level::Info, std::to_string(i)));
+  }
+  tee.flush();
+
+  REQUIRE(keep->size() == 20);
+  REQUIRE(tee.dropped_records_count(0) > 0);
+  REQUIRE(static_cast<std::uint64_t>(slow->writes.load()) + tee.dropped_records_count(0) == 20);
+}
+
+TEST_CASE("TeeAsyncSink honors per-target filters before queueing", "[tee][async]") {
+  auto all = std::make_shared<TestSink>();
+  auto alerts = std::make_shared<TestSink>();
+  alerts->set_level(Level::Error);
+
+  TeeAsyncSink tee({TeeTarget{all}, TeeTarget{alerts}});
+
+  tee.write(make_record(Level::Info, "i"));
+  tee.write(make_record(Level::Error, "e"));
+  tee.flush();
+
+  REQUIRE(all->size() == 2);
+  REQUIRE(alerts->size() == 1);
+  REQUIRE(tee.should_log(make_record(Level::Debug, "d")));
+}
+
+TEST_CASE("TeeAsyncSink publishes per-target depth and drops as metrics", "[tee][async]") {
+  auto fast = std::make_shared<TestSink>();
+  auto slow = std::make_shared<SlowSink>();
+
+  auto tee = std::make_unique<TeeAsyncSink>(
+      std::vector<TeeTarget>{TeeTarget{fast, OverflowPolicy::Block, 64},
+                             TeeTarget{slow, OverflowPolicy::DropNewest, 2}},
+      /*max_batch=*/1, "test-tee");
+  REQUIRE(tee->metrics_name() == "test-tee");
+
+  for (int i = 0; i < 20; ++i) {
+    tee->write(make_record(Level::Info, std::to_string(i)));
+  }
+  tee->flush();
+
+  const auto snap = MetricsRegistry::instance().snapshot();
+  for (const char* target : {"0", "1"}) {
+    const auto* depth = find_metric(snap, "sim_logger_tee_queue_depth", target);
+    REQUIRE(depth != nullptr);
+    REQUIRE(depth->type == MetricType::Gauge);
+    REQUIRE(depth->value == 0.0);
+    REQUIRE(find_metric(snap, "sim_logger_tee_sink_failures_total", target) != nullptr);
+  }
+  const auto* fast_drops = find_metric(snap, "sim_logger_tee_dropped_records_total", "0");
+  const auto* slow_drops = find_metric(snap, "sim_logger_tee_dropped_records_total", "1");
+  REQUIRE(fast_drops != nullptr);
+  REQUIRE(fast_drops->value == 0.0);
+  REQUIRE(slow_drops != nullptr);
+  REQUIRE(slow_drops->value > 0.0);
+  REQUIRE(slow_drops->value == static_cast<double>(tee->dropped_records_count(1)));
+
+  tee.reset();
+  REQUIRE(find_metric(MetricsRegistry::instance().snapshot(), "sim_logger_tee_queue_depth", "0") ==
+          nullptr);
+}
+
+TEST_CASE("TeeAsyncSink rejects invalid target lists", "[tee][async]") {
+  REQUIRE_THROWS_AS(TeeAsyncSink(std::vector<TeeTarget>{}), std::invalid_argument);
+  REQUIRE_THROWS_AS(TeeAsyncSink({TeeTarget{}}), std::invalid_argument);
+}
+
+}  // namespace sim_logger
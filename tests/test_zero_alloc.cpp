@@ -0,0 +1,116 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "alloc_counter.hpp"
+
+#include "logger/async_sink.hpp"
+#include "logger/log_macros.hpp"
+#include "logger/logger_registry.hpp"
+#include "logger/pattern_formatter.hpp"
+#include "logger/sink.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace sim_logger {
+namespace {
+
+using test::alloc_count;
+
+constexpr int kWarmup = 2000;
+constexpr int kMeasured = 10000;
+
+// Counts records; runs on the AsyncSink worker, so its own behaviour does not
+// affect the producer thread's count.
+class CountingSink final : public ISink {
+ public:
+  void write(const LogRecord&) override { writes.fetch_add(1, std::memory_order_relaxed); }
+  void flush() override {}
+
+  std::atomic<std::uint64_t> writes{0};
+};
+
+std::shared_ptr<Logger> fresh_logger(const char* name) {
+  auto& reg = LoggerRegistry::instance();
+  reg.clear();
+  auto logger = reg.get_logger(name);
+  logger->set_level(Level::Info);
+  return logger;
+}
+
+}  // namespace
+
+TEST_CASE("Filtered LOG_DEBUGF does not allocate", "[alloc]") {
+  auto logger = fresh_logger("alloc.filtered");
+
+  LOG_DEBUGF(logger, "step=%d dt=%.3f", 0, 0.01);  // first call registers the site
+
+  const std::uint64_t before = alloc_count();
+  for (int i = 0; i < kMeasured; ++i) {
+    LOG_DEBUGF(logger, "step=%d dt=%.3f", i, 0.01);
+  }
+  const std::uint64_t after = alloc_count();
+
+  REQUIRE(after - before == 0);
+  LoggerRegistry::instance().clear();
+}
+
+TEST_CASE("Enabled LOG_INFOF to an AsyncSink does not allocate on the calling thread", "[alloc][async]") {
+  auto logger = fresh_logger("alloc.vehicle_with_a_long_logger_name.gnc");
+  auto counting = std::make_shared<CountingSink>();
+  AsyncOptions opts;
+  opts.capacity = 64;
+  opts.max_batch = 16;
+  auto async = std::make_shared<AsyncSink>(counting, opts);
+  logger->set_sinks({async});
+
+  // Same message length every call; warm-up cycles every queue slot and batch
+  // record through a full-size copy.
+  const auto log_one = [&](int i) {
+    LOG_INFOF(logger, "step=%08d dt=%.3f message long enough to leave the SSO buffer", i, 0.01);
+    LOG_INFO(logger, "a plain string message that is also longer than the SSO buffer");
+  };
+  for (int i = 0; i < kWarmup; ++i) {
+    log_one(i);
+  }
+  async->flush();
+
+  const std::uint64_t before = alloc_count();
+  for (int i = 0; i < kMeasured; ++i) {
+    log_one(i);
+  }
+  const std::uint64_t after = alloc_count();
+
+  async->flush();
+  REQUIRE(after - before == 0);
+  REQUIRE(counting->writes.load() == 2U * (kWarmup + kMeasured));
+  REQUIRE(async->dropped_records_count() == 0);
+
+  logger->set_sinks({});
+  LoggerRegistry::instance().clear();
+}
+
+TEST_CASE("PatternFormatter::format_to into a reused buffer does not allocate", "[alloc][formatter]") {
+  const PatternFormatter formatter("{met} {level} {logger} {file}:{line} {func}: {msg}");
+  const LogRecord record(Level::Warn, 12.5, 3.25, 1234567, std::this_thread::get_id(),
+                         "/some/long/path/to/guidance_navigation_control.cpp", 42, "update_state",
+                         "vehicle1.gnc.guidance", {},
+                         "a message long enough that the output spans several hundred bytes");
+
+  std::string out;
+  formatter.format_to(record, out);  // grow the buffer once
+
+  const std::uint64_t before = alloc_count();
+  for (int i = 0; i < kMeasured; ++i) {
+    out.clear();
+    formatter.format_to(record, out);
+  }
+  const std::uint64_t after = alloc_count();
+
+  REQUIRE(after - before == 0);
+  REQUIRE_FALSE(out.empty());
+}
+
+}  // namespace sim_logger
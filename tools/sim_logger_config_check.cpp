@@ -0,0 +1,29 @@
+// Validate a sim_logger configuration file and print the resolved tree.
+//
+// Usage: sim_logger_config_check <config.ini>
+//
+// Exit status: 0 if the file is valid, 1 if it is not, 2 on bad usage.
+// Nothing is constructed: no log files are opened or created.
+
+#include "logger/config.hpp"
+
+#include <cstdio>
+#include <exception>
+#include <string>
+
+int main(int argc, char** argv) {
+  if (argc != 2) {
+    std::fprintf(stderr, "usage: %s <config.ini>\n", argv[0]);
+    return 2;
+  }
+
+  try {
+    const auto spec = sim_logger::parse_config_file(argv[1]);
+    const std::string tree = sim_logger::describe_config(spec);
+    std::fputs(tree.c_str(), stdout);
+    return 0;
+  } catch (const std::exception& e) {
+    std::fprintf(stderr, "error: %s\n", e.what());
+    return 1;
+  }
+}
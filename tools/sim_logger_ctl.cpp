@@ -0,0 +1,66 @@
+// Send one command to a running ControlServer and print the reply.
+//
+// Usage: sim_logger_ctl <socket> <command...>
+//   sim_logger_ctl /tmp/sim.sock level 'vehicle1.*' debug
+//   sim_logger_ctl /tmp/sim.sock level 'vehicle1.*' reset
+//   sim_logger_ctl /tmp/sim.sock flush
+//   sim_logger_ctl /tmp/sim.sock metrics
+//   sim_logger_ctl /tmp/sim.sock dump
+//
+// Exit status: 0 on an "ok" reply, 1 on an "error:" reply or I/O failure, 2 on bad usage.
+// Deliberately depends only on POSIX sockets, not on the logger library.
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    std::fprintf(stderr, "usage: %s <socket> <command...>\n", argv[0]);
+    return 2;
+  }
+
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  const std::string path = argv[1];
+  if (path.size() >= sizeof(addr.sun_path)) {
+    std::fprintf(stderr, "error: socket path too long\n");
+    return 2;
+  }
+  std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+
+  std::string command;
+  for (int i = 2; i < argc; ++i) {
+    command += (i > 2 ? " " : "");
+    command += argv[i];
+  }
+  command.push_back('\n');
+
+  const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0 || ::connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) {
+    std::fprintf(stderr, "error: cannot connect to '%s': %s\n", path.c_str(), std::strerror(errno));
+    return 1;
+  }
+
+  if (::write(fd, command.data(), command.size()) != static_cast<ssize_t>(command.size())) {
+    std::fprintf(stderr, "error: send failed: %s\n", std::strerror(errno));
+    ::close(fd);
+    return 1;
+  }
+
+  std::string reply;
+  char buf[4096];
+  ssize_t n = 0;
+  while ((n = ::read(fd, buf, sizeof(buf))) > 0) {
+    reply.append(buf, static_cast<std::size_t>(n));
+  }
+  ::close(fd);
+
+  std::fputs(reply.c_str(), stdout);
+  return reply.rfind("ok", 0) == 0 ? 0 : 1;
+}
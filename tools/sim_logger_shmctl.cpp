@@ -0,0 +1,90 @@
+// Inspect or override logger levels published in a SharedLevelTable.
+//
+// Usage: sim_logger_shmctl <shm-name> list
+//        sim_logger_shmctl <shm-name> set <logger|id> <level>
+//        sim_logger_shmctl <shm-name> reset <logger|id>
+//
+// Exit status: 0 on success, 1 on failure, 2 on bad usage.
+// Overrides take effect on the logger's next call; no syscall is made in the
+// logging process.
+
+#include "logger/level.hpp"
+#include "logger/shared_level_table.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <optional>
+#include <string>
+
+namespace {
+
+int usage(const char* argv0) {
+  std::fprintf(stderr,
+               "usage: %s <shm-name> list\n"
+               "       %s <shm-name> set <logger|id> <level>\n"
+               "       %s <shm-name> reset <logger|id>\n",
+               argv0, argv0, argv0);
+  return 2;
+}
+
+std::optional<std::size_t> resolve_id(const sim_logger::SharedLevelTable& table, const std::string& key) {
+  if (auto id = table.find(key)) {
+    return id;
+  }
+  char* end = nullptr;
+  const unsigned long v = std::strtoul(key.c_str(), &end, 10);
+  if (!key.empty() && end != nullptr && *end == '\0' && v < table.size()) {
+    return static_cast<std::size_t>(v);
+  }
+  return std::nullopt;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    return usage(argv[0]);
+  }
+  const std::string cmd = argv[2];
+
+  try {
+    auto table = sim_logger::SharedLevelTable::open(argv[1]);
+
+    if (cmd == "list" && argc == 3) {
+      for (std::size_t id = 0; id < table->size(); ++id) {
+        const auto effective = table->effective_level(id);
+        const auto forced = table->override_level(id);
+        const std::string name(table->name(id));
+        std::printf("%zu %s effective=%s%s%s\n", id, name.c_str(),
+                    effective ? std::string(sim_logger::to_string(*effective)).c_str() : "?",
+                    forced ? " override=" : "",
+                    forced ? std::string(sim_logger::to_string(*forced)).c_str() : "");
+      }
+      return 0;
+    }
+
+    if ((cmd == "set" && argc == 5) || (cmd == "reset" && argc == 4)) {
+      const auto id = resolve_id(*table, argv[3]);
+      if (!id) {
+        std::fprintf(stderr, "error: no logger '%s'\n", argv[3]);
+        return 1;
+      }
+      std::optional<sim_logger::Level> level;
+      if (cmd == "set") {
+        level = sim_logger::level_from_string(argv[4]);
+        if (!level) {
+          std::fprintf(stderr, "error: unknown level '%s'\n", argv[4]);
+          return 1;
+        }
+      }
+      table->set_override(*id, level);
+      return 0;
+    }
+
+    return usage(argv[0]);
+  } catch (const std::exception& e) {
+    std::fprintf(stderr, "error: %s\n", e.what());
+    return 1;
+  }
+}